@@ -0,0 +1,198 @@
+/**
+ * @file BenchDevice.h
+ * @brief Representative IDeviceInstance driver for host benchmarks
+ *
+ * Models a typical 8-channel temperature module: mutex-protected cache,
+ * event-group data-ready bit, allocation-free callback table and an
+ * optional lock-free published slot.
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef IDEV_BENCH_DEVICE_H
+#define IDEV_BENCH_DEVICE_H
+
+#include "IDeviceInstance.h"
+#include <cstring>
+
+class BenchDevice : public IDeviceInstance {
+public:
+    static constexpr EventBits_t DATA_READY_BIT = BIT1;
+    static constexpr size_t CHANNELS = 8;
+
+    /**
+     * @param publish Publish every update into a PublishedSlot so the
+     *        default buffer reads take the lock-free path
+     */
+    explicit BenchDevice(bool publish = false)
+        : publish_(publish), initialized_(false), sequence_(0) {
+        mutexInstance_ = xSemaphoreCreateMutex();
+        mutexInterface_ = xSemaphoreCreateMutex();
+        eventGroup_ = xEventGroupCreate();
+        for (size_t ch = 0; ch < CHANNELS; ch++) {
+            raw_[ch] = static_cast<int16_t>(200 + ch);
+            values_[ch] = raw_[ch] / 10.0f;
+        }
+    }
+
+    ~BenchDevice() override {
+        vSemaphoreDelete(mutexInstance_);
+        vSemaphoreDelete(mutexInterface_);
+        vEventGroupDelete(eventGroup_);
+    }
+
+    DeviceResult<void> initialize() override {
+        initialized_ = true;
+        processData();
+        return DeviceResult<void>();
+    }
+
+    bool isInitialized() const noexcept override { return initialized_; }
+    void waitForInitialization() override {}
+
+    DeviceResult<void> waitForInitializationComplete(TickType_t) override {
+        return initialized_ ? DeviceResult<void>() : DeviceResult<void>(DeviceError::NOT_INITIALIZED);
+    }
+
+    using IDeviceInstance::requestData;
+
+    DeviceResult<void> requestData() override {
+        // The simulated bus answers immediately
+        xEventGroupSetBits(eventGroup_, DATA_READY_BIT);
+        return DeviceResult<void>();
+    }
+
+    bool waitForData() override {
+        return waitForData(portMAX_DELAY) == DeviceError::SUCCESS;
+    }
+
+    DeviceError waitForData(TickType_t xTicksToWait) override {
+        const EventBits_t bits = xEventGroupWaitBits(eventGroup_, DATA_READY_BIT, pdTRUE, pdTRUE, xTicksToWait);
+        return (bits & DATA_READY_BIT) != 0 ? DeviceError::SUCCESS : DeviceError::TIMEOUT;
+    }
+
+    DeviceResult<void> processData() override {
+        if (xSemaphoreTake(mutexInstance_, portMAX_DELAY) != pdTRUE) {
+            return DeviceResult<void>(DeviceError::MUTEX_ERROR);
+        }
+        sequence_++;
+        for (size_t ch = 0; ch < CHANNELS; ch++) {
+            raw_[ch] = static_cast<int16_t>(200 + ch + (sequence_ & 0x7));
+            values_[ch] = raw_[ch] / 10.0f;
+        }
+        if (publish_) {
+            PublishedData data;
+            data.values.resize(CHANNELS);
+            data.raw.resize(CHANNELS);
+            memcpy(data.values.data(), values_, sizeof(values_));
+            memcpy(data.raw.data(), raw_, sizeof(raw_));
+            publishData(slot_, data);
+        }
+        xSemaphoreGive(mutexInstance_);
+        callbacks_.dispatch(EventNotification{EventType::DATA_READY, DeviceError::SUCCESS, 0});
+        return DeviceResult<void>();
+    }
+
+    DeviceResult<std::vector<float>> getData(DeviceDataType dataType) override {
+        if (dataType != DeviceDataType::TEMPERATURE) {
+            return DeviceResult<std::vector<float>>(DeviceError::NOT_SUPPORTED);
+        }
+        xSemaphoreTake(mutexInstance_, portMAX_DELAY);
+        std::vector<float> out(values_, values_ + CHANNELS);
+        xSemaphoreGive(mutexInstance_);
+        return DeviceResult<std::vector<float>>(std::move(out));
+    }
+
+    DeviceResult<std::vector<int16_t>> getDataRaw(DeviceDataType dataType) override {
+        if (dataType != DeviceDataType::TEMPERATURE) {
+            return DeviceResult<std::vector<int16_t>>(DeviceError::NOT_SUPPORTED);
+        }
+        xSemaphoreTake(mutexInstance_, portMAX_DELAY);
+        std::vector<int16_t> out(raw_, raw_ + CHANNELS);
+        xSemaphoreGive(mutexInstance_);
+        return DeviceResult<std::vector<int16_t>>(std::move(out));
+    }
+
+    DeviceResult<size_t> getDataInto(DeviceDataType dataType, float* out, size_t capacity) override {
+        if (publish_) {
+            return IDeviceInstance::getDataInto(dataType, out, capacity);  // Seqlock path
+        }
+        if (dataType != DeviceDataType::TEMPERATURE) {
+            return DeviceResult<size_t>(DeviceError::NOT_SUPPORTED);
+        }
+        if (out == nullptr || capacity < CHANNELS) {
+            return DeviceResult<size_t>(DeviceError::INVALID_PARAMETER);
+        }
+        xSemaphoreTake(mutexInstance_, portMAX_DELAY);
+        memcpy(out, values_, sizeof(values_));
+        xSemaphoreGive(mutexInstance_);
+        return DeviceResult<size_t>(CHANNELS);
+    }
+
+    using IDeviceInstance::getDataScaleDivider;
+
+    int16_t getDataScaleDivider(DeviceDataType) const override { return 10; }
+
+    const PublishedSlot* getPublishedSlot(DeviceDataType dataType) const noexcept override {
+        return publish_ && dataType == DeviceDataType::TEMPERATURE ? &slot_ : nullptr;
+    }
+
+    SemaphoreHandle_t getMutexInstance() const noexcept override { return mutexInstance_; }
+    SemaphoreHandle_t getMutexInterface() const noexcept override { return mutexInterface_; }
+    EventGroupHandle_t getEventGroup() const noexcept override { return eventGroup_; }
+
+    DeviceResult<void> performAction(int, int) override { return DeviceResult<void>(); }
+
+    DeviceResult<void> registerCallback(EventCallback callback) override {
+        stdCallbacks_.push_back(std::move(callback));
+        return DeviceResult<void>();
+    }
+
+    DeviceResult<void> registerDelegate(EventDelegate callback) override {
+        const DeviceError err = callbacks_.add(callback);
+        return err == DeviceError::SUCCESS ? DeviceResult<void>() : DeviceResult<void>(err);
+    }
+
+    DeviceResult<void> unregisterCallbacks() override {
+        callbacks_.clear();
+        stdCallbacks_.clear();
+        return DeviceResult<void>();
+    }
+
+    DeviceResult<void> setEventNotification(EventType eventType, bool enable) override {
+        callbacks_.setEnabled(eventType, enable);
+        return DeviceResult<void>();
+    }
+
+    /**
+     * @brief Deliver an event through the std::function callbacks
+     */
+    void dispatchStd(const EventNotification& notification) {
+        for (auto& cb : stdCallbacks_) {
+            cb(notification);
+        }
+    }
+
+    /**
+     * @brief Deliver an event through the EventDelegate table
+     */
+    void dispatchDelegates(const EventNotification& notification) {
+        callbacks_.dispatch(notification);
+    }
+
+private:
+    bool publish_;
+    bool initialized_;
+    uint32_t sequence_;
+    SemaphoreHandle_t mutexInstance_;
+    SemaphoreHandle_t mutexInterface_;
+    EventGroupHandle_t eventGroup_;
+    float values_[CHANNELS];
+    int16_t raw_[CHANNELS];
+    PublishedSlot slot_;
+    EventCallbackTable callbacks_;
+    std::vector<EventCallback> stdCallbacks_;
+};
+
+#endif // IDEV_BENCH_DEVICE_H
@@ -0,0 +1,170 @@
+/**
+ * @file BenchmarkHarness.h
+ * @brief Minimal Google Benchmark-style harness for host micro-benchmarks
+ *
+ * @code
+ * static void BM_Something(BenchmarkState& state) {
+ *     for (auto _ : state) {
+ *         doNotOptimize(work());
+ *     }
+ * }
+ * IDEV_BENCHMARK(BM_Something);
+ * @endcode
+ *
+ * Each benchmark is run with a growing iteration count until it takes at
+ * least the minimum time (default 0.2 s, `--min-time=<seconds>`); the
+ * reported figure is wall-clock nanoseconds per iteration. A substring
+ * filter can be given as the first non-option argument.
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef IDEV_BENCHMARK_HARNESS_H
+#define IDEV_BENCHMARK_HARNESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/**
+ * @brief Keep @p value alive without letting the optimizer see through it
+ */
+template<typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Force pending memory writes to be treated as observable
+ */
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+/**
+ * @class BenchmarkState
+ * @brief Iteration driver passed to each benchmark
+ */
+class BenchmarkState {
+public:
+    explicit BenchmarkState(uint64_t iterations) noexcept : iterations_(iterations), items_(0) {}
+
+    // Non-trivial so `for (auto _ : state)` does not warn about an unused variable
+    struct Value {
+        Value() noexcept {}
+        ~Value() {}
+    };
+
+    struct Iterator {
+        uint64_t remaining;
+        bool operator!=(const Iterator& other) const noexcept { return remaining != other.remaining; }
+        void operator++() noexcept { --remaining; }
+        Value operator*() const noexcept { return Value(); }
+    };
+
+    Iterator begin() noexcept { return Iterator{iterations_}; }
+    Iterator end() noexcept { return Iterator{0}; }
+
+    uint64_t iterations() const noexcept { return iterations_; }
+
+    /**
+     * @brief Report processed items (e.g. full cycles) for the items/s column
+     */
+    void setItemsProcessed(uint64_t items) noexcept { items_ = items; }
+    uint64_t itemsProcessed() const noexcept { return items_; }
+
+private:
+    uint64_t iterations_;
+    uint64_t items_;
+};
+
+using BenchmarkFn = void (*)(BenchmarkState&);
+
+/**
+ * @class BenchmarkRegistry
+ * @brief Static list of registered benchmarks and the runner
+ */
+class BenchmarkRegistry {
+public:
+    struct Entry {
+        const char* name;
+        BenchmarkFn fn;
+    };
+
+    static std::vector<Entry>& entries() {
+        static std::vector<Entry> list;
+        return list;
+    }
+
+    static int add(const char* name, BenchmarkFn fn) {
+        entries().push_back(Entry{name, fn});
+        return 0;
+    }
+
+    /**
+     * @brief Run all benchmarks matching the command line filter
+     * @return Process exit code
+     */
+    static int runAll(int argc, char** argv) {
+        double minTime = 0.2;
+        const char* filter = nullptr;
+        for (int i = 1; i < argc; i++) {
+            if (strncmp(argv[i], "--min-time=", 11) == 0) {
+                minTime = atof(argv[i] + 11);
+            } else {
+                filter = argv[i];
+            }
+        }
+
+        printf("%-48s %14s %14s %14s\n", "Benchmark", "Time (ns)", "Iterations", "Items/s");
+        printf("%.*s\n", 93, "---------------------------------------------------------------------------------------------");
+        for (const Entry& entry : entries()) {
+            if (filter != nullptr && strstr(entry.name, filter) == nullptr) {
+                continue;
+            }
+            runOne(entry, minTime);
+        }
+        return 0;
+    }
+
+private:
+    static void runOne(const Entry& entry, double minTime) {
+        uint64_t iterations = 1;
+        for (;;) {
+            BenchmarkState state(iterations);
+            const auto start = std::chrono::steady_clock::now();
+            entry.fn(state);
+            const double seconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (seconds >= minTime || iterations >= (1ULL << 40)) {
+                const double nsPerIteration = seconds * 1e9 / static_cast<double>(iterations);
+                const double itemsPerSecond = state.itemsProcessed() > 0
+                                                  ? static_cast<double>(state.itemsProcessed()) / seconds
+                                                  : static_cast<double>(iterations) / seconds;
+                printf("%-48s %14.1f %14llu %14.0f\n", entry.name, nsPerIteration,
+                       static_cast<unsigned long long>(iterations), itemsPerSecond);
+                return;
+            }
+            // Aim for the minimum time with some headroom, at most 10x per step
+            const double factor = seconds > 0 ? (minTime * 1.4) / seconds : 10.0;
+            const double next = static_cast<double>(iterations) * (factor > 10.0 ? 10.0 : factor);
+            iterations = next > static_cast<double>(iterations) + 1 ? static_cast<uint64_t>(next) : iterations + 1;
+        }
+    }
+};
+
+#define IDEV_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define IDEV_BENCHMARK_CONCAT(a, b) IDEV_BENCHMARK_CONCAT_INNER(a, b)
+
+/**
+ * @brief Register a benchmark function `void fn(BenchmarkState&)`
+ */
+#define IDEV_BENCHMARK(fn) \
+    static int IDEV_BENCHMARK_CONCAT(idev_benchmark_registered_, __LINE__) = \
+        BenchmarkRegistry::add(#fn, &fn)
+
+#endif // IDEV_BENCHMARK_HARNESS_H
@@ -0,0 +1,60 @@
+/**
+ * @file bench_callbacks.cpp
+ * @brief Callback dispatch: std::function vector vs EventCallbackTable
+ */
+
+#include "BenchmarkHarness.h"
+#include "BenchDevice.h"
+
+using EventNotification = IDeviceInstance::EventNotification;
+using EventType = IDeviceInstance::EventType;
+using DeviceError = IDeviceInstance::DeviceError;
+
+static void BM_Dispatch_StdFunction(BenchmarkState& state) {
+    BenchDevice device;
+    uint32_t sum = 0;
+    uint32_t* target = &sum;
+    for (int i = 0; i < 2; i++) {
+        device.registerCallback(IDeviceInstance::EventCallback(
+            [target](const EventNotification& n) { *target += n.customData; }));
+    }
+    const EventNotification notification{EventType::DATA_READY, DeviceError::SUCCESS, 1};
+    for (auto _ : state) {
+        device.dispatchStd(notification);
+    }
+    doNotOptimize(sum);
+}
+IDEV_BENCHMARK(BM_Dispatch_StdFunction);
+
+static void BM_Dispatch_EventCallbackTable(BenchmarkState& state) {
+    BenchDevice device;
+    uint32_t sum = 0;
+    uint32_t* target = &sum;
+    for (int i = 0; i < 2; i++) {
+        device.registerDelegate([target](const EventNotification& n) { *target += n.customData; });
+    }
+    const EventNotification notification{EventType::DATA_READY, DeviceError::SUCCESS, 1};
+    for (auto _ : state) {
+        device.dispatchDelegates(notification);
+    }
+    doNotOptimize(sum);
+}
+IDEV_BENCHMARK(BM_Dispatch_EventCallbackTable);
+
+static void BM_Register_StdFunction(BenchmarkState& state) {
+    BenchDevice device;
+    for (auto _ : state) {
+        device.registerCallback(IDeviceInstance::EventCallback([](const EventNotification&) {}));
+        device.unregisterCallbacks();
+    }
+}
+IDEV_BENCHMARK(BM_Register_StdFunction);
+
+static void BM_Register_EventDelegate(BenchmarkState& state) {
+    BenchDevice device;
+    for (auto _ : state) {
+        device.registerDelegate([](const EventNotification&) {});
+        device.unregisterCallbacks();
+    }
+}
+IDEV_BENCHMARK(BM_Register_EventDelegate);
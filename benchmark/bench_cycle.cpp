@@ -0,0 +1,49 @@
+/**
+ * @file bench_cycle.cpp
+ * @brief Full requestData() -> waitForData() -> processData() -> read cycles
+ */
+
+#include "BenchmarkHarness.h"
+#include "BenchDevice.h"
+
+using DeviceDataType = IDeviceInstance::DeviceDataType;
+
+static void runCycles(BenchmarkState& state, bool publish) {
+    BenchDevice device(publish);
+    IDeviceInstance& dev = device;
+    dev.initialize();
+    float buffer[IDeviceInstance::MAX_CHANNELS];
+    for (auto _ : state) {
+        dev.requestData();
+        dev.waitForData(pdMS_TO_TICKS(100));
+        dev.processData();
+        auto result = dev.getDataInto(DeviceDataType::TEMPERATURE, buffer, IDeviceInstance::MAX_CHANNELS);
+        doNotOptimize(result);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+static void BM_FullCycle_Locked(BenchmarkState& state) {
+    runCycles(state, false);
+}
+IDEV_BENCHMARK(BM_FullCycle_Locked);
+
+static void BM_FullCycle_Published(BenchmarkState& state) {
+    runCycles(state, true);
+}
+IDEV_BENCHMARK(BM_FullCycle_Published);
+
+static void BM_FullCycle_VectorRead(BenchmarkState& state) {
+    BenchDevice device;
+    IDeviceInstance& dev = device;
+    dev.initialize();
+    for (auto _ : state) {
+        dev.requestData();
+        dev.waitForData(pdMS_TO_TICKS(100));
+        dev.processData();
+        auto result = dev.getData(DeviceDataType::TEMPERATURE);
+        doNotOptimize(result);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+IDEV_BENCHMARK(BM_FullCycle_VectorRead);
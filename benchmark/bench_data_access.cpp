@@ -0,0 +1,143 @@
+/**
+ * @file bench_data_access.cpp
+ * @brief getData() vs getDataRaw() vs the buffer-based read paths
+ */
+
+#include "BenchmarkHarness.h"
+#include "BenchDevice.h"
+#include "DeviceTelemetryCodec.h"
+
+using DeviceDataType = IDeviceInstance::DeviceDataType;
+
+static void BM_GetData_Vector(BenchmarkState& state) {
+    BenchDevice device;
+    IDeviceInstance& dev = device;
+    for (auto _ : state) {
+        auto result = dev.getData(DeviceDataType::TEMPERATURE);
+        doNotOptimize(result);
+    }
+}
+IDEV_BENCHMARK(BM_GetData_Vector);
+
+static void BM_GetDataRaw_Vector(BenchmarkState& state) {
+    BenchDevice device;
+    IDeviceInstance& dev = device;
+    for (auto _ : state) {
+        auto result = dev.getDataRaw(DeviceDataType::TEMPERATURE);
+        doNotOptimize(result);
+    }
+}
+IDEV_BENCHMARK(BM_GetDataRaw_Vector);
+
+static void BM_GetDataInto_Locked(BenchmarkState& state) {
+    BenchDevice device;
+    IDeviceInstance& dev = device;
+    float buffer[IDeviceInstance::MAX_CHANNELS];
+    for (auto _ : state) {
+        auto result = dev.getDataInto(DeviceDataType::TEMPERATURE, buffer, IDeviceInstance::MAX_CHANNELS);
+        doNotOptimize(result);
+        clobberMemory();
+    }
+}
+IDEV_BENCHMARK(BM_GetDataInto_Locked);
+
+static void BM_GetDataInto_Published(BenchmarkState& state) {
+    BenchDevice device(true);
+    device.initialize();
+    IDeviceInstance& dev = device;
+    float buffer[IDeviceInstance::MAX_CHANNELS];
+    for (auto _ : state) {
+        auto result = dev.getDataInto(DeviceDataType::TEMPERATURE, buffer, IDeviceInstance::MAX_CHANNELS);
+        doNotOptimize(result);
+        clobberMemory();
+    }
+}
+IDEV_BENCHMARK(BM_GetDataInto_Published);
+
+static void BM_GetDataRawInto_Published(BenchmarkState& state) {
+    BenchDevice device(true);
+    device.initialize();
+    IDeviceInstance& dev = device;
+    int16_t buffer[IDeviceInstance::MAX_CHANNELS];
+    for (auto _ : state) {
+        auto result = dev.getDataRawInto(DeviceDataType::TEMPERATURE, buffer, IDeviceInstance::MAX_CHANNELS);
+        doNotOptimize(result);
+        clobberMemory();
+    }
+}
+IDEV_BENCHMARK(BM_GetDataRawInto_Published);
+
+static void BM_GetDataStatic_Published(BenchmarkState& state) {
+    BenchDevice device(true);
+    device.initialize();
+    IDeviceInstance& dev = device;
+    for (auto _ : state) {
+        auto result = dev.getDataStatic(DeviceDataType::TEMPERATURE);
+        doNotOptimize(result);
+    }
+}
+IDEV_BENCHMARK(BM_GetDataStatic_Published);
+
+static void BM_GetDataScaled_Published(BenchmarkState& state) {
+    BenchDevice device(true);
+    device.initialize();
+    IDeviceInstance& dev = device;
+    for (auto _ : state) {
+        auto result = dev.getDataScaled(DeviceDataType::TEMPERATURE);
+        doNotOptimize(result);
+    }
+}
+IDEV_BENCHMARK(BM_GetDataScaled_Published);
+
+static void BM_GetDataFresh_Cached(BenchmarkState& state) {
+    BenchDevice device(true);
+    device.initialize();
+    IDeviceInstance& dev = device;
+    for (auto _ : state) {
+        auto result = dev.getDataFresh(DeviceDataType::TEMPERATURE, 60000);
+        doNotOptimize(result);
+    }
+}
+IDEV_BENCHMARK(BM_GetDataFresh_Cached);
+
+static void BM_TelemetryEncode_4Devices(BenchmarkState& state) {
+    BenchDevice devices[4] = {BenchDevice(true), BenchDevice(true), BenchDevice(true), BenchDevice(true)};
+    DeviceTelemetryEncoder encoder;
+    for (uint8_t i = 0; i < 4; i++) {
+        devices[i].initialize();
+        encoder.add(&devices[i], i);
+    }
+    uint8_t payload[128];
+    for (auto _ : state) {
+        auto result = encoder.encode(payload, sizeof(payload));
+        doNotOptimize(result);
+        clobberMemory();
+    }
+}
+IDEV_BENCHMARK(BM_TelemetryEncode_4Devices);
+
+static void BM_GetDataIfNewer_Unchanged(BenchmarkState& state) {
+    BenchDevice device(true);
+    device.initialize();
+    IDeviceInstance& dev = device;
+    float buffer[IDeviceInstance::MAX_CHANNELS];
+    uint32_t generation = 0;
+    dev.getDataIfNewer(DeviceDataType::TEMPERATURE, generation, buffer, IDeviceInstance::MAX_CHANNELS);
+    for (auto _ : state) {
+        auto result = dev.getDataIfNewer(DeviceDataType::TEMPERATURE, generation, buffer,
+                                         IDeviceInstance::MAX_CHANNELS);
+        doNotOptimize(result);
+    }
+}
+IDEV_BENCHMARK(BM_GetDataIfNewer_Unchanged);
+
+static void BM_GetChannel_Published(BenchmarkState& state) {
+    BenchDevice device(true);
+    device.initialize();
+    IDeviceInstance& dev = device;
+    for (auto _ : state) {
+        auto result = dev.getChannel(DeviceDataType::TEMPERATURE, 3);
+        doNotOptimize(result);
+    }
+}
+IDEV_BENCHMARK(BM_GetChannel_Published);
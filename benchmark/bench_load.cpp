@@ -0,0 +1,143 @@
+/**
+ * @file bench_load.cpp
+ * @brief Load runs: poller, bus scheduler and event dispatcher driving MockDeviceInstance profiles
+ *
+ * Unlike the BenchDevice cycles these include simulated bus latency,
+ * jitter, random errors and a shared bus, so items/s is the sustained
+ * sample (or event) rate of the consumer under that load. Rigs are built
+ * once and reused across the harness's calibration runs.
+ */
+
+#include "BenchmarkHarness.h"
+#include "../test/MockDeviceInstance.h"
+#include "DeviceBusScheduler.h"
+#include "DeviceEventDispatcher.h"
+#include "DevicePoller.h"
+
+using DeviceError = IDeviceInstance::DeviceError;
+using EventNotification = IDeviceInstance::EventNotification;
+using LatencyProfile = MockDeviceInstance::LatencyProfile;
+
+static constexpr size_t LOAD_MOCKS = 4;
+
+// 200-500 us per transaction with 1 % spikes of 2 ms and 2 % CRC errors
+static void applyLoadProfile(MockDeviceInstance& mock, uint32_t seed) {
+    mock.setSeed(seed);
+    mock.setDataLatency(LatencyProfile(200, 300, 10, 2000));
+    mock.setErrorRate(DeviceError::COMMUNICATION_ERROR, 20);
+}
+
+/**
+ * @brief Four mocks, two of them on one shared bus, polled from the benchmark thread
+ */
+struct PollerRig {
+    SemaphoreHandle_t bus;
+    MockDeviceInstance mocks[LOAD_MOCKS];
+    DevicePoller poller;
+
+    PollerRig() : bus(xSemaphoreCreateMutex()) {
+        for (size_t i = 0; i < LOAD_MOCKS; i++) {
+            applyLoadProfile(mocks[i], static_cast<uint32_t>(i + 1));
+            if (i < 2) {
+                mocks[i].shareInterfaceMutex(bus);
+            }
+            mocks[i].initialize();
+            poller.add(&mocks[i], 0, pdMS_TO_TICKS(20), MockDeviceInstance::DATA_READY_BIT,
+                       MockDeviceInstance::ERROR_BIT);
+        }
+    }
+
+    uint64_t samples() const {
+        uint64_t total = 0;
+        for (size_t i = 0; i < LOAD_MOCKS; i++) {
+            total += poller.getCounters(i).samples;
+        }
+        return total;
+    }
+};
+
+static void BM_Load_Poller_4Mocks(BenchmarkState& state) {
+    static PollerRig rig;
+    const uint64_t before = rig.samples();
+    for (auto _ : state) {
+        rig.poller.waitForWork(rig.poller.poll());
+    }
+    state.setItemsProcessed(rig.samples() - before);
+}
+IDEV_BENCHMARK(BM_Load_Poller_4Mocks);
+
+/**
+ * @brief Four mocks on one bus, one REQUEST_DATA job each per iteration
+ */
+struct SchedulerRig {
+    SemaphoreHandle_t bus;
+    MockDeviceInstance mocks[LOAD_MOCKS];
+    DeviceBusScheduler scheduler;
+
+    SchedulerRig() : bus(xSemaphoreCreateMutex()), scheduler(bus, 100) {
+        for (size_t i = 0; i < LOAD_MOCKS; i++) {
+            applyLoadProfile(mocks[i], static_cast<uint32_t>(10 + i));
+            mocks[i].shareInterfaceMutex(bus);
+            mocks[i].initialize();
+            scheduler.attach(&mocks[i]);
+        }
+    }
+};
+
+static void BM_Load_BusScheduler_4Mocks(BenchmarkState& state) {
+    static SchedulerRig rig;
+    const uint32_t before = rig.scheduler.completedCount();
+    for (auto _ : state) {
+        for (size_t i = 0; i < LOAD_MOCKS; i++) {
+            DeviceBusScheduler::Job job;
+            job.device = &rig.mocks[i];
+            job.priority = static_cast<uint8_t>(i % 2);
+            job.responseTimeout = pdMS_TO_TICKS(20);
+            rig.scheduler.submit(job);
+        }
+        rig.scheduler.runPending();
+    }
+    state.setItemsProcessed(rig.scheduler.completedCount() - before);
+}
+IDEV_BENCHMARK(BM_Load_BusScheduler_4Mocks);
+
+/**
+ * @brief Four mocks completing inline, every event posted to the shared dispatcher task
+ */
+struct DispatcherRig {
+    MockDeviceInstance mocks[LOAD_MOCKS];
+    IDeviceInstance::EventCallbackTable table;
+    std::atomic<uint64_t> delivered;
+
+    DispatcherRig() : delivered(0) {
+        std::atomic<uint64_t>* counter = &delivered;
+        table.add([counter](const EventNotification& notification) {
+            (void)notification;
+            counter->fetch_add(1, std::memory_order_relaxed);
+        });
+        DeviceEventDispatcher::instance().start();
+        for (auto& mock : mocks) {
+            mock.setDataLatency(LatencyProfile());
+            mock.initialize();
+            IDeviceInstance::EventCallbackTable* events = &table;
+            mock.registerCallback([events](const EventNotification& notification) {
+                DeviceEventDispatcher::instance().post(*events, notification);
+            });
+        }
+    }
+};
+
+static void BM_Load_Dispatcher_4Mocks(BenchmarkState& state) {
+    static DispatcherRig rig;
+    const uint64_t before = rig.delivered.load();
+    uint64_t i = 0;
+    for (auto _ : state) {
+        MockDeviceInstance& mock = rig.mocks[i++ % LOAD_MOCKS];
+        mock.requestData();
+        doNotOptimize(mock.waitForData(static_cast<TickType_t>(0)));
+    }
+    // Count what the dispatcher task delivered, not what the queue dropped
+    vTaskDelay(pdMS_TO_TICKS(5));
+    state.setItemsProcessed(rig.delivered.load() - before);
+}
+IDEV_BENCHMARK(BM_Load_Dispatcher_4Mocks);
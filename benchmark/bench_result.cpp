@@ -0,0 +1,64 @@
+/**
+ * @file bench_result.cpp
+ * @brief DeviceResult construction and move costs
+ */
+
+#include "BenchmarkHarness.h"
+#include "IDeviceInstance.h"
+
+using DeviceError = IDeviceInstance::DeviceError;
+template<typename T>
+using DeviceResult = IDeviceInstance::DeviceResult<T>;
+
+static void BM_Result_VoidOk(BenchmarkState& state) {
+    for (auto _ : state) {
+        DeviceResult<void> result;
+        doNotOptimize(result);
+    }
+}
+IDEV_BENCHMARK(BM_Result_VoidOk);
+
+static void BM_Result_VoidError(BenchmarkState& state) {
+    for (auto _ : state) {
+        DeviceResult<void> result(DeviceError::TIMEOUT);
+        doNotOptimize(result);
+    }
+}
+IDEV_BENCHMARK(BM_Result_VoidError);
+
+static void BM_Result_FloatOk(BenchmarkState& state) {
+    float value = 21.5f;
+    for (auto _ : state) {
+        DeviceResult<float> result(value);
+        doNotOptimize(result);
+    }
+}
+IDEV_BENCHMARK(BM_Result_FloatOk);
+
+static void BM_Result_VectorConstruct(BenchmarkState& state) {
+    for (auto _ : state) {
+        DeviceResult<std::vector<float>> result(std::vector<float>(IDeviceInstance::MAX_CHANNELS, 1.0f));
+        doNotOptimize(result);
+    }
+}
+IDEV_BENCHMARK(BM_Result_VectorConstruct);
+
+static void BM_Result_VectorMove(BenchmarkState& state) {
+    DeviceResult<std::vector<float>> source(std::vector<float>(IDeviceInstance::MAX_CHANNELS, 1.0f));
+    for (auto _ : state) {
+        DeviceResult<std::vector<float>> moved(std::move(source));
+        doNotOptimize(moved);
+        source = std::move(moved);
+    }
+}
+IDEV_BENCHMARK(BM_Result_VectorMove);
+
+static void BM_Result_ChannelValuesConstruct(BenchmarkState& state) {
+    for (auto _ : state) {
+        IDeviceInstance::ChannelValues values;
+        values.resize(IDeviceInstance::MAX_CHANNELS);
+        DeviceResult<IDeviceInstance::ChannelValues> result(values);
+        doNotOptimize(result);
+    }
+}
+IDEV_BENCHMARK(BM_Result_ChannelValuesConstruct);
@@ -0,0 +1,13 @@
+/**
+ * @file main.cpp
+ * @brief Host micro-benchmark runner
+ *
+ * pio run -e native -t exec
+ * .pio/build/native/program --min-time=0.5 getData
+ */
+
+#include "BenchmarkHarness.h"
+
+int main(int argc, char** argv) {
+    return BenchmarkRegistry::runAll(argc, argv);
+}
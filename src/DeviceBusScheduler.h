@@ -0,0 +1,512 @@
+/**
+ * @file DeviceBusScheduler.h
+ * @brief Priority/deadline scheduler for devices sharing one bus
+ *
+ * Several RS485 devices on one UART share the same interface mutex. Instead
+ * of every task calling requestData()/performAction() ad hoc, jobs are
+ * submitted to one DeviceBusScheduler which runs them back-to-back in
+ * priority and deadline order, separated only by the minimum inter-frame gap.
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_BUS_SCHEDULER_H
+#define DEVICE_BUS_SCHEDULER_H
+
+#include "IDeviceInstance.h"
+#include "freertos/task.h"
+#include "esp_rom_sys.h"
+#include <atomic>
+
+/**
+ * @brief Maximum number of pending jobs per scheduler
+ */
+#ifndef IDEV_BUS_MAX_JOBS
+#define IDEV_BUS_MAX_JOBS 16
+#endif
+
+/**
+ * @brief Maximum number of devices attached to one scheduler
+ */
+#ifndef IDEV_BUS_MAX_DEVICES
+#define IDEV_BUS_MAX_DEVICES 8
+#endif
+
+/**
+ * @brief Default minimum gap between bus transactions in microseconds
+ *
+ * 1750 us is the Modbus RTU 3.5 character time for baud rates above 19200.
+ */
+#ifndef IDEV_BUS_MIN_FRAME_GAP_US
+#define IDEV_BUS_MIN_FRAME_GAP_US 1750
+#endif
+
+/**
+ * @brief Default scheduler task stack size in bytes
+ */
+#ifndef IDEV_BUS_SCHEDULER_STACK_SIZE
+#define IDEV_BUS_SCHEDULER_STACK_SIZE 4096
+#endif
+
+/**
+ * @class DeviceBusScheduler
+ * @brief Serializes bus jobs of all devices attached to one interface mutex
+ *
+ * - attach() verifies that every device reports the same getMutexInterface()
+ * - submit() is non-blocking and may be called from any task
+ * - Jobs run in the scheduler task (or the caller of runPending()): highest
+ *   priority first, then earliest deadline, then submission order
+ * - Jobs whose deadline has passed, or that cannot finish before it given
+ *   the expected duration, complete with TIMEOUT without touching the bus.
+ *   Without an explicit Job::expectedDuration a running average of each
+ *   device's REQUEST_DATA duration is used
+ * - REQUEST_DATA jobs call requestData(const RequestOptions&) with the job's
+ *   priority, deadline and duration estimate, so drivers that queue or
+ *   reorder internally see the same constraints
+ * - Jobs never overlap: one task at a time holds the scheduler's run token
+ *   and executes jobs, leaving at least the minimum frame gap between the
+ *   end of one job and the start of the next
+ *
+ * @note The scheduler does not take getMutexInterface(). Drivers keep their
+ *       usual locking and take the interface mutex themselves inside
+ *       requestData()/processData()/performAction(), so code outside the
+ *       scheduler that takes it interleaves at the drivers' lock boundaries
+ *       and is not subject to the frame gap
+ */
+class DeviceBusScheduler {
+public:
+    using DeviceError = IDeviceInstance::DeviceError;
+
+    static constexpr size_t MAX_JOBS = IDEV_BUS_MAX_JOBS;
+    static constexpr size_t MAX_DEVICES = IDEV_BUS_MAX_DEVICES;
+
+    /**
+     * @enum JobType
+     * @brief Kind of bus work
+     */
+    enum class JobType {
+        REQUEST_DATA,       ///< requestData(RequestOptions) + waitForData() [+ processData()]
+        PERFORM_ACTION      ///< performAction(actionId, actionParam)
+    };
+
+    /**
+     * @brief Completion callback, invoked from the scheduler task
+     * @param context User context passed with the job
+     * @param device The device the job ran on
+     * @param result Outcome of the job
+     */
+    using CompletionFn = void (*)(void* context, IDeviceInstance* device, DeviceError result);
+
+    /**
+     * @brief One unit of bus work
+     */
+    struct Job {
+        IDeviceInstance* device = nullptr;      ///< Target device (must be attached)
+        JobType type = JobType::REQUEST_DATA;   ///< Kind of work
+        int actionId = 0;                       ///< PERFORM_ACTION only
+        int actionParam = 0;                    ///< PERFORM_ACTION only
+        uint8_t priority = 0;                   ///< Higher runs first, RequestPriority scale
+        TickType_t deadline = 0;                ///< Absolute tick count, 0 = none
+        TickType_t expectedDuration = 0;        ///< Run time estimate in ticks, 0 = learned estimate
+        TickType_t responseTimeout = pdMS_TO_TICKS(1000);  ///< waitForData() timeout
+        bool processData = true;                ///< Call processData() after data arrived
+        CompletionFn onComplete = nullptr;      ///< Optional completion callback
+        void* context = nullptr;                ///< Passed to onComplete
+    };
+
+    /**
+     * @brief Constructor
+     * @param busMutex Shared interface mutex, or nullptr to adopt the first attached device's
+     * @param minFrameGapUs Minimum idle time between two transactions
+     */
+    explicit DeviceBusScheduler(SemaphoreHandle_t busMutex = nullptr,
+                                uint32_t minFrameGapUs = IDEV_BUS_MIN_FRAME_GAP_US) noexcept
+        : busMutex_(busMutex), minFrameGapUs_(minFrameGapUs), estimateUs_(), deviceCount_(0), jobCount_(0),
+          nextSequence_(0), lastJobEndUs_(0), task_(nullptr), starting_(false), running_(false), completed_(0),
+          expired_(0) {}
+
+    DeviceBusScheduler(const DeviceBusScheduler&) = delete;
+    DeviceBusScheduler& operator=(const DeviceBusScheduler&) = delete;
+
+    /**
+     * @brief Attach a device to this bus
+     *
+     * @param device Device sharing the bus
+     * @return SUCCESS; INVALID_PARAMETER if null or on a different interface
+     *         mutex; MEMORY_ERROR if MAX_DEVICES are attached
+     * @note Call during setup, before jobs are submitted
+     */
+    DeviceError attach(IDeviceInstance* device) noexcept {
+        if (device == nullptr) {
+            return DeviceError::INVALID_PARAMETER;
+        }
+        SemaphoreHandle_t mutex = device->getMutexInterface();
+        if (busMutex_ == nullptr) {
+            busMutex_ = mutex;
+        } else if (mutex != busMutex_) {
+            IDEV_LOG_E("Bus scheduler: device uses a different interface mutex");
+            return DeviceError::INVALID_PARAMETER;
+        }
+        if (isAttached(device)) {
+            return DeviceError::SUCCESS;
+        }
+        if (deviceCount_ >= MAX_DEVICES) {
+            return DeviceError::MEMORY_ERROR;
+        }
+        devices_[deviceCount_++] = device;
+        return DeviceError::SUCCESS;
+    }
+
+    bool isAttached(const IDeviceInstance* device) const noexcept {
+        for (size_t i = 0; i < deviceCount_; i++) {
+            if (devices_[i] == device) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    SemaphoreHandle_t getBusMutex() const noexcept {
+        return busMutex_;
+    }
+
+    /**
+     * @brief Queue a job
+     *
+     * @param job The job to run
+     * @return SUCCESS; INVALID_PARAMETER if the device is not attached;
+     *         DEVICE_BUSY if MAX_JOBS are pending
+     */
+    DeviceError submit(const Job& job) noexcept {
+        if (job.device == nullptr || !isAttached(job.device)) {
+            return DeviceError::INVALID_PARAMETER;
+        }
+        DeviceError error = DeviceError::DEVICE_BUSY;
+        portENTER_CRITICAL(&lock_);
+        if (jobCount_ < MAX_JOBS) {
+            jobs_[jobCount_].job = job;
+            jobs_[jobCount_].sequence = nextSequence_++;
+            jobCount_++;
+            error = DeviceError::SUCCESS;
+        }
+        portEXIT_CRITICAL(&lock_);
+
+        if (error == DeviceError::SUCCESS) {
+            TaskHandle_t handle = task_;
+            if (handle != nullptr) {
+                xTaskNotifyGive(handle);
+            }
+        }
+        return error;
+    }
+
+    /**
+     * @brief Convenience wrapper queueing a REQUEST_DATA job
+     */
+    DeviceError submitRequest(IDeviceInstance* device, uint8_t priority = 0, TickType_t deadline = 0,
+                              CompletionFn onComplete = nullptr, void* context = nullptr) noexcept {
+        Job job;
+        job.device = device;
+        job.type = JobType::REQUEST_DATA;
+        job.priority = priority;
+        job.deadline = deadline;
+        job.onComplete = onComplete;
+        job.context = context;
+        return submit(job);
+    }
+
+    /**
+     * @brief Queue a REQUEST_DATA job from IDeviceInstance::RequestOptions
+     *
+     * The priority class becomes Job::priority; deadline and duration
+     * estimate are taken over unchanged.
+     */
+    DeviceError submitRequest(IDeviceInstance* device, const IDeviceInstance::RequestOptions& options,
+                              CompletionFn onComplete = nullptr, void* context = nullptr) noexcept {
+        Job job;
+        job.device = device;
+        job.type = JobType::REQUEST_DATA;
+        job.priority = static_cast<uint8_t>(options.priority);
+        job.deadline = options.deadline;
+        job.expectedDuration = options.expectedDuration;
+        job.onComplete = onComplete;
+        job.context = context;
+        return submit(job);
+    }
+
+    /**
+     * @brief Convenience wrapper queueing a PERFORM_ACTION job
+     */
+    DeviceError submitAction(IDeviceInstance* device, int actionId, int actionParam, uint8_t priority = 0,
+                             CompletionFn onComplete = nullptr, void* context = nullptr) noexcept {
+        Job job;
+        job.device = device;
+        job.type = JobType::PERFORM_ACTION;
+        job.actionId = actionId;
+        job.actionParam = actionParam;
+        job.priority = priority;
+        job.onComplete = onComplete;
+        job.context = context;
+        return submit(job);
+    }
+
+    /**
+     * @brief Start the scheduler task
+     *
+     * @param priority Task priority (should be above every job submitter)
+     * @param coreId Core affinity
+     * @param stackSize Stack size in bytes
+     * @return SUCCESS, DEVICE_BUSY while another task is inside start(),
+     *         or MEMORY_ERROR if the task could not be created
+     * @note Idempotent - returns SUCCESS if already running
+     * @note The scheduler must outlive the task, which runs forever
+     */
+    DeviceError start(UBaseType_t priority, BaseType_t coreId = tskNO_AFFINITY,
+                      uint32_t stackSize = IDEV_BUS_SCHEDULER_STACK_SIZE) {
+        portENTER_CRITICAL(&lock_);
+        const bool running = task_ != nullptr;
+        const bool busy = starting_;
+        if (!running && !busy) {
+            starting_ = true;
+        }
+        portEXIT_CRITICAL(&lock_);
+        if (running) {
+            return DeviceError::SUCCESS;
+        }
+        if (busy) {
+            return DeviceError::DEVICE_BUSY;
+        }
+
+        TaskHandle_t handle = nullptr;
+        const bool created = xTaskCreatePinnedToCore(&DeviceBusScheduler::taskEntry, "IDevBus", stackSize,
+                                                     this, priority, &handle, coreId) == pdPASS;
+        portENTER_CRITICAL(&lock_);
+        if (created) {
+            task_ = handle;
+        }
+        starting_ = false;
+        portEXIT_CRITICAL(&lock_);
+        if (!created) {
+            IDEV_LOG_E("Bus scheduler task creation failed");
+            return DeviceError::MEMORY_ERROR;
+        }
+        // Run anything submitted before start()
+        xTaskNotifyGive(handle);
+        return DeviceError::SUCCESS;
+    }
+
+    /**
+     * @brief Run queued jobs in the calling task until the queue is empty
+     * @return Number of jobs completed by this call (including expired ones);
+     *         0 if another task is inside runPending(), which then also runs
+     *         the jobs queued meanwhile
+     */
+    size_t runPending() {
+        size_t count = 0;
+        Job job;
+        while (claimRunToken()) {
+            while (takeNext(job)) {
+                execute(job);
+                count++;
+            }
+            releaseRunToken();
+            // A job submitted after the last takeNext() went unclaimed: retry
+            if (jobCount_ == 0) {
+                break;
+            }
+        }
+        return count;
+    }
+
+    size_t pendingCount() const noexcept {
+        return jobCount_;
+    }
+
+    /**
+     * @brief Number of jobs that ran on the bus
+     */
+    uint32_t completedCount() const noexcept {
+        return completed_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Learned REQUEST_DATA duration of a device in microseconds (0 = no sample yet)
+     */
+    uint32_t estimatedDurationUs(const IDeviceInstance* device) const noexcept {
+        const size_t index = indexOf(device);
+        return index < deviceCount_ ? estimateUs_[index] : 0;
+    }
+
+    /**
+     * @brief Number of jobs failed with TIMEOUT because they could not meet their deadline
+     */
+    uint32_t expiredCount() const noexcept {
+        return expired_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct PendingJob {
+        Job job;
+        uint32_t sequence;
+    };
+
+    size_t indexOf(const IDeviceInstance* device) const noexcept {
+        for (size_t i = 0; i < deviceCount_; i++) {
+            if (devices_[i] == device) {
+                return i;
+            }
+        }
+        return deviceCount_;
+    }
+
+    TickType_t expectedTicks(const Job& job) const noexcept {
+        if (job.expectedDuration != 0 || job.type != JobType::REQUEST_DATA) {
+            return job.expectedDuration;
+        }
+        const uint32_t tickUs = portTICK_PERIOD_MS * 1000u;
+        return static_cast<TickType_t>((estimatedDurationUs(job.device) + tickUs - 1) / tickUs);
+    }
+
+    // Running average with 1/8 weight per new sample
+    void learnDuration(const IDeviceInstance* device, int64_t durationUs) noexcept {
+        const size_t index = indexOf(device);
+        if (index >= deviceCount_ || durationUs < 0) {
+            return;
+        }
+        const int64_t previous = estimateUs_[index];
+        const int64_t next = previous == 0 ? durationUs : previous + (durationUs - previous) / 8;
+        estimateUs_[index] = static_cast<uint32_t>(next > 0 ? next : 1);
+    }
+
+    // True if a should run before b
+    static bool runsBefore(const PendingJob& a, const PendingJob& b) noexcept {
+        if (a.job.priority != b.job.priority) {
+            return a.job.priority > b.job.priority;
+        }
+        if (a.job.deadline != b.job.deadline) {
+            if (a.job.deadline == 0) return false;
+            if (b.job.deadline == 0) return true;
+            return static_cast<int32_t>(a.job.deadline - b.job.deadline) < 0;
+        }
+        return static_cast<int32_t>(a.sequence - b.sequence) < 0;
+    }
+
+    bool takeNext(Job& out) noexcept {
+        bool found = false;
+        portENTER_CRITICAL(&lock_);
+        if (jobCount_ > 0) {
+            size_t best = 0;
+            for (size_t i = 1; i < jobCount_; i++) {
+                if (runsBefore(jobs_[i], jobs_[best])) {
+                    best = i;
+                }
+            }
+            out = jobs_[best].job;
+            jobs_[best] = jobs_[--jobCount_];
+            found = true;
+        }
+        portEXIT_CRITICAL(&lock_);
+        return found;
+    }
+
+    void waitFrameGap() const {
+        if (lastJobEndUs_ == 0) {
+            return;
+        }
+        const int64_t elapsed = esp_timer_get_time() - lastJobEndUs_;
+        if (elapsed >= static_cast<int64_t>(minFrameGapUs_)) {
+            return;
+        }
+        const uint32_t remainingUs = minFrameGapUs_ - static_cast<uint32_t>(elapsed);
+        const uint32_t tickUs = portTICK_PERIOD_MS * 1000u;
+        if (remainingUs >= tickUs) {
+            vTaskDelay((remainingUs + tickUs - 1) / tickUs);
+        } else {
+            esp_rom_delay_us(remainingUs);
+        }
+    }
+
+    bool claimRunToken() noexcept {
+        portENTER_CRITICAL(&lock_);
+        const bool claimed = !running_;
+        running_ = true;
+        portEXIT_CRITICAL(&lock_);
+        return claimed;
+    }
+
+    void releaseRunToken() noexcept {
+        portENTER_CRITICAL(&lock_);
+        running_ = false;
+        portEXIT_CRITICAL(&lock_);
+    }
+
+    void execute(const Job& job) {
+        DeviceError result;
+        const TickType_t expected = expectedTicks(job);
+        // Job priorities share the RequestPriority scale, so drivers see the job's own class
+        const IDeviceInstance::RequestOptions options(static_cast<IDeviceInstance::RequestPriority>(job.priority),
+                                                      job.deadline, expected);
+        if (options.cannotMeet(xTaskGetTickCount(), expected)) {
+            expired_.fetch_add(1, std::memory_order_relaxed);
+            result = DeviceError::TIMEOUT;
+        } else {
+            waitFrameGap();
+            const int64_t startUs = esp_timer_get_time();
+            result = run(job, options);
+            lastJobEndUs_ = esp_timer_get_time();
+            if (job.type == JobType::REQUEST_DATA && result == DeviceError::SUCCESS) {
+                learnDuration(job.device, lastJobEndUs_ - startUs);
+            }
+            completed_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (job.onComplete != nullptr) {
+            job.onComplete(job.context, job.device, result);
+        }
+    }
+
+    static DeviceError run(const Job& job, const IDeviceInstance::RequestOptions& options) {
+        IDeviceInstance* device = job.device;
+        if (job.type == JobType::PERFORM_ACTION) {
+            auto actionResult = device->performAction(job.actionId, job.actionParam);
+            return actionResult.isOk() ? DeviceError::SUCCESS : actionResult.error();
+        }
+
+        auto requestResult = device->requestData(options);
+        if (!requestResult.isOk()) {
+            return requestResult.error();
+        }
+        DeviceError waitResult = device->waitForData(job.responseTimeout);
+        if (waitResult != DeviceError::SUCCESS || !job.processData) {
+            return waitResult;
+        }
+        auto processResult = device->processData();
+        return processResult.isOk() ? DeviceError::SUCCESS : processResult.error();
+    }
+
+    static void taskEntry(void* param) {
+        auto* self = static_cast<DeviceBusScheduler*>(param);
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            self->runPending();
+        }
+    }
+
+    SemaphoreHandle_t busMutex_;
+    uint32_t minFrameGapUs_;
+    IDeviceInstance* devices_[MAX_DEVICES];
+    uint32_t estimateUs_[MAX_DEVICES];
+    size_t deviceCount_;
+    PendingJob jobs_[MAX_JOBS];
+    volatile size_t jobCount_;
+    uint32_t nextSequence_;
+    int64_t lastJobEndUs_;
+    TaskHandle_t volatile task_;
+    bool starting_;
+    bool running_;          // Run token, guarded by lock_
+    std::atomic<uint32_t> completed_;
+    std::atomic<uint32_t> expired_;
+    portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+};
+
+#endif // DEVICE_BUS_SCHEDULER_H
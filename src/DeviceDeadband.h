@@ -0,0 +1,200 @@
+/**
+ * @file DeviceDeadband.h
+ * @brief Change-threshold filter that decides when DATA_READY is worth sending
+ *
+ * Drivers embed one DeviceDeadband, forward IDeviceInstance::setDeadband()
+ * and clearDeadband() to it and run every new reading through update() in
+ * processData(). DATA_READY is then fired only when a channel moved beyond
+ * its threshold or the max-silence interval elapsed, with the changed
+ * channels in EventNotification::customData.
+ *
+ * @code
+ * DeviceResult<void> MB8ART::setDeadband(DeviceDataType type, ScaledValue threshold, uint32_t maxSilenceMs) {
+ *     return deadband_.configure(type, threshold, maxSilenceMs);
+ * }
+ *
+ * DeviceResult<void> MB8ART::processData() {
+ *     ...  // update cache, then outside the instance mutex:
+ *     const ChannelMask changed = deadband_.update(DeviceDataType::TEMPERATURE, scaled_, CHANNELS);
+ *     if (changed != 0) {
+ *         callbacks_.dispatch({EventType::DATA_READY, DeviceError::SUCCESS, static_cast<int>(changed)});
+ *     }
+ * }
+ * @endcode
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_DEADBAND_H
+#define DEVICE_DEADBAND_H
+
+#include "IDeviceInstance.h"
+#include "esp_timer.h"
+
+/**
+ * @class DeviceDeadband
+ * @brief Per-data-type deadband with max-silence heartbeat
+ *
+ * Unconfigured types are passed through: update() reports every channel as
+ * changed, so embedding the filter changes nothing until setDeadband() is
+ * called. Thresholds are ScaledValue, so channels with different dividers
+ * (PT100 tenths next to PT1000 hundredths) share one physical threshold.
+ *
+ * configure()/clear() may be called from any task; update() is meant for
+ * processData(). Both sides take one short critical section.
+ */
+class DeviceDeadband {
+public:
+    using DeviceDataType = IDeviceInstance::DeviceDataType;
+    using DeviceError = IDeviceInstance::DeviceError;
+    using ChannelMask = IDeviceInstance::ChannelMask;
+    template<typename T>
+    using DeviceResult = IDeviceInstance::DeviceResult<T>;
+
+    static constexpr size_t MAX_CHANNELS = IDeviceInstance::MAX_CHANNELS;
+    static_assert(MAX_CHANNELS <= 32, "ChannelMask holds at most 32 channels");
+
+    DeviceDeadband() noexcept : types_() {}
+
+    DeviceDeadband(const DeviceDeadband&) = delete;
+    DeviceDeadband& operator=(const DeviceDeadband&) = delete;
+
+    /**
+     * @brief Enable filtering for a data type
+     *
+     * @param dataType The data type to filter
+     * @param threshold Minimum change that counts (strictly greater); zero
+     *        suppresses only unchanged readings
+     * @param maxSilenceMs Report all channels at least this often (0 = never)
+     * @return INVALID_PARAMETER for an unknown type or a negative threshold
+     * @note The next update() always reports, so the reference is re-primed
+     */
+    DeviceResult<void> configure(DeviceDataType dataType, ScaledValue threshold, uint32_t maxSilenceMs = 0) noexcept {
+        const size_t index = static_cast<size_t>(dataType);
+        if (index >= IDeviceInstance::NUM_DATA_TYPES || threshold.raw() < 0) {
+            return DeviceResult<void>(DeviceError::INVALID_PARAMETER);
+        }
+        portENTER_CRITICAL(&lock_);
+        TypeState& state = types_[index];
+        state.threshold = threshold;
+        state.maxSilenceUs = static_cast<int64_t>(maxSilenceMs) * 1000;
+        state.enabled = true;
+        state.primed = false;
+        portEXIT_CRITICAL(&lock_);
+        return DeviceResult<void>();
+    }
+
+    /**
+     * @brief Disable filtering for a data type (every update reports again)
+     */
+    DeviceResult<void> clear(DeviceDataType dataType) noexcept {
+        const size_t index = static_cast<size_t>(dataType);
+        if (index >= IDeviceInstance::NUM_DATA_TYPES) {
+            return DeviceResult<void>(DeviceError::INVALID_PARAMETER);
+        }
+        portENTER_CRITICAL(&lock_);
+        types_[index].enabled = false;
+        types_[index].primed = false;
+        portEXIT_CRITICAL(&lock_);
+        return DeviceResult<void>();
+    }
+
+    /**
+     * @brief Check whether a data type is currently filtered
+     */
+    bool isEnabled(DeviceDataType dataType) const noexcept {
+        const size_t index = static_cast<size_t>(dataType);
+        return index < IDeviceInstance::NUM_DATA_TYPES && types_[index].enabled;
+    }
+
+    /**
+     * @brief Run new readings through the filter
+     *
+     * @param dataType The data type of @p values
+     * @param values New readings, one per channel
+     * @param count Number of channels (at most MAX_CHANNELS are tracked)
+     * @param nowUs Current time (default esp_timer_get_time())
+     * @return Channels to report (bit n = channel n); 0 means skip DATA_READY
+     *
+     * A channel is reported when |value - last reported value| > threshold.
+     * The first update after configure(), a channel count change or an
+     * expired max-silence interval reports all channels.
+     */
+    ChannelMask update(DeviceDataType dataType, const ScaledValue* values, size_t count,
+                       int64_t nowUs = esp_timer_get_time()) noexcept {
+        const size_t index = static_cast<size_t>(dataType);
+        if (count > MAX_CHANNELS) {
+            count = MAX_CHANNELS;
+        }
+        const ChannelMask all = count == 0 ? 0 : static_cast<ChannelMask>((uint64_t(1) << count) - 1);
+        if (index >= IDeviceInstance::NUM_DATA_TYPES || values == nullptr) {
+            return all;
+        }
+
+        portENTER_CRITICAL(&lock_);
+        TypeState& state = types_[index];
+        ChannelMask changed = 0;
+        if (!state.enabled) {
+            changed = all;
+        } else if (!state.primed || state.count != count ||
+                   (state.maxSilenceUs > 0 && nowUs - state.lastReportUs >= state.maxSilenceUs)) {
+            changed = all;
+            for (size_t ch = 0; ch < count; ch++) {
+                state.last[ch] = values[ch];
+            }
+            state.count = static_cast<uint8_t>(count);
+            state.primed = true;
+        } else {
+            for (size_t ch = 0; ch < count; ch++) {
+                if ((values[ch] - state.last[ch]).abs() > state.threshold) {
+                    state.last[ch] = values[ch];
+                    changed |= ChannelMask(1) << ch;
+                }
+            }
+        }
+        if (changed != 0) {
+            state.lastReportUs = nowUs;
+        }
+        portEXIT_CRITICAL(&lock_);
+        return changed;
+    }
+
+    /**
+     * @brief Raw-value overload for drivers with one divider per type
+     *
+     * @param dataType The data type of @p raw
+     * @param raw New raw readings
+     * @param count Number of channels
+     * @param divider Scale divider shared by all channels
+     * @param nowUs Current time (default esp_timer_get_time())
+     */
+    ChannelMask update(DeviceDataType dataType, const int16_t* raw, size_t count, int16_t divider,
+                       int64_t nowUs = esp_timer_get_time()) noexcept {
+        if (raw == nullptr) {
+            return update(dataType, static_cast<const ScaledValue*>(nullptr), count, nowUs);
+        }
+        ScaledValue values[MAX_CHANNELS];
+        const size_t n = count < MAX_CHANNELS ? count : MAX_CHANNELS;
+        for (size_t ch = 0; ch < n; ch++) {
+            values[ch] = ScaledValue(raw[ch], divider);
+        }
+        return update(dataType, values, n, nowUs);
+    }
+
+private:
+    struct TypeState {
+        ScaledValue threshold;
+        ScaledValue last[MAX_CHANNELS];     ///< Last reported value per channel
+        int64_t maxSilenceUs = 0;
+        int64_t lastReportUs = 0;
+        uint8_t count = 0;
+        bool enabled = false;
+        bool primed = false;
+    };
+
+    TypeState types_[IDeviceInstance::NUM_DATA_TYPES];
+    portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+};
+
+#endif // DEVICE_DEADBAND_H
@@ -0,0 +1,599 @@
+/**
+ * @file DeviceDeferredLog.h
+ * @brief Deferred binary backend for the IDEV_LOG_* macros
+ *
+ * With -DIDEVICEINSTANCE_DEFERRED_LOG the logging macros no longer format
+ * or write to the UART in the calling task. Each call stores the format
+ * string pointer, a microsecond timestamp, the raw arguments and copies of
+ * %s strings in a lock-free ring; formatting happens later in a low-priority task
+ * (flushToLog()) or on the host from the raw records (drain()).
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_DEFERRED_LOG_H
+#define DEVICE_DEFERRED_LOG_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include <esp_log.h>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief Records kept in the ring (must be a power of two)
+ */
+#ifndef IDEV_DEFERRED_LOG_QUEUE_LENGTH
+#define IDEV_DEFERRED_LOG_QUEUE_LENGTH 64
+#endif
+
+/**
+ * @brief Default flush task stack size in bytes
+ */
+#ifndef IDEV_DEFERRED_LOG_STACK_SIZE
+#define IDEV_DEFERRED_LOG_STACK_SIZE 3072
+#endif
+
+/**
+ * @brief Flush task period in milliseconds
+ */
+#ifndef IDEV_DEFERRED_LOG_FLUSH_MS
+#define IDEV_DEFERRED_LOG_FLUSH_MS 50
+#endif
+
+/**
+ * @brief Bytes per record for copies of %s arguments, terminators included
+ */
+#ifndef IDEV_DEFERRED_LOG_STRING_BYTES
+#define IDEV_DEFERRED_LOG_STRING_BYTES 32
+#endif
+
+/**
+ * @class DeviceDeferredLog
+ * @brief Fixed-size log record queue with deferred formatting
+ *
+ * @code
+ * // platformio.ini: build_flags = -DIDEVICEINSTANCE_DEFERRED_LOG
+ * DeviceDeferredLog::instance().start(1);    // formats and prints at priority 1
+ * IDEV_LOG_W("Timeout on slave %d after %u ms", address, waited);  // ~1 us, no vsnprintf
+ * @endcode
+ *
+ * @note Only the pointers of the format string and the tag are stored -
+ *       both must be string literals or otherwise outlive the record
+ * @note char* arguments are copied into the record (STRING_BYTES shared by
+ *       all of them, terminators included) and cut when the space runs out
+ * @note At most MAX_WORDS 32-bit words of arguments are kept (doubles and
+ *       64-bit integers take two); '*' width/precision is not supported
+ * @note IDEV_DEFERRED_LOG() checks the arguments against the format at
+ *       compile time like printf
+ * @note Records are dropped (and counted) when the ring is full
+ */
+class DeviceDeferredLog {
+public:
+    static constexpr size_t QUEUE_LENGTH = IDEV_DEFERRED_LOG_QUEUE_LENGTH;
+    static_assert(QUEUE_LENGTH >= 2 && (QUEUE_LENGTH & (QUEUE_LENGTH - 1)) == 0,
+                  "IDEV_DEFERRED_LOG_QUEUE_LENGTH must be a power of two");
+
+    static constexpr size_t MAX_WORDS = 8;
+    static constexpr size_t MAX_DUMP_BYTES = MAX_WORDS * sizeof(uint32_t);
+    static constexpr size_t STRING_BYTES = IDEV_DEFERRED_LOG_STRING_BYTES;
+    static_assert(STRING_BYTES >= 1 && STRING_BYTES <= UINT8_MAX,
+                  "IDEV_DEFERRED_LOG_STRING_BYTES must be 1..255");
+
+    /// Word value of a STRING argument that was a null pointer
+    static constexpr uint32_t NULL_STRING = UINT32_MAX;
+
+    /// Storage class of one argument (2 bits per argument in Record::tags)
+    enum class ArgTag : uint8_t {
+        WORD = 0,       ///< Integer up to 32 bits, or 32-bit pointer
+        WIDE = 1,       ///< 64-bit integer, or 64-bit pointer
+        DOUBLE = 2,     ///< float / double (two words)
+        STRING = 3      ///< char*: offset of the copy in Record::strings
+    };
+
+    enum class Kind : uint8_t {
+        LOG = 0,        ///< printf-style message
+        DUMP = 1        ///< Raw bytes from IDEV_DUMP_DATA
+    };
+
+    /**
+     * @brief One deferred record (52 bytes plus the string copies on ESP32, little-endian)
+     *
+     * For host-side decoding, format and tag are addresses into the
+     * firmware's .rodata (resolve against the ELF); string arguments are
+     * NUL-terminated inside strings.
+     */
+    struct Record {
+        const char* format;         ///< Format string (LOG) or message (DUMP)
+        const char* tag;            ///< Log tag
+        uint32_t timestampUs;       ///< Low 32 bits of esp_timer_get_time()
+        uint8_t level;              ///< esp_log_level_t
+        Kind kind;
+        uint8_t count;              ///< Arguments (LOG) or stored bytes (DUMP)
+        uint8_t truncated;          ///< Non-zero if arguments did not fit (LOG)
+        uint16_t tags;              ///< ArgTag per argument, 2 bits each (LOG)
+        uint16_t totalLength;       ///< Original byte count (DUMP)
+        uint32_t words[MAX_WORDS];  ///< Raw argument words / dump bytes
+        uint8_t stringBytes;        ///< Bytes used in strings (LOG)
+        char strings[STRING_BYTES]; ///< Copies of char* arguments (LOG)
+    };
+
+    /**
+     * @brief Consumer of raw records
+     */
+    using RecordFn = void (*)(void* context, const Record& record);
+
+    DeviceDeferredLog() noexcept
+        : task_(nullptr), dequeuePos_(0), enqueuePos_(0), dropped_(0) {
+        for (size_t i = 0; i < QUEUE_LENGTH; i++) {
+            cells_[i].sequence.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        }
+    }
+
+    DeviceDeferredLog(const DeviceDeferredLog&) = delete;
+    DeviceDeferredLog& operator=(const DeviceDeferredLog&) = delete;
+
+    /**
+     * @brief Library-wide deferred log
+     */
+    static DeviceDeferredLog& instance() {
+        static DeviceDeferredLog log;
+        return log;
+    }
+
+    /**
+     * @brief Queue a printf-style message
+     *
+     * @param level esp_log_level_t of the message
+     * @param tag Log tag (static string)
+     * @param format Format string (static string)
+     * @param args Arguments; whatever does not fit MAX_WORDS is dropped
+     * @return false if the ring was full
+     * @note Use IDEV_DEFERRED_LOG() for compile-time argument checks; a
+     *       template cannot carry printf argument checking itself
+     */
+    template<typename... Args>
+    __attribute__((format(printf, 4, 0)))
+    bool log(esp_log_level_t level, const char* tag, const char* format, Args... args) noexcept {
+        Record record;
+        record.format = format;
+        record.tag = tag;
+        record.timestampUs = static_cast<uint32_t>(esp_timer_get_time());
+        record.level = static_cast<uint8_t>(level);
+        record.kind = Kind::LOG;
+        record.count = 0;
+        record.truncated = 0;
+        record.tags = 0;
+        record.totalLength = 0;
+        record.stringBytes = 0;
+        size_t used = 0;
+        int expand[] = {0, (pack(record, used, args), 0)...};
+        (void)expand;
+        (void)used;
+        return enqueue(record);
+    }
+
+    /**
+     * @brief Queue up to MAX_DUMP_BYTES raw bytes as one record
+     *
+     * @param level esp_log_level_t of the dump
+     * @param tag Log tag (static string)
+     * @param message Description (static string)
+     * @param data Bytes to store
+     * @param length Number of bytes at @p data
+     * @return false if the ring was full
+     */
+    bool dump(esp_log_level_t level, const char* tag, const char* message,
+              const void* data, size_t length) noexcept {
+        Record record;
+        record.format = message;
+        record.tag = tag;
+        record.timestampUs = static_cast<uint32_t>(esp_timer_get_time());
+        record.level = static_cast<uint8_t>(level);
+        record.kind = Kind::DUMP;
+        record.count = static_cast<uint8_t>(length < MAX_DUMP_BYTES ? length : MAX_DUMP_BYTES);
+        record.truncated = 0;
+        record.tags = 0;
+        record.totalLength = static_cast<uint16_t>(length < UINT16_MAX ? length : UINT16_MAX);
+        record.stringBytes = 0;
+        memset(record.words, 0, sizeof(record.words));
+        if (data != nullptr) {
+            memcpy(record.words, data, record.count);
+        } else {
+            record.count = 0;
+        }
+        return enqueue(record);
+    }
+
+    /**
+     * @brief Remove all queued records, passing each to @p fn
+     *
+     * Use this to ship raw records to a host-side decoder.
+     *
+     * @return Number of records consumed
+     * @note Must only be called from one task at a time
+     */
+    size_t drain(RecordFn fn, void* context) {
+        size_t count = 0;
+        Record record;
+        while (dequeue(record)) {
+            fn(context, record);
+            count++;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Format all queued records and write them with esp_log_write()
+     *
+     * Output matches the ESP-IDF line layout, using the recorded timestamp.
+     *
+     * @return Number of records written
+     */
+    size_t flushToLog() {
+        return drain(&DeviceDeferredLog::writeToLog, nullptr);
+    }
+
+    /**
+     * @brief Start the low-priority task calling flushToLog() periodically
+     * @return true on success (or if already running)
+     */
+    bool start(UBaseType_t priority, BaseType_t coreId = tskNO_AFFINITY,
+               uint32_t stackSize = IDEV_DEFERRED_LOG_STACK_SIZE) {
+        if (task_.load(std::memory_order_acquire) != nullptr) {
+            return true;
+        }
+        TaskHandle_t handle = nullptr;
+        if (xTaskCreatePinnedToCore(&DeviceDeferredLog::taskEntry, "IDevLog", stackSize,
+                                    this, priority, &handle, coreId) != pdPASS) {
+            return false;
+        }
+        task_.store(handle, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Wake the flush task immediately
+     */
+    void flush() noexcept {
+        TaskHandle_t handle = task_.load(std::memory_order_acquire);
+        if (handle != nullptr) {
+            xTaskNotifyGive(handle);
+        }
+    }
+
+    /**
+     * @brief Records dropped because the ring was full
+     */
+    uint32_t droppedCount() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Never called; lets the compiler check printf arguments
+     * @see IDEV_DEFERRED_LOG
+     */
+    __attribute__((format(printf, 1, 2)))
+    static void checkFormat(const char* format, ...) noexcept {
+        (void)format;
+    }
+
+    /**
+     * @brief Format a record into text (without level/timestamp prefix)
+     *
+     * Usable on the device and, with the strings resolved, on the host.
+     *
+     * @param record The record
+     * @param out Destination buffer
+     * @param capacity Size of @p out
+     * @return Length written, excluding the terminator
+     */
+    static size_t format(const Record& record, char* out, size_t capacity) noexcept {
+        if (capacity == 0) {
+            return 0;
+        }
+        Writer writer{out, capacity, 0};
+        if (record.kind == Kind::DUMP) {
+            formatDump(record, writer);
+        } else {
+            formatLog(record, writer);
+        }
+        return writer.length;
+    }
+
+private:
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        Record record;
+    };
+
+    struct Writer {
+        char* out;
+        size_t capacity;
+        size_t length;
+
+        void append(const char* text, size_t n) noexcept {
+            const size_t room = capacity - 1 - length;
+            const size_t take = n < room ? n : room;
+            memcpy(out + length, text, take);
+            length += take;
+            out[length] = '\0';
+        }
+    };
+
+    static constexpr uint32_t MASK = static_cast<uint32_t>(QUEUE_LENGTH - 1);
+
+    // Argument packing - one overload family per storage class
+
+    static void store(Record& record, size_t& used, ArgTag tag, const uint32_t* words, size_t n) noexcept {
+        if (record.truncated != 0 || used + n > MAX_WORDS) {
+            record.truncated = 1;  // Keep later arguments aligned with their conversions
+            return;
+        }
+        for (size_t i = 0; i < n; i++) {
+            record.words[used + i] = words[i];
+        }
+        used += n;
+        record.tags |= static_cast<uint16_t>(static_cast<uint16_t>(tag) << (2 * record.count));
+        record.count++;
+    }
+
+    static void storeWide(Record& record, size_t& used, ArgTag tag, uint64_t value) noexcept {
+        const uint32_t words[2] = {static_cast<uint32_t>(value), static_cast<uint32_t>(value >> 32)};
+        store(record, used, tag, words, 2);
+    }
+
+    template<typename T>
+    static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    pack(Record& record, size_t& used, T value) noexcept {
+        if (sizeof(T) > sizeof(uint32_t)) {
+            storeWide(record, used, ArgTag::WIDE, static_cast<uint64_t>(value));
+        } else {
+            // Sign-extended at format time for %d/%i
+            const uint32_t word = static_cast<uint32_t>(value);
+            store(record, used, ArgTag::WORD, &word, 1);
+        }
+    }
+
+    template<typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value>::type
+    pack(Record& record, size_t& used, T value) noexcept {
+        const double d = static_cast<double>(value);
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof(bits));
+        storeWide(record, used, ArgTag::DOUBLE, bits);
+    }
+
+    template<typename T>
+    static void pack(Record& record, size_t& used, T* value) noexcept {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(value);
+        if (sizeof(uintptr_t) > sizeof(uint32_t)) {
+            storeWide(record, used, ArgTag::WIDE, static_cast<uint64_t>(address));
+        } else {
+            const uint32_t word = static_cast<uint32_t>(address);
+            store(record, used, ArgTag::WORD, &word, 1);
+        }
+    }
+
+    static void pack(Record& record, size_t& used, std::nullptr_t) noexcept {
+        const uint32_t word = 0;
+        store(record, used, ArgTag::WORD, &word, 1);
+    }
+
+    // Strings are copied: the caller's buffer may be gone before the flush
+    static void pack(Record& record, size_t& used, const char* text) noexcept {
+        uint32_t word = NULL_STRING;
+        if (text != nullptr) {
+            size_t offset = record.stringBytes;
+            word = static_cast<uint32_t>(offset);
+            if (offset >= STRING_BYTES) {
+                word = static_cast<uint32_t>(STRING_BYTES - 1);  // Out of space: the last terminator
+            } else {
+                while (*text != '\0' && offset < STRING_BYTES - 1) {
+                    record.strings[offset++] = *text++;
+                }
+                record.strings[offset++] = '\0';
+                record.stringBytes = static_cast<uint8_t>(offset);
+            }
+        }
+        store(record, used, ArgTag::STRING, &word, 1);
+    }
+
+    static void pack(Record& record, size_t& used, char* text) noexcept {
+        pack(record, used, static_cast<const char*>(text));
+    }
+
+    // Formatting
+
+    static void formatDump(const Record& record, Writer& writer) noexcept {
+        char chunk[48];
+        int n = snprintf(chunk, sizeof(chunk), "%s (%u bytes):",
+                         record.format != nullptr ? record.format : "",
+                         static_cast<unsigned>(record.totalLength));
+        writer.append(chunk, n > 0 ? static_cast<size_t>(n) : 0);
+        const auto* bytes = reinterpret_cast<const uint8_t*>(record.words);
+        for (size_t i = 0; i < record.count; i++) {
+            n = snprintf(chunk, sizeof(chunk), " %02X", static_cast<unsigned>(bytes[i]));
+            writer.append(chunk, static_cast<size_t>(n));
+        }
+        if (record.totalLength > record.count) {
+            writer.append(" ...", 4);
+        }
+    }
+
+    static void formatLog(const Record& record, Writer& writer) noexcept {
+        const char* p = record.format != nullptr ? record.format : "";
+        size_t arg = 0;
+        size_t word = 0;
+        while (*p != '\0') {
+            const char* percent = strchr(p, '%');
+            if (percent == nullptr) {
+                writer.append(p, strlen(p));
+                break;
+            }
+            writer.append(p, static_cast<size_t>(percent - p));
+            if (percent[1] == '%') {
+                writer.append("%", 1);
+                p = percent + 2;
+                continue;
+            }
+
+            // Copy flags/width/precision, skip length modifiers, find the conversion
+            char spec[24];
+            size_t specLen = 0;
+            const char* q = percent;
+            spec[specLen++] = *q++;
+            while (*q != '\0' && strchr("-+ #0123456789.", *q) != nullptr && specLen < sizeof(spec) - 4) {
+                spec[specLen++] = *q++;
+            }
+            while (*q != '\0' && strchr("hljztL", *q) != nullptr) {
+                q++;
+            }
+            const char conversion = *q;
+            if (conversion == '\0') {
+                break;
+            }
+            p = q + 1;
+
+            if (arg >= record.count) {
+                writer.append("?", 1);
+                continue;
+            }
+            const auto tag = static_cast<ArgTag>((record.tags >> (2 * arg)) & 0x3);
+            uint64_t raw = record.words[word];
+            if (tag == ArgTag::WIDE || tag == ArgTag::DOUBLE) {
+                raw |= static_cast<uint64_t>(record.words[word + 1]) << 32;
+                word += 2;
+            } else {
+                word += 1;
+            }
+            arg++;
+
+            char chunk[64];
+            int n = -1;
+            switch (conversion) {
+                case 'd': case 'i':
+                    spec[specLen++] = 'l'; spec[specLen++] = 'l'; spec[specLen++] = conversion; spec[specLen] = '\0';
+                    n = snprintf(chunk, sizeof(chunk), spec, tag == ArgTag::WORD
+                                 ? static_cast<long long>(static_cast<int32_t>(raw))
+                                 : static_cast<long long>(raw));
+                    break;
+                case 'u': case 'o': case 'x': case 'X':
+                    spec[specLen++] = 'l'; spec[specLen++] = 'l'; spec[specLen++] = conversion; spec[specLen] = '\0';
+                    n = snprintf(chunk, sizeof(chunk), spec, static_cast<unsigned long long>(raw));
+                    break;
+                case 'c':
+                    spec[specLen++] = 'c'; spec[specLen] = '\0';
+                    n = snprintf(chunk, sizeof(chunk), spec, static_cast<int>(raw));
+                    break;
+                case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                    if (tag == ArgTag::DOUBLE) {
+                        double d;
+                        memcpy(&d, &raw, sizeof(d));
+                        spec[specLen++] = conversion; spec[specLen] = '\0';
+                        n = snprintf(chunk, sizeof(chunk), spec, d);
+                    }
+                    break;
+                case 's':
+                    if (tag == ArgTag::STRING && (raw == NULL_STRING || raw < record.stringBytes)) {
+                        const char* text = raw == NULL_STRING ? "(null)" : record.strings + raw;
+                        spec[specLen++] = 's'; spec[specLen] = '\0';
+                        n = snprintf(chunk, sizeof(chunk), spec, text);
+                    }
+                    break;
+                case 'p':
+                    if (tag != ArgTag::STRING && tag != ArgTag::DOUBLE) {
+                        n = snprintf(chunk, sizeof(chunk), "%p", reinterpret_cast<void*>(static_cast<uintptr_t>(raw)));
+                    }
+                    break;
+                default:
+                    break;
+            }
+            if (n < 0) {
+                writer.append("?", 1);
+            } else {
+                writer.append(chunk, static_cast<size_t>(n) < sizeof(chunk) ? static_cast<size_t>(n)
+                                                                             : sizeof(chunk) - 1);
+            }
+        }
+    }
+
+    static void writeToLog(void*, const Record& record) {
+        static const char letters[] = "NEWIDV";
+        char text[192];
+        format(record, text, sizeof(text));
+        const uint8_t level = record.level < sizeof(letters) - 1 ? record.level : 0;
+        esp_log_write(static_cast<esp_log_level_t>(level), record.tag != nullptr ? record.tag : "",
+                      "%c (%lu) %s: %s\n", letters[level],
+                      static_cast<unsigned long>(record.timestampUs / 1000),
+                      record.tag != nullptr ? record.tag : "", text);
+    }
+
+    static void taskEntry(void* param) {
+        auto* self = static_cast<DeviceDeferredLog*>(param);
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(IDEV_DEFERRED_LOG_FLUSH_MS));
+            self->flushToLog();
+        }
+    }
+
+    // Bounded MPSC queue (Vyukov), same scheme as DeviceEventDispatcher
+    bool enqueue(const Record& record) noexcept {
+        uint32_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & MASK];
+            const uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+            const int32_t diff = static_cast<int32_t>(seq - pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->record = record;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool dequeue(Record& out) noexcept {
+        Cell* cell = &cells_[dequeuePos_ & MASK];
+        const uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+        if (static_cast<int32_t>(seq - (dequeuePos_ + 1)) < 0) {
+            return false;
+        }
+        out = cell->record;
+        cell->sequence.store(dequeuePos_ + static_cast<uint32_t>(QUEUE_LENGTH), std::memory_order_release);
+        dequeuePos_++;
+        return true;
+    }
+
+    std::atomic<TaskHandle_t> task_;
+    Cell cells_[QUEUE_LENGTH];
+    uint32_t dequeuePos_;
+    std::atomic<uint32_t> enqueuePos_;
+    std::atomic<uint32_t> dropped_;
+};
+
+/**
+ * @brief Queue a message on the library-wide deferred log
+ *
+ * The unevaluated checkFormat() branch gives the call printf format
+ * checking (-Wformat) without formatting anything at run time.
+ */
+#define IDEV_DEFERRED_LOG(level, tag, ...) \
+    (false ? DeviceDeferredLog::checkFormat(__VA_ARGS__) \
+           : static_cast<void>(DeviceDeferredLog::instance().log(level, tag, __VA_ARGS__)))
+
+#endif // DEVICE_DEFERRED_LOG_H
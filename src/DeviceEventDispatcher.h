@@ -0,0 +1,329 @@
+/**
+ * @file DeviceEventDispatcher.h
+ * @brief Shared event dispatch task for IDeviceInstance callbacks
+ *
+ * Instead of one notifier task per driver, all devices post their
+ * EventNotifications into one lock-free MPSC queue drained by a single
+ * dispatcher task. RAM use stays flat as devices are added and callback
+ * latency is bounded by one queue hop.
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_EVENT_DISPATCHER_H
+#define DEVICE_EVENT_DISPATCHER_H
+
+#include "IDeviceInstance.h"
+#include "freertos/task.h"
+#include <atomic>
+
+/**
+ * @brief Queue length of the dispatcher (must be a power of two)
+ */
+#ifndef IDEV_DISPATCHER_QUEUE_LENGTH
+#define IDEV_DISPATCHER_QUEUE_LENGTH 32
+#endif
+
+/**
+ * @brief Default dispatcher task stack size in bytes
+ */
+#ifndef IDEV_DISPATCHER_STACK_SIZE
+#define IDEV_DISPATCHER_STACK_SIZE 3072
+#endif
+
+/**
+ * @brief Default dispatcher task priority
+ */
+#ifndef IDEV_DISPATCHER_PRIORITY
+#define IDEV_DISPATCHER_PRIORITY 2
+#endif
+
+/**
+ * @class DeviceEventDispatcher
+ * @brief Single task delivering events from many devices
+ *
+ * Drivers keep an IDeviceInstance::EventCallbackTable and call post() where
+ * they previously created a notifier task. post() is lock-free, never
+ * allocates and may be called from any task or (via postFromISR()) ISR.
+ *
+ * @code
+ * DeviceEventDispatcher::instance().start(DeviceEventDispatcher::Config{3, 0});
+ * ...
+ * // in the driver
+ * DeviceEventDispatcher::instance().post(callbacks, {EventType::DATA_READY, DeviceError::SUCCESS, 0});
+ * @endcode
+ *
+ * @note The callback table must outlive every notification posted for it
+ * @note Callbacks run in the dispatcher task and must not block for long
+ */
+class DeviceEventDispatcher {
+public:
+    using DeviceError = IDeviceInstance::DeviceError;
+    using EventNotification = IDeviceInstance::EventNotification;
+    using EventCallbackTable = IDeviceInstance::EventCallbackTable;
+    template<typename T>
+    using DeviceResult = IDeviceInstance::DeviceResult<T>;
+
+    static constexpr size_t QUEUE_LENGTH = IDEV_DISPATCHER_QUEUE_LENGTH;
+    static_assert(QUEUE_LENGTH >= 2 && (QUEUE_LENGTH & (QUEUE_LENGTH - 1)) == 0,
+                  "IDEV_DISPATCHER_QUEUE_LENGTH must be a power of two");
+
+    /**
+     * @brief Dispatcher task configuration
+     */
+    struct Config {
+        UBaseType_t priority;   ///< Task priority
+        BaseType_t coreId;      ///< Core affinity (0, 1 or tskNO_AFFINITY)
+        uint32_t stackSize;     ///< Stack size in bytes
+        const char* name;       ///< Task name
+
+        Config(UBaseType_t taskPriority = IDEV_DISPATCHER_PRIORITY,
+               BaseType_t core = tskNO_AFFINITY,
+               uint32_t taskStackSize = IDEV_DISPATCHER_STACK_SIZE,
+               const char* taskName = "IDevEvents")
+            : priority(taskPriority), coreId(core), stackSize(taskStackSize), name(taskName) {}
+    };
+
+    DeviceEventDispatcher() noexcept
+        : task_(nullptr), starting_(false), consuming_(false), dequeuePos_(0), enqueuePos_(0),
+          dropped_(0), delivered_(0) {
+        for (size_t i = 0; i < QUEUE_LENGTH; i++) {
+            cells_[i].sequence.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        }
+    }
+
+    DeviceEventDispatcher(const DeviceEventDispatcher&) = delete;
+    DeviceEventDispatcher& operator=(const DeviceEventDispatcher&) = delete;
+
+    /**
+     * @brief Library-wide shared dispatcher
+     */
+    static DeviceEventDispatcher& instance() {
+        static DeviceEventDispatcher dispatcher;
+        return dispatcher;
+    }
+
+    /**
+     * @brief Create the dispatcher task
+     *
+     * @param config Task priority, core affinity and stack size
+     * @return SUCCESS, DEVICE_BUSY while another task is inside start(),
+     *         or MEMORY_ERROR if the task could not be created
+     * @note Idempotent - returns SUCCESS if already running
+     * @note The dispatcher must have static storage duration; the task runs forever
+     */
+    DeviceError start(const Config& config = Config()) {
+        // Claim the single consumer slot before creating the task
+        portENTER_CRITICAL(&startLock_);
+        const bool running = task_.load(std::memory_order_relaxed) != nullptr;
+        const bool busy = starting_;
+        if (!running && !busy) {
+            starting_ = true;
+        }
+        portEXIT_CRITICAL(&startLock_);
+        if (running) {
+            return DeviceError::SUCCESS;
+        }
+        if (busy) {
+            return DeviceError::DEVICE_BUSY;
+        }
+
+        TaskHandle_t handle = nullptr;
+        const bool created = xTaskCreatePinnedToCore(&DeviceEventDispatcher::taskEntry, config.name,
+                                                     config.stackSize, this, config.priority, &handle,
+                                                     config.coreId) == pdPASS;
+        portENTER_CRITICAL(&startLock_);
+        if (created) {
+            task_.store(handle, std::memory_order_release);
+        }
+        starting_ = false;
+        portEXIT_CRITICAL(&startLock_);
+        if (!created) {
+            IDEV_LOG_E("Event dispatcher task creation failed");
+            return DeviceError::MEMORY_ERROR;
+        }
+        // Deliver anything posted before start()
+        xTaskNotifyGive(handle);
+        IDEV_LOG_I("Event dispatcher started (prio %u, core %d)",
+                   static_cast<unsigned>(config.priority), static_cast<int>(config.coreId));
+        return DeviceError::SUCCESS;
+    }
+
+    bool isRunning() const noexcept {
+        return task_.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /**
+     * @brief Queue a notification for delivery to a callback table
+     *
+     * @param table Callbacks to invoke
+     * @param notification The event
+     * @return false if the queue is full (notification dropped and counted)
+     */
+    bool post(const EventCallbackTable& table, const EventNotification& notification) noexcept {
+        if (!enqueue(table, notification)) {
+            return false;
+        }
+        TaskHandle_t handle = task_.load(std::memory_order_acquire);
+        if (handle != nullptr) {
+            xTaskNotifyGive(handle);
+        }
+        return true;
+    }
+
+    /**
+     * @brief ISR-safe variant of post()
+     *
+     * @param table Callbacks to invoke
+     * @param notification The event
+     * @param higherPriorityTaskWoken Set to pdTRUE if a context switch is required
+     * @return false if the queue is full
+     */
+    bool postFromISR(const EventCallbackTable& table, const EventNotification& notification,
+                     BaseType_t* higherPriorityTaskWoken) noexcept {
+        if (!enqueue(table, notification)) {
+            return false;
+        }
+        TaskHandle_t handle = task_.load(std::memory_order_acquire);
+        if (handle != nullptr) {
+            vTaskNotifyGiveFromISR(handle, higherPriorityTaskWoken);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Number of notifications dropped because the queue was full
+     */
+    uint32_t droppedCount() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of notifications delivered so far
+     */
+    uint32_t deliveredCount() const noexcept {
+        return delivered_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Deliver all queued notifications in the calling task
+     *
+     * For cooperative single-loop applications that do not call start().
+     *
+     * @return DeviceResult<size_t> with the number of notifications delivered;
+     *         DEVICE_BUSY if the dispatcher task is running (or starting) or
+     *         another task is draining - the queue has a single consumer
+     */
+    DeviceResult<size_t> drain() {
+        if (isRunning() || !claimConsumer()) {
+            return DeviceResult<size_t>(DeviceError::DEVICE_BUSY);
+        }
+        // start() may have created the task after the check above
+        if (starting_ || isRunning()) {
+            releaseConsumer();
+            return DeviceResult<size_t>(DeviceError::DEVICE_BUSY);
+        }
+        const size_t count = drainQueue();
+        releaseConsumer();
+        return DeviceResult<size_t>(count);
+    }
+
+private:
+    struct Entry {
+        const EventCallbackTable* table;
+        EventNotification notification;
+    };
+
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        Entry entry;
+    };
+
+    static constexpr uint32_t MASK = static_cast<uint32_t>(QUEUE_LENGTH - 1);
+
+    static void taskEntry(void* param) {
+        auto* self = static_cast<DeviceEventDispatcher*>(param);
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            // Wait out a cooperative drain() that began before start()
+            while (!self->claimConsumer()) {
+                vTaskDelay(1);
+            }
+            self->drainQueue();
+            self->releaseConsumer();
+        }
+    }
+
+    bool claimConsumer() noexcept {
+        return !consuming_.exchange(true, std::memory_order_acquire);
+    }
+
+    void releaseConsumer() noexcept {
+        consuming_.store(false, std::memory_order_release);
+    }
+
+    // Single consumer only - callers hold the consumer claim
+    size_t drainQueue() {
+        size_t count = 0;
+        Entry entry;
+        while (dequeue(entry)) {
+            entry.table->dispatch(entry.notification);
+            count++;
+        }
+        if (count > 0) {
+            delivered_.fetch_add(static_cast<uint32_t>(count), std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    // Bounded MPSC queue (Vyukov): producers claim a cell with CAS, the
+    // per-cell sequence tells the consumer when the entry is complete.
+    bool enqueue(const EventCallbackTable& table, const EventNotification& notification) noexcept {
+        uint32_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & MASK];
+            const uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+            const int32_t diff = static_cast<int32_t>(seq - pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->entry.table = &table;
+        cell->entry.notification = notification;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool dequeue(Entry& out) noexcept {
+        Cell* cell = &cells_[dequeuePos_ & MASK];
+        const uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+        if (static_cast<int32_t>(seq - (dequeuePos_ + 1)) < 0) {
+            return false;
+        }
+        out = cell->entry;
+        cell->sequence.store(dequeuePos_ + static_cast<uint32_t>(QUEUE_LENGTH), std::memory_order_release);
+        dequeuePos_++;
+        return true;
+    }
+
+    std::atomic<TaskHandle_t> task_;
+    std::atomic<bool> starting_;            ///< start() is creating the task (set under startLock_)
+    std::atomic<bool> consuming_;           ///< Single-consumer claim for dequeue()
+    portMUX_TYPE startLock_ = portMUX_INITIALIZER_UNLOCKED;
+    Cell cells_[QUEUE_LENGTH];
+    uint32_t dequeuePos_;
+    std::atomic<uint32_t> enqueuePos_;
+    std::atomic<uint32_t> dropped_;
+    std::atomic<uint32_t> delivered_;
+};
+
+#endif // DEVICE_EVENT_DISPATCHER_H
@@ -0,0 +1,594 @@
+/**
+ * @file DeviceHistory.h
+ * @brief On-device reading history with 1 s / 1 min / 15 min downsampling tiers
+ *
+ * Keeps the most recent raw samples plus three min/max/avg tiers that are
+ * updated incrementally on every add(). Trend detection and UI graphs read
+ * the tiers directly; range summaries combine whole buckets of the coarsest
+ * fitting tier and never scan raw samples. All storage is allocated once in
+ * begin() (PSRAM when available), so memory stays bounded.
+ *
+ * @code
+ * DeviceHistoryConfig config;
+ * config.channels = 8;
+ * config.divider = 10;
+ * history.begin(config);
+ *
+ * // processData():
+ * history.add(raw_, 8);
+ *
+ * // Consumer: last hour of channel 3
+ * const uint32_t now = DeviceHistory::nowSec();
+ * auto summary = history.summarize(3, now - 3600, now + 1);
+ * DeviceHistory::Bucket graph[60];
+ * size_t n = history.series(DeviceHistory::Tier::MINUTE, 3, now - 3600, now + 1, graph, 60);
+ * @endcode
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_HISTORY_H
+#define DEVICE_HISTORY_H
+
+#include "IDeviceInstance.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/semphr.h"
+
+/**
+ * @brief Sizing of a DeviceHistory (defaults with 8 channels: ~48 KB)
+ */
+struct DeviceHistoryConfig {
+    uint8_t channels = 1;           ///< Channels per sample (1..IDeviceInstance::MAX_CHANNELS)
+    int16_t divider = 1;            ///< Scale divider of the raw values (see ScaledValue)
+    size_t rawSamples = 600;        ///< Most recent raw samples kept
+    size_t secondBuckets = 300;     ///< 1 s buckets (default 5 min, at least 60)
+    size_t minuteBuckets = 240;     ///< 1 min buckets (default 4 h, at least 15)
+    size_t quarterBuckets = 96;     ///< 15 min buckets (default 24 h)
+    bool preferPsram = true;        ///< Try MALLOC_CAP_SPIRAM first, fall back to internal RAM
+};
+
+/**
+ * @class DeviceHistory
+ * @brief Bounded multi-resolution history of one device's raw readings
+ *
+ * - add(): task context, typically from processData(). O(channels) per
+ *   sample: appends to the raw ring and updates each tier's open bucket;
+ *   a bucket is written to its ring when its period ends.
+ * - recent(), series(), summarize(): any task. Lookups use binary search
+ *   on the time-ordered rings.
+ *
+ * Times are whole seconds since boot (nowSec()). Bucket averages are
+ * stored rounded to raw units.
+ */
+class DeviceHistory {
+public:
+    using DeviceError = IDeviceInstance::DeviceError;
+    template<typename T>
+    using DeviceResult = IDeviceInstance::DeviceResult<T>;
+
+    /**
+     * @brief Downsampling tiers
+     */
+    enum class Tier : uint8_t {
+        SECOND,         ///< 1 s buckets
+        MINUTE,         ///< 1 min buckets
+        QUARTER_HOUR,   ///< 15 min buckets
+        NUM_TIERS
+    };
+
+    static constexpr size_t NUM_TIERS = static_cast<size_t>(Tier::NUM_TIERS);
+
+    /**
+     * @brief Bucket length of a tier in seconds
+     */
+    static constexpr uint32_t periodSec(Tier tier) noexcept {
+        return tier == Tier::SECOND ? 1u : tier == Tier::MINUTE ? 60u : 900u;
+    }
+
+    /**
+     * @brief One raw sample of one channel
+     */
+    struct Sample {
+        uint64_t timestampMs;   ///< Milliseconds since boot
+        int16_t value;          ///< Raw value
+    };
+
+    /**
+     * @brief One downsampled bucket of one channel
+     */
+    struct Bucket {
+        uint32_t startSec;      ///< Bucket start (multiple of periodSec())
+        uint32_t count;         ///< Samples in the bucket (the open bucket is still growing)
+        int16_t min;
+        int16_t max;
+        int16_t avg;
+    };
+
+    /**
+     * @brief Aggregate over a time range of one channel
+     */
+    struct Summary {
+        uint32_t count = 0;         ///< Samples covered (0 = no data in range)
+        int16_t min = 0;
+        int16_t max = 0;
+        int16_t avg = 0;
+        bool approximate = false;   ///< An edge was widened to a coarse bucket because finer tiers had expired
+    };
+
+    DeviceHistory() noexcept
+        : channels_(0), divider_(1), mutex_(nullptr), storage_(nullptr), storageBytes_(0),
+          rawTimes_(nullptr), rawValues_(nullptr), raw_(), tiers_() {}
+
+    ~DeviceHistory() {
+        end();
+    }
+
+    DeviceHistory(const DeviceHistory&) = delete;
+    DeviceHistory& operator=(const DeviceHistory&) = delete;
+
+    /**
+     * @brief Allocate storage and start recording
+     *
+     * @param config Sizing; zero-sized rings are allowed and disable that level
+     * @return INVALID_PARAMETER for a bad channel count, DEVICE_BUSY if
+     *         already started, MEMORY_ERROR if allocation failed
+     */
+    DeviceResult<void> begin(const DeviceHistoryConfig& config) {
+        if (config.channels == 0 || config.channels > IDeviceInstance::MAX_CHANNELS) {
+            return DeviceResult<void>(DeviceError::INVALID_PARAMETER);
+        }
+        if (isReady()) {
+            return DeviceResult<void>(DeviceError::DEVICE_BUSY);
+        }
+
+        const size_t capacities[NUM_TIERS] = {config.secondBuckets, config.minuteBuckets, config.quarterBuckets};
+        // 32-bit arrays first, then the int16 arrays, so every region stays aligned
+        size_t bytes = config.rawSamples * sizeof(uint32_t);
+        for (size_t capacity : capacities) {
+            bytes += capacity * 2 * sizeof(uint32_t);
+        }
+        bytes += config.rawSamples * config.channels * sizeof(int16_t);
+        for (size_t capacity : capacities) {
+            bytes += capacity * config.channels * 3 * sizeof(int16_t);
+        }
+
+        SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+        if (mutex == nullptr) {
+            return DeviceResult<void>(DeviceError::MEMORY_ERROR);
+        }
+        uint8_t* block = nullptr;
+        if (config.preferPsram) {
+            block = static_cast<uint8_t*>(heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+        }
+        if (block == nullptr) {
+            block = static_cast<uint8_t*>(heap_caps_malloc(bytes, MALLOC_CAP_8BIT));
+        }
+        if (block == nullptr && bytes > 0) {
+            vSemaphoreDelete(mutex);
+            return DeviceResult<void>(DeviceError::MEMORY_ERROR);
+        }
+
+        uint8_t* cursor = block;
+        rawTimes_ = reinterpret_cast<uint32_t*>(cursor);
+        cursor += config.rawSamples * sizeof(uint32_t);
+        for (size_t t = 0; t < NUM_TIERS; t++) {
+            tiers_[t] = TierState();
+            tiers_[t].ring.init(capacities[t]);
+            tiers_[t].starts = reinterpret_cast<uint32_t*>(cursor);
+            cursor += capacities[t] * sizeof(uint32_t);
+            tiers_[t].counts = reinterpret_cast<uint32_t*>(cursor);
+            cursor += capacities[t] * sizeof(uint32_t);
+        }
+        rawValues_ = reinterpret_cast<int16_t*>(cursor);
+        cursor += config.rawSamples * config.channels * sizeof(int16_t);
+        for (size_t t = 0; t < NUM_TIERS; t++) {
+            tiers_[t].stats = reinterpret_cast<int16_t*>(cursor);
+            cursor += capacities[t] * config.channels * 3 * sizeof(int16_t);
+        }
+
+        raw_.init(config.rawSamples);
+        channels_ = config.channels;
+        divider_ = config.divider > 0 ? config.divider : 1;
+        storage_ = block;
+        storageBytes_ = bytes;
+        mutex_ = mutex;
+        return DeviceResult<void>();
+    }
+
+    /**
+     * @brief Stop recording and free all storage
+     * @note Must not race with add() or queries
+     */
+    void end() {
+        if (mutex_ != nullptr) {
+            vSemaphoreDelete(mutex_);
+            mutex_ = nullptr;
+        }
+        if (storage_ != nullptr) {
+            heap_caps_free(storage_);
+            storage_ = nullptr;
+        }
+        storageBytes_ = 0;
+        channels_ = 0;
+        hasSamples_ = false;
+    }
+
+    bool isReady() const noexcept { return mutex_ != nullptr; }
+    uint8_t channels() const noexcept { return channels_; }
+    int16_t divider() const noexcept { return divider_; }
+
+    /**
+     * @brief Bytes allocated by begin()
+     */
+    size_t memoryUsage() const noexcept { return storageBytes_; }
+
+    /**
+     * @brief Seconds since boot on the history time base
+     */
+    static uint32_t nowSec() noexcept {
+        return static_cast<uint32_t>(esp_timer_get_time() / 1000000);
+    }
+
+    /**
+     * @brief Record one sample of every channel
+     *
+     * @param raw Raw values, one per channel
+     * @param count Must equal channels()
+     * @param nowUs Sample time (default esp_timer_get_time())
+     * @return NOT_INITIALIZED before begin(), INVALID_PARAMETER for a wrong
+     *         count or a timestamp older than the previous sample
+     */
+    DeviceResult<void> add(const int16_t* raw, size_t count, int64_t nowUs = esp_timer_get_time()) {
+        if (!isReady()) {
+            return DeviceResult<void>(DeviceError::NOT_INITIALIZED);
+        }
+        if (raw == nullptr || count != channels_ || nowUs < 0) {
+            return DeviceResult<void>(DeviceError::INVALID_PARAMETER);
+        }
+        const uint32_t sec = static_cast<uint32_t>(nowUs / 1000000);
+        if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) {
+            return DeviceResult<void>(DeviceError::MUTEX_ERROR);
+        }
+        if (hasSamples_ && nowUs < lastUs_) {
+            xSemaphoreGive(mutex_);
+            return DeviceResult<void>(DeviceError::INVALID_PARAMETER);
+        }
+        hasSamples_ = true;
+        lastUs_ = nowUs;
+
+        if (raw_.capacity > 0) {
+            const size_t slot = raw_.push();
+            rawTimes_[slot] = static_cast<uint32_t>(nowUs / 1000);
+            for (size_t ch = 0; ch < channels_; ch++) {
+                rawValues_[slot * channels_ + ch] = raw[ch];
+            }
+        }
+
+        for (size_t t = 0; t < NUM_TIERS; t++) {
+            TierState& tier = tiers_[t];
+            const uint32_t bucketStart = sec - sec % periodSec(static_cast<Tier>(t));
+            if (tier.open.count > 0 && tier.open.startSec != bucketStart) {
+                closeBucket(tier);
+            }
+            OpenBucket& open = tier.open;
+            if (open.count == 0) {
+                open.startSec = bucketStart;
+                for (size_t ch = 0; ch < channels_; ch++) {
+                    open.min[ch] = raw[ch];
+                    open.max[ch] = raw[ch];
+                    open.sum[ch] = 0;
+                }
+            }
+            for (size_t ch = 0; ch < channels_; ch++) {
+                open.min[ch] = raw[ch] < open.min[ch] ? raw[ch] : open.min[ch];
+                open.max[ch] = raw[ch] > open.max[ch] ? raw[ch] : open.max[ch];
+                open.sum[ch] += raw[ch];
+            }
+            open.count++;
+        }
+        xSemaphoreGive(mutex_);
+        return DeviceResult<void>();
+    }
+
+    /**
+     * @brief Copy the most recent raw samples of one channel (oldest first)
+     *
+     * The raw ring keeps the low 32 bits of each millisecond timestamp;
+     * full timestamps are rebuilt backwards from the newest sample, which
+     * is exact as long as consecutive samples are less than ~49 days apart.
+     *
+     * @return Number of samples written (at most @p capacity)
+     */
+    size_t recent(uint8_t channel, Sample* out, size_t capacity) const {
+        if (!isReady() || channel >= channels_ || out == nullptr) {
+            return 0;
+        }
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+        const size_t n = raw_.size < capacity ? raw_.size : capacity;
+        uint64_t timestampMs = static_cast<uint64_t>(lastUs_ / 1000);
+        uint32_t newerMs = static_cast<uint32_t>(timestampMs);
+        for (size_t i = n; i-- > 0;) {
+            const size_t slot = raw_.at(raw_.size - n + i);
+            timestampMs -= static_cast<uint32_t>(newerMs - rawTimes_[slot]);  // Wrap-safe difference
+            newerMs = rawTimes_[slot];
+            out[i].timestampMs = timestampMs;
+            out[i].value = rawValues_[slot * channels_ + channel];
+        }
+        xSemaphoreGive(mutex_);
+        return n;
+    }
+
+    /**
+     * @brief Copy the buckets of one tier that start in [fromSec, toSec)
+     *
+     * @param tier The tier to read
+     * @param channel Channel index
+     * @param fromSec Range start (inclusive)
+     * @param toSec Range end (exclusive)
+     * @param out Destination
+     * @param capacity Number of buckets available in @p out
+     * @return Number of buckets written, oldest first; includes the still
+     *         open current bucket
+     */
+    size_t series(Tier tier, uint8_t channel, uint32_t fromSec, uint32_t toSec,
+                  Bucket* out, size_t capacity) const {
+        if (!isReady() || channel >= channels_ || out == nullptr || tier >= Tier::NUM_TIERS) {
+            return 0;
+        }
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+        const TierState& state = tiers_[static_cast<size_t>(tier)];
+        size_t n = 0;
+        for (size_t i = lowerBound(state, fromSec); i < state.ring.size && n < capacity; i++) {
+            const size_t slot = state.ring.at(i);
+            if (state.starts[slot] >= toSec) {
+                break;
+            }
+            out[n++] = storedBucket(state, slot, channel);
+        }
+        if (n < capacity && state.open.count > 0 && state.open.startSec >= fromSec && state.open.startSec < toSec) {
+            out[n++] = openBucket(state, channel);
+        }
+        xSemaphoreGive(mutex_);
+        return n;
+    }
+
+    /**
+     * @brief Min/max/avg of one channel over [fromSec, toSec)
+     *
+     * The range is covered with whole 15 min buckets in the middle and
+     * progressively finer buckets towards the edges, so the cost is
+     * logarithmic in the ring sizes plus at most ~150 buckets.
+     *
+     * @return DeviceResult<Summary>; Summary::count is 0 if the range holds no data
+     */
+    DeviceResult<Summary> summarize(uint8_t channel, uint32_t fromSec, uint32_t toSec) const {
+        if (!isReady()) {
+            return DeviceResult<Summary>(DeviceError::NOT_INITIALIZED);
+        }
+        if (channel >= channels_ || fromSec > toSec) {
+            return DeviceResult<Summary>(DeviceError::INVALID_PARAMETER);
+        }
+        Accumulator acc;
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+        cover(NUM_TIERS - 1, channel, fromSec, toSec, acc);
+        xSemaphoreGive(mutex_);
+
+        Summary summary;
+        summary.count = acc.count;
+        summary.approximate = acc.approximate;
+        if (acc.count > 0) {
+            summary.min = acc.min;
+            summary.max = acc.max;
+            summary.avg = static_cast<int16_t>(roundedDiv(acc.weightedSum, acc.count));
+        }
+        return DeviceResult<Summary>(summary);
+    }
+
+private:
+    struct Ring {
+        size_t capacity = 0;
+        size_t head = 0;    ///< Next slot to write
+        size_t size = 0;
+
+        void init(size_t cap) noexcept {
+            capacity = cap;
+            head = 0;
+            size = 0;
+        }
+
+        /** @brief Claim the next slot, evicting the oldest when full */
+        size_t push() noexcept {
+            const size_t slot = head;
+            head = head + 1 == capacity ? 0 : head + 1;
+            if (size < capacity) {
+                size++;
+            }
+            return slot;
+        }
+
+        /** @brief Slot of the i-th oldest element */
+        size_t at(size_t i) const noexcept {
+            return (head + capacity - size + i) % capacity;
+        }
+
+        bool wrapped() const noexcept { return size == capacity && capacity > 0; }
+    };
+
+    struct OpenBucket {
+        uint32_t startSec = 0;
+        uint32_t count = 0;
+        int16_t min[IDeviceInstance::MAX_CHANNELS] = {};
+        int16_t max[IDeviceInstance::MAX_CHANNELS] = {};
+        int64_t sum[IDeviceInstance::MAX_CHANNELS] = {};   ///< 32 bits overflow after 65536 full-scale samples
+    };
+
+    struct TierState {
+        Ring ring;
+        uint32_t* starts = nullptr;
+        uint32_t* counts = nullptr;
+        int16_t* stats = nullptr;   ///< min, max, avg per channel per bucket
+        OpenBucket open;
+    };
+
+    struct Accumulator {
+        uint32_t count = 0;
+        int16_t min = 0;
+        int16_t max = 0;
+        int64_t weightedSum = 0;
+        bool approximate = false;
+
+        void add(const Bucket& bucket) noexcept {
+            if (bucket.count == 0) {
+                return;
+            }
+            min = count == 0 || bucket.min < min ? bucket.min : min;
+            max = count == 0 || bucket.max > max ? bucket.max : max;
+            weightedSum += static_cast<int64_t>(bucket.avg) * bucket.count;
+            count += bucket.count;
+        }
+    };
+
+    static int64_t roundedDiv(int64_t numerator, int64_t denominator) noexcept {
+        return numerator >= 0 ? (numerator + denominator / 2) / denominator
+                              : (numerator - denominator / 2) / denominator;
+    }
+
+    void closeBucket(TierState& tier) noexcept {
+        OpenBucket& open = tier.open;
+        if (tier.ring.capacity > 0) {
+            const size_t slot = tier.ring.push();
+            tier.starts[slot] = open.startSec;
+            tier.counts[slot] = open.count;
+            int16_t* stats = tier.stats + slot * channels_ * 3;
+            for (size_t ch = 0; ch < channels_; ch++) {
+                stats[ch * 3] = open.min[ch];
+                stats[ch * 3 + 1] = open.max[ch];
+                stats[ch * 3 + 2] = static_cast<int16_t>(roundedDiv(open.sum[ch], open.count));
+            }
+        }
+        open.count = 0;
+    }
+
+    Bucket storedBucket(const TierState& tier, size_t slot, uint8_t channel) const noexcept {
+        const int16_t* stats = tier.stats + (slot * channels_ + channel) * 3;
+        return Bucket{tier.starts[slot], tier.counts[slot], stats[0], stats[1], stats[2]};
+    }
+
+    static Bucket openBucket(const TierState& tier, uint8_t channel) noexcept {
+        const OpenBucket& open = tier.open;
+        return Bucket{open.startSec, open.count, open.min[channel], open.max[channel],
+                      static_cast<int16_t>(roundedDiv(open.sum[channel], open.count))};
+    }
+
+    /**
+     * @brief Index (oldest = 0) of the first stored bucket starting at or after @p sec
+     */
+    static size_t lowerBound(const TierState& tier, uint32_t sec) noexcept {
+        size_t lo = 0;
+        size_t hi = tier.ring.size;
+        while (lo < hi) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (tier.starts[tier.ring.at(mid)] < sec) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    /**
+     * @brief Earliest time the tier still has complete data for (0 = since begin())
+     */
+    static uint32_t coverageStart(const TierState& tier) noexcept {
+        if (tier.ring.wrapped()) {
+            return tier.starts[tier.ring.at(0)];
+        }
+        if (tier.ring.capacity == 0) {
+            return tier.open.count > 0 ? tier.open.startSec : UINT32_MAX;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Add the buckets of one tier (stored and open) that lie entirely in [from, to)
+     */
+    void addBuckets(const TierState& tier, uint32_t period, uint8_t channel,
+                    uint32_t from, uint32_t to, Accumulator& acc) const noexcept {
+        for (size_t i = lowerBound(tier, from); i < tier.ring.size; i++) {
+            const size_t slot = tier.ring.at(i);
+            if (tier.starts[slot] >= to || to - tier.starts[slot] < period) {
+                break;
+            }
+            acc.add(storedBucket(tier, slot, channel));
+        }
+        if (tier.open.count > 0 && tier.open.startSec >= from && tier.open.startSec < to &&
+            to - tier.open.startSec >= period) {
+            acc.add(openBucket(tier, channel));
+        }
+    }
+
+    /**
+     * @brief Aggregate [from, to) using tier @p t for whole buckets and finer tiers for the edges
+     */
+    void cover(size_t t, uint8_t channel, uint32_t from, uint32_t to, Accumulator& acc) const noexcept {
+        if (from >= to) {
+            return;
+        }
+        const uint32_t period = periodSec(static_cast<Tier>(t));
+        const TierState& tier = tiers_[t];
+        if (t == 0) {
+            addBuckets(tier, period, channel, from, to, acc);
+            return;
+        }
+        const uint64_t alignedFrom = (static_cast<uint64_t>(from) + period - 1) / period * period;
+        const uint32_t alignedTo = to - to % period;
+        if (alignedFrom > alignedTo) {
+            coverEdge(t, channel, from, to, alignedTo, acc);   // Inside a single bucket
+            return;
+        }
+        const uint32_t innerFrom = static_cast<uint32_t>(alignedFrom);
+        addBuckets(tier, period, channel, innerFrom, alignedTo, acc);
+        coverEdge(t, channel, from, innerFrom, innerFrom - period, acc);
+        coverEdge(t, channel, alignedTo, to, alignedTo, acc);
+    }
+
+    /**
+     * @brief Cover a partial-bucket edge with the next finer tier, or with the
+     *        enclosing bucket of tier @p t if the finer tier has expired
+     */
+    void coverEdge(size_t t, uint8_t channel, uint32_t from, uint32_t to, uint32_t enclosingStart,
+                   Accumulator& acc) const noexcept {
+        if (from >= to) {
+            return;
+        }
+        if (coverageStart(tiers_[t - 1]) <= from) {
+            cover(t - 1, channel, from, to, acc);
+            return;
+        }
+        const uint32_t period = periodSec(static_cast<Tier>(t));
+        const uint32_t before = acc.count;
+        addBuckets(tiers_[t], period, channel, enclosingStart, enclosingStart + period, acc);
+        if (acc.count != before) {
+            acc.approximate = true;
+        } else {
+            cover(t - 1, channel, from, to, acc);
+        }
+    }
+
+    uint8_t channels_;
+    int16_t divider_;
+    SemaphoreHandle_t mutex_;
+    uint8_t* storage_;
+    size_t storageBytes_;
+    uint32_t* rawTimes_;
+    int16_t* rawValues_;
+    Ring raw_;
+    TierState tiers_[NUM_TIERS];
+    bool hasSamples_ = false;
+    int64_t lastUs_ = 0;
+};
+
+#endif // DEVICE_HISTORY_H
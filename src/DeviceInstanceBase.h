@@ -0,0 +1,163 @@
+/**
+ * @file DeviceInstanceBase.h
+ * @brief CRTP base implementing the IDeviceInstance hot path via static dispatch
+ *
+ * Drivers deriving from DeviceInstanceBase<Derived> implement plain
+ * `...Impl()` methods. The base implements the corresponding IDeviceInstance
+ * virtuals as `final` forwarders, so:
+ * - type-erased code keeps using IDeviceInstance* unchanged
+ * - code that knows the concrete type (templates, `Derived&`) calls the same
+ *   methods without a vtable lookup and the compiler can inline them
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_INSTANCE_BASE_H
+#define DEVICE_INSTANCE_BASE_H
+
+#include "IDeviceInstance.h"
+
+/**
+ * @class DeviceInstanceBase
+ * @brief Static-dispatch adapter for IDeviceInstance drivers
+ * @tparam Derived The concrete driver class
+ *
+ * Required in Derived:
+ * - `DeviceResult<void> initializeImpl()`
+ * - `bool isInitializedImpl() const noexcept`
+ * - `DeviceResult<void> requestDataImpl()`
+ * - `DeviceError waitForDataImpl(TickType_t xTicksToWait)`
+ * - `DeviceResult<void> processDataImpl()`
+ * - `DeviceResult<std::vector<float>> getDataImpl(DeviceDataType dataType)`
+ *
+ * Optional in Derived (defaults reuse the IDeviceInstance behaviour):
+ * getDataRawImpl, getDataIntoImpl, getDataRawIntoImpl, getChannelImpl,
+ * getChannelRawImpl, getDataScaleDividerImpl(dataType, channel),
+ * getCapabilitiesImpl() (e.g. returning a static constexpr CAPABILITIES).
+ *
+ * Both waitForData() overloads are served by waitForDataImpl(). The
+ * remaining pure virtuals (mutexes, event group, callbacks, actions,
+ * initialization waits) are implemented by Derived as usual.
+ *
+ * @code
+ * class MB8ART : public DeviceInstanceBase<MB8ART> {
+ *     friend class DeviceInstanceBase<MB8ART>;
+ *     DeviceResult<size_t> getDataRawIntoImpl(DeviceDataType t, int16_t* out, size_t cap);
+ *     ...
+ * };
+ *
+ * template<typename Device>
+ * int16_t readFirst(Device& dev) {      // devirtualized for Device = MB8ART
+ *     auto r = dev.getChannelRaw(IDeviceInstance::DeviceDataType::TEMPERATURE, 0);
+ *     return r.isOk() ? r.value() : 0;
+ * }
+ * @endcode
+ */
+template<typename Derived>
+class DeviceInstanceBase : public IDeviceInstance {
+public:
+    DeviceResult<void> initialize() final {
+        return derived().initializeImpl();
+    }
+
+    bool isInitialized() const noexcept final {
+        return derived().isInitializedImpl();
+    }
+
+    using IDeviceInstance::requestData;
+
+    DeviceResult<void> requestData() final {
+        return derived().requestDataImpl();
+    }
+
+    bool waitForData() final {
+        return derived().waitForDataImpl(portMAX_DELAY) == DeviceError::SUCCESS;
+    }
+
+    DeviceError waitForData(TickType_t xTicksToWait) final {
+        return derived().waitForDataImpl(xTicksToWait);
+    }
+
+    DeviceResult<void> processData() final {
+        return derived().processDataImpl();
+    }
+
+    DeviceResult<std::vector<float>> getData(DeviceDataType dataType) final {
+        return derived().getDataImpl(dataType);
+    }
+
+    DeviceResult<std::vector<int16_t>> getDataRaw(DeviceDataType dataType) final {
+        return derived().getDataRawImpl(dataType);
+    }
+
+    DeviceResult<size_t> getDataInto(DeviceDataType dataType, float* out, size_t capacity) final {
+        return derived().getDataIntoImpl(dataType, out, capacity);
+    }
+
+    DeviceResult<size_t> getDataRawInto(DeviceDataType dataType, int16_t* out, size_t capacity) final {
+        return derived().getDataRawIntoImpl(dataType, out, capacity);
+    }
+
+    DeviceResult<float> getChannel(DeviceDataType dataType, uint8_t channel) final {
+        return derived().getChannelImpl(dataType, channel);
+    }
+
+    DeviceResult<int16_t> getChannelRaw(DeviceDataType dataType, uint8_t channel) final {
+        return derived().getChannelRawImpl(dataType, channel);
+    }
+
+    using IDeviceInstance::getDataScaleDivider;
+
+    int16_t getDataScaleDivider(DeviceDataType dataType, uint8_t channel) const final {
+        return derived().getDataScaleDividerImpl(dataType, channel);
+    }
+
+    const DeviceCapabilities& getCapabilities() const noexcept final {
+        return derived().getCapabilitiesImpl();
+    }
+
+protected:
+    DeviceInstanceBase() noexcept = default;
+
+    // Default implementations - hidden by Derived when it provides its own
+
+    DeviceResult<std::vector<int16_t>> getDataRawImpl(DeviceDataType dataType) {
+        return IDeviceInstance::getDataRaw(dataType);
+    }
+
+    DeviceResult<size_t> getDataIntoImpl(DeviceDataType dataType, float* out, size_t capacity) {
+        return IDeviceInstance::getDataInto(dataType, out, capacity);
+    }
+
+    DeviceResult<size_t> getDataRawIntoImpl(DeviceDataType dataType, int16_t* out, size_t capacity) {
+        return IDeviceInstance::getDataRawInto(dataType, out, capacity);
+    }
+
+    DeviceResult<float> getChannelImpl(DeviceDataType dataType, uint8_t channel) {
+        return IDeviceInstance::getChannel(dataType, channel);
+    }
+
+    DeviceResult<int16_t> getChannelRawImpl(DeviceDataType dataType, uint8_t channel) {
+        return IDeviceInstance::getChannelRaw(dataType, channel);
+    }
+
+    int16_t getDataScaleDividerImpl(DeviceDataType dataType, uint8_t channel) const {
+        return IDeviceInstance::getDataScaleDivider(dataType, channel);
+    }
+
+    const DeviceCapabilities& getCapabilitiesImpl() const noexcept {
+        return IDeviceInstance::getCapabilities();
+    }
+
+private:
+    Derived& derived() noexcept {
+        return static_cast<Derived&>(*this);
+    }
+
+    const Derived& derived() const noexcept {
+        return static_cast<const Derived&>(*this);
+    }
+};
+
+#endif // DEVICE_INSTANCE_BASE_H
@@ -0,0 +1,418 @@
+/**
+ * @file DevicePoller.h
+ * @brief Single-task polling engine for many IDeviceInstance devices
+ *
+ * Drives the requestData() -> waitForData() -> processData() cycle for N
+ * devices from one FreeRTOS task instead of one task per device. Devices on
+ * different buses (different getMutexInterface()) keep their requests in
+ * flight concurrently; devices sharing a bus are serialized and take
+ * turns, the one due the longest first.
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_POLLER_H
+#define DEVICE_POLLER_H
+
+#include "IDeviceInstance.h"
+#include "freertos/task.h"
+#include <atomic>
+
+/**
+ * @brief Maximum number of devices driven by one poller
+ */
+#ifndef IDEV_POLLER_MAX_DEVICES
+#define IDEV_POLLER_MAX_DEVICES 8
+#endif
+
+/**
+ * @brief Default poller task stack size in bytes
+ */
+#ifndef IDEV_POLLER_STACK_SIZE
+#define IDEV_POLLER_STACK_SIZE 4096
+#endif
+
+/**
+ * @class DevicePoller
+ * @brief Cooperative request/wait/process state machine for N devices
+ *
+ * Readiness of an in-flight request is detected from the device's event
+ * group (getEventGroup()) when the data-ready bits are given to add(),
+ * otherwise through a non-blocking waitForData(0). While every in-flight
+ * request signals through bits of one event group, the poller task blocks
+ * in xEventGroupWaitBits() on them; otherwise it re-checks every
+ * setIdleWaitTicks() ticks.
+ *
+ * @note Drivers polled without event bits must implement
+ *       waitForData(TickType_t) without blocking for a zero timeout. The
+ *       IDeviceInstance default cannot and reports NOT_SUPPORTED, which
+ *       fails the cycle
+ * @note DATA_NOT_READY from waitForData(0) means "not yet"; from
+ *       processData() it ends the cycle without new data and is counted
+ *       in DeviceCounters::notReady, not as an error
+ *
+ * @code
+ * DevicePoller poller;
+ * poller.add(&mb8art, pdMS_TO_TICKS(500), pdMS_TO_TICKS(200), MB8ART_DATA_READY_BIT);
+ * poller.add(&andrtf3, pdMS_TO_TICKS(1000));
+ * poller.start(4);
+ * @endcode
+ */
+class DevicePoller {
+public:
+    using DeviceError = IDeviceInstance::DeviceError;
+
+    static constexpr size_t MAX_DEVICES = IDEV_POLLER_MAX_DEVICES;
+
+    /**
+     * @brief Per-sample callback, invoked from the poller task after processData()
+     * @param context User context passed to add()
+     * @param device The sampled device
+     * @param result SUCCESS or the error of the failed step
+     */
+    using SampleFn = void (*)(void* context, IDeviceInstance* device, DeviceError result);
+
+    /**
+     * @brief Counters for one polled device
+     */
+    struct DeviceCounters {
+        uint32_t samples = 0;       ///< Completed cycles (successful processData())
+        uint32_t errors = 0;        ///< requestData()/processData()/error-bit failures
+        uint32_t timeouts = 0;      ///< Responses that missed responseTimeout
+        uint32_t notReady = 0;      ///< Cycles that ended with DATA_NOT_READY
+    };
+
+    DevicePoller() noexcept
+        : count_(0), task_(nullptr), idleWaitTicks_(1), waitGroup_(nullptr), waitBits_(0) {}
+
+    DevicePoller(const DevicePoller&) = delete;
+    DevicePoller& operator=(const DevicePoller&) = delete;
+
+    /**
+     * @brief Add a device to the polling set
+     *
+     * @param device Device to poll
+     * @param interval Time between request starts
+     * @param responseTimeout Maximum wait for data after requestData()
+     * @param dataReadyBits Event group bits signalling data ready (0 = use waitForData(0))
+     * @param errorBits Event group bits signalling a failed request (optional)
+     * @param onSample Optional per-sample callback
+     * @param context Passed to onSample
+     * @return SUCCESS, INVALID_PARAMETER for a null device, MEMORY_ERROR if full
+     */
+    DeviceError add(IDeviceInstance* device, TickType_t interval,
+                    TickType_t responseTimeout = pdMS_TO_TICKS(1000),
+                    EventBits_t dataReadyBits = 0, EventBits_t errorBits = 0,
+                    SampleFn onSample = nullptr, void* context = nullptr) noexcept {
+        if (device == nullptr) {
+            return DeviceError::INVALID_PARAMETER;
+        }
+        const size_t index = count_.load(std::memory_order_relaxed);
+        if (index >= MAX_DEVICES) {
+            return DeviceError::MEMORY_ERROR;
+        }
+        Entry& entry = entries_[index];
+        entry = Entry();
+        entry.device = device;
+        entry.bus = device->getMutexInterface();
+        entry.interval = interval;
+        entry.responseTimeout = responseTimeout;
+        entry.dataReadyBits = dataReadyBits;
+        entry.errorBits = errorBits;
+        entry.onSample = onSample;
+        entry.context = context;
+        entry.nextDue = xTaskGetTickCount();
+        count_.store(index + 1, std::memory_order_release);
+        wake();
+        return DeviceError::SUCCESS;
+    }
+
+    size_t size() const noexcept {
+        return count_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Counters of the device at @p index (order of add())
+     */
+    DeviceCounters getCounters(size_t index) const noexcept {
+        return index < size() ? entries_[index].counters : DeviceCounters();
+    }
+
+    /**
+     * @brief Ticks to sleep between readiness checks while requests without
+     *        a common event group are in flight
+     */
+    void setIdleWaitTicks(TickType_t ticks) noexcept {
+        idleWaitTicks_ = ticks > 0 ? ticks : 1;
+    }
+
+    /**
+     * @brief Start the poller task
+     * @param priority Task priority
+     * @param coreId Core affinity
+     * @param stackSize Stack size in bytes
+     * @return SUCCESS or MEMORY_ERROR
+     * @note The poller must outlive the task, which runs forever
+     */
+    DeviceError start(UBaseType_t priority, BaseType_t coreId = tskNO_AFFINITY,
+                      uint32_t stackSize = IDEV_POLLER_STACK_SIZE) {
+        if (task_.load(std::memory_order_acquire) != nullptr) {
+            return DeviceError::SUCCESS;
+        }
+        TaskHandle_t handle = nullptr;
+        if (xTaskCreatePinnedToCore(&DevicePoller::taskEntry, "IDevPoll", stackSize,
+                                    this, priority, &handle, coreId) != pdPASS) {
+            IDEV_LOG_E("Poller task creation failed");
+            return DeviceError::MEMORY_ERROR;
+        }
+        task_.store(handle, std::memory_order_release);
+        return DeviceError::SUCCESS;
+    }
+
+    /**
+     * @brief Wake the poller task early (e.g. from a data-ready callback)
+     *
+     * @note While the task blocks on data-ready bits the wakeup is taken
+     *       on its next poll()
+     */
+    void wake() noexcept {
+        TaskHandle_t handle = task_.load(std::memory_order_acquire);
+        if (handle != nullptr) {
+            xTaskNotifyGive(handle);
+        }
+    }
+
+    /**
+     * @brief Advance every device's state machine once
+     *
+     * Used by the poller task; can also be called from an existing loop
+     * instead of start().
+     *
+     * @return Longest sensible wait before the next poll(). With a request
+     *         in flight that signals through event bits this is its
+     *         remaining response timeout, so sleep with waitForWork()
+     * @note Must only be called from one task at a time
+     */
+    TickType_t poll() {
+        const size_t count = size();
+        const TickType_t now = xTaskGetTickCount();
+
+        for (size_t i = 0; i < count; i++) {
+            Entry& entry = entries_[i];
+            if (entry.inFlight) {
+                checkCompletion(entry, now);
+            }
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            Entry& entry = entries_[i];
+            if (!entry.inFlight && tickReached(now, entry.nextDue) && !busInFlight(entry.bus, count) &&
+                isNextOnBus(i, count)) {
+                startRequest(entry, now);
+            }
+        }
+
+        TickType_t wait = portMAX_DELAY;
+        EventGroupHandle_t group = nullptr;
+        EventBits_t bits = 0;
+        bool recheck = false;
+        for (size_t i = 0; i < count; i++) {
+            const Entry& entry = entries_[i];
+            TickType_t entryWait;
+            if (entry.inFlight) {
+                const TickType_t expiry = entry.requestedAt + entry.responseTimeout;
+                entryWait = tickReached(now, expiry) ? 0 : expiry - now;
+                EventGroupHandle_t entryGroup = entry.dataReadyBits != 0 ? entry.device->getEventGroup() : nullptr;
+                if (entryGroup == nullptr || (group != nullptr && entryGroup != group)) {
+                    recheck = true;
+                } else {
+                    group = entryGroup;
+                    bits |= entry.dataReadyBits | entry.errorBits;
+                }
+            } else if (tickReached(now, entry.nextDue)) {
+                if (busInFlight(entry.bus, count)) {
+                    continue;  // Waiting for its bus; the request in flight there decides
+                }
+                entryWait = 0;  // Lost its turn to a device whose request failed immediately
+            } else {
+                entryWait = entry.nextDue - now;
+            }
+            if (entryWait < wait) {
+                wait = entryWait;
+            }
+        }
+        if (recheck) {
+            group = nullptr;
+            if (idleWaitTicks_ < wait) {
+                wait = idleWaitTicks_;
+            }
+        }
+        waitGroup_ = group;
+        waitBits_ = bits;
+        return wait;
+    }
+
+    /**
+     * @brief Sleep until the next poll() is useful
+     *
+     * Blocks on the data-ready/error bits of the requests in flight when
+     * poll() found a common event group, otherwise on the task
+     * notification sent by wake().
+     *
+     * @param wait Value returned by the preceding poll()
+     * @note Call from the task that calls poll()
+     */
+    void waitForWork(TickType_t wait) {
+        if (wait == 0) {
+            return;
+        }
+        if (waitGroup_ != nullptr) {
+            xEventGroupWaitBits(waitGroup_, waitBits_, pdFALSE, pdFALSE, wait);
+            ulTaskNotifyTake(pdTRUE, 0);  // Wakeups are covered by the next poll()
+        } else {
+            ulTaskNotifyTake(pdTRUE, wait);
+        }
+    }
+
+private:
+    struct Entry {
+        IDeviceInstance* device = nullptr;
+        SemaphoreHandle_t bus = nullptr;
+        TickType_t interval = 0;
+        TickType_t responseTimeout = 0;
+        EventBits_t dataReadyBits = 0;
+        EventBits_t errorBits = 0;
+        SampleFn onSample = nullptr;
+        void* context = nullptr;
+        TickType_t nextDue = 0;
+        TickType_t requestedAt = 0;
+        bool inFlight = false;
+        bool warned = false;
+        DeviceCounters counters;
+    };
+
+    static bool tickReached(TickType_t now, TickType_t target) noexcept {
+        return static_cast<int32_t>(now - target) >= 0;
+    }
+
+    bool busInFlight(SemaphoreHandle_t bus, size_t count) const noexcept {
+        if (bus == nullptr) {
+            return false;  // No shared interface - never serialized
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (entries_[i].inFlight && entries_[i].bus == bus) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Devices on one bus take turns: the one due the longest goes first
+    bool isNextOnBus(size_t index, size_t count) const noexcept {
+        const Entry& entry = entries_[index];
+        if (entry.bus == nullptr) {
+            return true;
+        }
+        for (size_t i = 0; i < count; i++) {
+            const Entry& other = entries_[i];
+            if (i == index || other.inFlight || other.bus != entry.bus) {
+                continue;
+            }
+            const int32_t lead = static_cast<int32_t>(entry.nextDue - other.nextDue);
+            if (lead > 0 || (lead == 0 && i < index)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void startRequest(Entry& entry, TickType_t now) {
+        entry.nextDue = now + entry.interval;
+        EventGroupHandle_t group = entry.device->getEventGroup();
+        if (entry.dataReadyBits != 0 && group != nullptr) {
+            // Drop stale bits from a previous cycle
+            xEventGroupClearBits(group, entry.dataReadyBits | entry.errorBits);
+        }
+        auto result = entry.device->requestData();
+        if (!result.isOk()) {
+            finish(entry, result.error());
+            return;
+        }
+        entry.requestedAt = now;
+        entry.inFlight = true;
+    }
+
+    void checkCompletion(Entry& entry, TickType_t now) {
+        DeviceError state = readiness(entry);
+        if (state == DeviceError::TIMEOUT) {
+            if (!tickReached(now, entry.requestedAt + entry.responseTimeout)) {
+                return;  // Still waiting
+            }
+            entry.inFlight = false;
+            finish(entry, DeviceError::TIMEOUT);
+            return;
+        }
+        entry.inFlight = false;
+        if (state != DeviceError::SUCCESS) {
+            if (state == DeviceError::NOT_SUPPORTED && !entry.warned) {
+                entry.warned = true;
+                IDEV_LOG_W("Poller: device without data-ready bits needs a non-blocking waitForData(0)");
+            }
+            finish(entry, state);
+            return;
+        }
+        auto processed = entry.device->processData();
+        finish(entry, processed.isOk() ? DeviceError::SUCCESS : processed.error());
+    }
+
+    // SUCCESS = data ready, TIMEOUT = not yet, anything else = request failed
+    static DeviceError readiness(const Entry& entry) {
+        EventGroupHandle_t group = entry.device->getEventGroup();
+        if (entry.dataReadyBits == 0 || group == nullptr) {
+            const DeviceError state = entry.device->waitForData(static_cast<TickType_t>(0));
+            return state == DeviceError::DATA_NOT_READY ? DeviceError::TIMEOUT : state;
+        }
+        const EventBits_t bits = xEventGroupGetBits(group);
+        if ((bits & entry.dataReadyBits) != 0) {
+            xEventGroupClearBits(group, entry.dataReadyBits);
+            return DeviceError::SUCCESS;
+        }
+        if (entry.errorBits != 0 && (bits & entry.errorBits) != 0) {
+            xEventGroupClearBits(group, entry.errorBits);
+            return DeviceError::COMMUNICATION_ERROR;
+        }
+        return DeviceError::TIMEOUT;
+    }
+
+    static void finish(Entry& entry, DeviceError result) {
+        if (result == DeviceError::SUCCESS) {
+            entry.counters.samples++;
+        } else if (result == DeviceError::TIMEOUT) {
+            entry.counters.timeouts++;
+        } else if (result == DeviceError::DATA_NOT_READY) {
+            entry.counters.notReady++;
+        } else {
+            entry.counters.errors++;
+        }
+        if (entry.onSample != nullptr) {
+            entry.onSample(entry.context, entry.device, result);
+        }
+    }
+
+    static void taskEntry(void* param) {
+        auto* self = static_cast<DevicePoller*>(param);
+        for (;;) {
+            self->waitForWork(self->poll());
+        }
+    }
+
+    Entry entries_[MAX_DEVICES];
+    std::atomic<size_t> count_;
+    std::atomic<TaskHandle_t> task_;
+    TickType_t idleWaitTicks_;
+    EventGroupHandle_t waitGroup_;
+    EventBits_t waitBits_;
+};
+
+#endif // DEVICE_POLLER_H
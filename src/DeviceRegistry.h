@@ -0,0 +1,415 @@
+/**
+ * @file DeviceRegistry.h
+ * @brief Device set with parallel, deadline-bounded initialization and O(1) lookup
+ *
+ * Initializing devices one after another makes boot time the sum of every
+ * device's discovery and configuration. DeviceRegistry groups its devices
+ * by bus (getMutexInterface()), runs one short-lived init task per bus and
+ * waits for all of them with a single overall deadline, so buses overlap
+ * while devices on a shared bus still take turns.
+ *
+ * @code
+ * DeviceRegistry registry;
+ * registry.add(&mb8art, 0x01);                 // RS485
+ * registry.add(&ryn4, 0x02);                   // RS485, initialized after mb8art
+ * registry.add(&ds18b20, 0x10);                // 1-Wire, overlaps with RS485
+ *
+ * if (registry.initializeAll(pdMS_TO_TICKS(3000), 5) != DeviceError::SUCCESS) {
+ *     for (size_t i = 0; i < registry.size(); i++) {
+ *         const auto report = registry.getInitReport(i);
+ *         ESP_LOGW(TAG, "device %u: %d after %u us", registry.idAt(i), (int)report.result, report.durationUs);
+ *     }
+ * }
+ *
+ * IDeviceInstance* relays = registry.find(0x02);
+ * IDeviceInstance* thermometer = registry.firstWith(DeviceDataType::TEMPERATURE);
+ * @endcode
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_REGISTRY_H
+#define DEVICE_REGISTRY_H
+
+#include "IDeviceInstance.h"
+#include "esp_timer.h"
+#include "freertos/event_groups.h"
+#include "freertos/task.h"
+#include <atomic>
+
+/**
+ * @brief Maximum number of devices in one registry
+ */
+#ifndef IDEV_REGISTRY_MAX_DEVICES
+#define IDEV_REGISTRY_MAX_DEVICES 16
+#endif
+
+/**
+ * @brief Stack size of the per-bus init tasks in bytes
+ */
+#ifndef IDEV_REGISTRY_INIT_STACK_SIZE
+#define IDEV_REGISTRY_INIT_STACK_SIZE 4096
+#endif
+
+/**
+ * @class DeviceRegistry
+ * @brief Fixed-capacity device table keyed by an application device ID
+ *
+ * IDs are application-chosen 8-bit values (for example the Modbus
+ * address). Lookup by ID is a table index; lookup by DeviceDataType uses
+ * per-type device masks built from getCapabilities() in add(). Devices
+ * without a descriptor (hasCapabilities() false) are kept in a separate
+ * "unknown" mask: firstWith() falls back to them when no device declares
+ * the type, candidatesFor() includes them.
+ *
+ * - add(): setup time, before initializeAll()
+ * - initializeAll(): one caller at a time
+ * - find() / firstWith() / devicesWith(): lock-free after setup
+ *
+ * @note After a timed-out initializeAll() the init tasks keep running;
+ *       the destructor blocks until they finished
+ */
+class DeviceRegistry {
+public:
+    using DeviceError = IDeviceInstance::DeviceError;
+    using DeviceDataType = IDeviceInstance::DeviceDataType;
+    using DeviceId = uint8_t;
+    using DeviceMask = uint32_t;
+
+    static constexpr size_t MAX_DEVICES = IDEV_REGISTRY_MAX_DEVICES;
+    static_assert(MAX_DEVICES <= 24, "one event bit per bus group (24 usable bits)");
+
+    /**
+     * @brief Outcome of one device's initialization
+     */
+    struct InitReport {
+        DeviceError result = DeviceError::NOT_INITIALIZED;  ///< TIMEOUT while still running after the deadline
+        uint32_t durationUs = 0;    ///< initialize() plus waitForInitializationComplete()
+        uint32_t startOffsetUs = 0; ///< Start relative to initializeAll()
+        uint8_t busGroup = 0;       ///< Devices in one group were initialized in add() order
+    };
+
+    DeviceRegistry() noexcept
+        : devices_(), ids_(), reports_(), groupOf_(), groups_(), count_(0), groupCount_(0),
+          typeMasks_(), unknownMask_(0), deadline_(0), startUs_(0), running_(0),
+          doneGroup_(xEventGroupCreateStatic(&doneGroupBuffer_)) {
+        for (size_t i = 0; i < ID_TABLE_SIZE; i++) {
+            idIndex_[i] = NO_INDEX;
+        }
+    }
+
+    ~DeviceRegistry() {
+        // Init tasks reference this object until they decrement running_
+        while (isInitializing()) {
+            vTaskDelay(1);
+        }
+        vEventGroupDelete(doneGroup_);
+    }
+
+    DeviceRegistry(const DeviceRegistry&) = delete;
+    DeviceRegistry& operator=(const DeviceRegistry&) = delete;
+
+    /**
+     * @brief Register a device under an ID
+     *
+     * @param device Device to register
+     * @param id Application device ID (unique within the registry)
+     * @return SUCCESS, INVALID_PARAMETER for a null device or a duplicate
+     *         ID, MEMORY_ERROR if full, DEVICE_BUSY during initializeAll()
+     */
+    DeviceError add(IDeviceInstance* device, DeviceId id) noexcept {
+        if (device == nullptr || idIndex_[id] != NO_INDEX) {
+            return DeviceError::INVALID_PARAMETER;
+        }
+        if (isInitializing()) {
+            return DeviceError::DEVICE_BUSY;
+        }
+        if (count_ >= MAX_DEVICES) {
+            return DeviceError::MEMORY_ERROR;
+        }
+        const size_t index = count_;
+        devices_[index] = device;
+        ids_[index] = id;
+        reports_[index] = InitReport();
+        idIndex_[id] = static_cast<uint8_t>(index);
+
+        const auto& caps = device->getCapabilities();
+        if (!caps.isDeclared()) {
+            unknownMask_ |= DeviceMask(1) << index;
+        }
+        for (size_t type = 0; type < IDeviceInstance::NUM_DATA_TYPES; type++) {
+            if (caps.supports(static_cast<DeviceDataType>(type))) {
+                typeMasks_[type] |= DeviceMask(1) << index;
+            }
+        }
+
+        // Devices without an interface mutex never share a bus
+        SemaphoreHandle_t bus = device->getMutexInterface();
+        size_t group = groupCount_;
+        for (size_t g = 0; bus != nullptr && g < groupCount_; g++) {
+            if (groups_[g].bus == bus) {
+                group = g;
+                break;
+            }
+        }
+        if (group == groupCount_) {
+            groups_[group].owner = this;
+            groups_[group].bus = bus;
+            groups_[group].index = static_cast<uint8_t>(group);
+            groupCount_++;
+        }
+        groupOf_[index] = static_cast<uint8_t>(group);
+        reports_[index].busGroup = static_cast<uint8_t>(group);
+        count_ = index + 1;
+        return DeviceError::SUCCESS;
+    }
+
+    /**
+     * @brief Initialize every device, buses in parallel, within one deadline
+     *
+     * Starts one task per bus group. Each task calls initialize() and then
+     * waitForInitializationComplete(remaining time) for its devices in add()
+     * order. The caller blocks until all groups finished or @p timeout expired.
+     *
+     * @param timeout Overall deadline for all devices
+     * @param priority Priority of the init tasks
+     * @param stackSize Stack size of the init tasks in bytes
+     * @return SUCCESS if every device initialized; TIMEOUT if any device did
+     *         not finish in time; otherwise the first failure in add() order;
+     *         DEVICE_BUSY if a previous run is still active
+     */
+    DeviceError initializeAll(TickType_t timeout, UBaseType_t priority = 5,
+                              uint32_t stackSize = IDEV_REGISTRY_INIT_STACK_SIZE) {
+        if (count_ == 0) {
+            return DeviceError::SUCCESS;
+        }
+        if (isInitializing()) {
+            return DeviceError::DEVICE_BUSY;
+        }
+
+        const TickType_t start = xTaskGetTickCount();
+        deadline_ = timeout == portMAX_DELAY ? portMAX_DELAY : start + timeout;
+        startUs_ = esp_timer_get_time();
+        portENTER_CRITICAL(&lock_);
+        for (size_t i = 0; i < count_; i++) {
+            reports_[i].result = DeviceError::TIMEOUT;
+            reports_[i].durationUs = 0;
+            reports_[i].startOffsetUs = 0;
+        }
+        portEXIT_CRITICAL(&lock_);
+
+        const EventBits_t allGroups = static_cast<EventBits_t>((uint32_t(1) << groupCount_) - 1);
+        xEventGroupClearBits(doneGroup_, allGroups);
+        EventBits_t started = 0;
+        running_.store(groupCount_, std::memory_order_release);
+        for (size_t g = 0; g < groupCount_; g++) {
+            if (xTaskCreate(&DeviceRegistry::initTask, "IDevInit", stackSize, &groups_[g], priority,
+                            nullptr) == pdPASS) {
+                started |= EventBits_t(1) << g;
+                continue;
+            }
+            IDEV_LOG_E("Init task creation failed");
+            running_.fetch_sub(1, std::memory_order_acq_rel);
+            markGroup(g, DeviceError::MEMORY_ERROR);
+        }
+
+        if (started != 0) {
+            TickType_t wait = portMAX_DELAY;
+            if (timeout != portMAX_DELAY) {
+                const TickType_t elapsed = xTaskGetTickCount() - start;
+                wait = elapsed < timeout ? timeout - elapsed : 0;
+            }
+            const EventBits_t done = xEventGroupWaitBits(doneGroup_, started, pdFALSE, pdTRUE, wait);
+            if ((done & started) == started) {
+                // Each task sets its bit just before it lets go of the registry
+                while (isInitializing()) {
+                    vTaskDelay(1);
+                }
+            }
+        }
+
+        DeviceError first = DeviceError::SUCCESS;
+        portENTER_CRITICAL(&lock_);
+        for (size_t i = 0; i < count_; i++) {
+            const DeviceError result = reports_[i].result;
+            if (result == DeviceError::TIMEOUT) {
+                first = DeviceError::TIMEOUT;
+                break;
+            }
+            if (first == DeviceError::SUCCESS) {
+                first = result;
+            }
+        }
+        portEXIT_CRITICAL(&lock_);
+        return first;
+    }
+
+    /**
+     * @brief Check whether init tasks from initializeAll() are still running
+     */
+    bool isInitializing() const noexcept {
+        return running_.load(std::memory_order_acquire) != 0;
+    }
+
+    /**
+     * @brief Initialization outcome of the device at @p index (order of add())
+     */
+    InitReport getInitReport(size_t index) const noexcept {
+        if (index >= count_) {
+            return InitReport();
+        }
+        portENTER_CRITICAL(&lock_);
+        const InitReport report = reports_[index];
+        portEXIT_CRITICAL(&lock_);
+        return report;
+    }
+
+    /**
+     * @brief Number of devices whose last initialization did not succeed
+     */
+    size_t failedCount() const noexcept {
+        size_t failed = 0;
+        portENTER_CRITICAL(&lock_);
+        for (size_t i = 0; i < count_; i++) {
+            if (reports_[i].result != DeviceError::SUCCESS) {
+                failed++;
+            }
+        }
+        portEXIT_CRITICAL(&lock_);
+        return failed;
+    }
+
+    size_t size() const noexcept { return count_; }
+    size_t busGroupCount() const noexcept { return groupCount_; }
+    IDeviceInstance* at(size_t index) const noexcept { return index < count_ ? devices_[index] : nullptr; }
+    DeviceId idAt(size_t index) const noexcept { return index < count_ ? ids_[index] : 0; }
+
+    /**
+     * @brief Device registered under @p id, nullptr if none
+     */
+    IDeviceInstance* find(DeviceId id) const noexcept {
+        const uint8_t index = idIndex_[id];
+        return index != NO_INDEX ? devices_[index] : nullptr;
+    }
+
+    /**
+     * @brief Devices whose capabilities declare @p dataType (bit n = index n)
+     */
+    DeviceMask devicesWith(DeviceDataType dataType) const noexcept {
+        const size_t type = static_cast<size_t>(dataType);
+        return type < IDeviceInstance::NUM_DATA_TYPES ? typeMasks_[type] : 0;
+    }
+
+    /**
+     * @brief Devices registered without a capability descriptor
+     */
+    DeviceMask unknownCapabilities() const noexcept { return unknownMask_; }
+
+    /**
+     * @brief Devices that declare @p dataType or have no descriptor
+     */
+    DeviceMask candidatesFor(DeviceDataType dataType) const noexcept {
+        return devicesWith(dataType) | unknownMask_;
+    }
+
+    /**
+     * @brief First device (in add() order) providing @p dataType, nullptr if none
+     *
+     * Devices declaring the type win; otherwise the first device without a
+     * descriptor is returned, matching IDeviceInstance::supportsDataType().
+     */
+    IDeviceInstance* firstWith(DeviceDataType dataType) const noexcept {
+        DeviceMask mask = devicesWith(dataType);
+        if (mask == 0) {
+            mask = unknownMask_;
+        }
+        return mask != 0 ? devices_[__builtin_ctz(mask)] : nullptr;
+    }
+
+private:
+    static constexpr size_t ID_TABLE_SIZE = 256;
+    static constexpr uint8_t NO_INDEX = 0xFF;
+    static_assert(MAX_DEVICES < NO_INDEX, "device index must fit the ID table");
+    static_assert(MAX_DEVICES <= 32, "DeviceMask holds at most 32 devices");
+
+    struct BusGroup {
+        DeviceRegistry* owner = nullptr;
+        SemaphoreHandle_t bus = nullptr;
+        uint8_t index = 0;
+    };
+
+    static void initTask(void* param) {
+        BusGroup* group = static_cast<BusGroup*>(param);
+        group->owner->runGroup(group->index);
+        vTaskDelete(nullptr);
+    }
+
+    void runGroup(size_t group) {
+        for (size_t i = 0; i < count_; i++) {
+            if (groupOf_[i] != group) {
+                continue;
+            }
+            const int64_t begin = esp_timer_get_time();
+            DeviceError result = DeviceError::TIMEOUT;   // Never start a device after the deadline
+            if (!deadlinePassed()) {
+                auto init = devices_[i]->initialize();
+                if (init.isOk()) {
+                    auto ready = devices_[i]->waitForInitializationComplete(remaining());
+                    result = ready.isOk() ? DeviceError::SUCCESS : ready.error();
+                } else {
+                    result = init.error();
+                }
+            }
+            const int64_t end = esp_timer_get_time();
+            portENTER_CRITICAL(&lock_);
+            reports_[i].result = result;
+            reports_[i].durationUs = static_cast<uint32_t>(end - begin);
+            reports_[i].startOffsetUs = static_cast<uint32_t>(begin - startUs_);
+            portEXIT_CRITICAL(&lock_);
+        }
+        xEventGroupSetBits(doneGroup_, EventBits_t(1) << group);
+        running_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void markGroup(size_t group, DeviceError result) noexcept {
+        portENTER_CRITICAL(&lock_);
+        for (size_t i = 0; i < count_; i++) {
+            if (groupOf_[i] == group) {
+                reports_[i].result = result;
+            }
+        }
+        portEXIT_CRITICAL(&lock_);
+    }
+
+    bool deadlinePassed() const noexcept {
+        return deadline_ != portMAX_DELAY && static_cast<int32_t>(xTaskGetTickCount() - deadline_) >= 0;
+    }
+
+    TickType_t remaining() const noexcept {
+        if (deadline_ == portMAX_DELAY) {
+            return portMAX_DELAY;
+        }
+        const int32_t left = static_cast<int32_t>(deadline_ - xTaskGetTickCount());
+        return left > 0 ? static_cast<TickType_t>(left) : 0;
+    }
+
+    IDeviceInstance* devices_[MAX_DEVICES];
+    DeviceId ids_[MAX_DEVICES];
+    InitReport reports_[MAX_DEVICES];
+    uint8_t groupOf_[MAX_DEVICES];
+    BusGroup groups_[MAX_DEVICES];
+    uint8_t idIndex_[ID_TABLE_SIZE];
+    size_t count_;
+    size_t groupCount_;
+    DeviceMask typeMasks_[IDeviceInstance::NUM_DATA_TYPES];
+    DeviceMask unknownMask_;
+    TickType_t deadline_;
+    int64_t startUs_;
+    std::atomic<size_t> running_;
+    StaticEventGroup_t doneGroupBuffer_;
+    EventGroupHandle_t doneGroup_;
+    mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+};
+
+#endif // DEVICE_REGISTRY_H
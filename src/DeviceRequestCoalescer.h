@@ -0,0 +1,325 @@
+/**
+ * @file DeviceRequestCoalescer.h
+ * @brief Single-flight coalescing of concurrent requestData() calls
+ *
+ * When several tasks (control loop, MQTT, web UI) request data from the
+ * same device within a few milliseconds, only the first call starts a bus
+ * transaction. Later calls join the flight in progress, and every task
+ * blocked in waitForData() is released by the same completion, with no
+ * coordination in the application.
+ *
+ * @code
+ * DeviceResult<void> MB8ART::requestData() {
+ *     const auto flight = flight_.begin();
+ *     if (flight.join != DeviceRequestCoalescer::Join::STARTED) {
+ *         return DeviceResult<void>();             // joined, or served from cache
+ *     }
+ *     auto result = sendReadRequest(flight.id);    // async Modbus request, remembers the id
+ *     if (!result.isOk()) {
+ *         flight_.complete(flight.id, result.error());  // release joiners with the error
+ *     }
+ *     return result;
+ * }
+ *
+ * void MB8ART::onResponse(uint32_t flightId, ...) {  // response handler
+ *     processData();
+ *     flight_.complete(flightId, DeviceError::SUCCESS);
+ * }
+ *
+ * DeviceError MB8ART::waitForData(TickType_t ticks) {
+ *     return flight_.wait(ticks);
+ * }
+ *
+ * DeviceRequestCoalescer* MB8ART::getRequestCoalescer() noexcept {
+ *     return &flight_;                             // getDataFresh() joins flights
+ * }
+ * @endcode
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_REQUEST_COALESCER_H
+#define DEVICE_REQUEST_COALESCER_H
+
+#include "IDeviceInstance.h"
+#include "esp_timer.h"
+#include "freertos/event_groups.h"
+#include "freertos/task.h"
+
+/**
+ * @brief Age after which an uncompleted flight is abandoned (milliseconds)
+ *
+ * Guards against a lost response keeping every later request joined to a
+ * flight that never completes. Override via build flag.
+ */
+#ifndef IDEV_COALESCER_FLIGHT_TIMEOUT_MS
+#define IDEV_COALESCER_FLIGHT_TIMEOUT_MS 2000
+#endif
+
+/**
+ * @class DeviceRequestCoalescer
+ * @brief Flight counter plus completion bit for one device
+ *
+ * Each started flight gets an increasing id. wait() waits for the flight
+ * that is current when it is called: it returns as soon as completedId
+ * reaches that id. It waits on the completion bit, which is set on
+ * complete() and cleared only when the next flight starts, so no waiter
+ * can consume another waiter's wakeup.
+ *
+ * complete() takes the id returned by begin() and ignores ids that are no
+ * longer current, so a late response to an abandoned flight can never
+ * complete its successor.
+ *
+ * The completion bit belongs to the coalescer. Consumers and DevicePoller
+ * must not clear it; register the device with DevicePoller without
+ * dataReadyBits so it uses waitForData(0).
+ *
+ * begin() / complete() / wait() are safe from any task; complete() may be
+ * called from the task that handles the bus response.
+ */
+class DeviceRequestCoalescer {
+public:
+    using DeviceError = IDeviceInstance::DeviceError;
+
+    /**
+     * @brief Outcome of begin()
+     */
+    enum class Join : uint8_t {
+        STARTED,    ///< A new flight started: the caller must issue the bus request
+        JOINED,     ///< A flight was already in progress: nothing to send
+        FRESH       ///< The last completed data is within the freshness bound: nothing to send
+    };
+
+    /**
+     * @brief Result of begin()
+     */
+    struct Flight {
+        Join join;      ///< What the caller has to do
+        uint32_t id;    ///< Flight started or joined; the last completed one for FRESH
+    };
+
+    /**
+     * @param eventGroup Group for the completion bit (usually getEventGroup())
+     * @param doneBit Bit reserved for the coalescer
+     */
+    DeviceRequestCoalescer(EventGroupHandle_t eventGroup, EventBits_t doneBit) noexcept
+        : eventGroup_(eventGroup), doneBit_(doneBit), flightId_(0), completedId_(0),
+          inFlight_(false), starting_(false), lastResult_(DeviceError::DATA_NOT_READY), startUs_(0), completedUs_(0),
+          started_(0), joined_(0), fresh_(0) {}
+
+    DeviceRequestCoalescer(const DeviceRequestCoalescer&) = delete;
+    DeviceRequestCoalescer& operator=(const DeviceRequestCoalescer&) = delete;
+
+    /**
+     * @brief Set the event group after construction (e.g. created in initialize())
+     */
+    void setEventGroup(EventGroupHandle_t eventGroup) noexcept {
+        eventGroup_ = eventGroup;
+    }
+
+    /**
+     * @brief Start or join a flight
+     *
+     * A flight older than IDEV_COALESCER_FLIGHT_TIMEOUT_MS is abandoned
+     * and a new one started.
+     *
+     * @param maxAgeMs If non-zero and the last successful flight completed at
+     *        most this long ago, no flight is started (Join::FRESH)
+     * @return Join::STARTED with the new flight id if the caller must issue
+     *         the request, otherwise JOINED or FRESH
+     */
+    Flight begin(uint32_t maxAgeMs = 0) noexcept {
+        const int64_t now = esp_timer_get_time();
+        portENTER_CRITICAL(&lock_);
+        if (starting_ ||
+            (inFlight_ && now - startUs_ < static_cast<int64_t>(IDEV_COALESCER_FLIGHT_TIMEOUT_MS) * 1000)) {
+            joined_++;
+            const Flight joined{Join::JOINED, flightId_};
+            portEXIT_CRITICAL(&lock_);
+            return joined;
+        }
+        if (maxAgeMs > 0 && !inFlight_ && completedId_ != 0 && lastResult_ == DeviceError::SUCCESS &&
+            now - completedUs_ <= static_cast<int64_t>(maxAgeMs) * 1000) {
+            fresh_++;
+            const Flight fresh{Join::FRESH, completedId_};
+            portEXIT_CRITICAL(&lock_);
+            return fresh;
+        }
+        // New id first: complete() of an abandoned flight is ignored from here on
+        const uint32_t id = ++flightId_;
+        inFlight_ = false;
+        starting_ = true;
+        started_++;
+        portEXIT_CRITICAL(&lock_);
+
+        // Clear the previous completion before the flight becomes visible,
+        // so a fast complete() of this flight cannot be wiped
+        if (eventGroup_ != nullptr) {
+            xEventGroupClearBits(eventGroup_, doneBit_);
+        }
+        portENTER_CRITICAL(&lock_);
+        starting_ = false;
+        inFlight_ = true;
+        startUs_ = now;
+        portEXIT_CRITICAL(&lock_);
+        return Flight{Join::STARTED, id};
+    }
+
+    /**
+     * @brief Finish a flight and release every waiter
+     * @param flightId Id returned by the begin() that started the flight
+     * @param result SUCCESS, or the error the waiters should see
+     * @return false (and nothing changes) if @p flightId is not the flight
+     *         in progress, e.g. a late response to an abandoned flight
+     */
+    bool complete(uint32_t flightId, DeviceError result = DeviceError::SUCCESS) noexcept {
+        portENTER_CRITICAL(&lock_);
+        if (!inFlight_ || flightId != flightId_) {
+            portEXIT_CRITICAL(&lock_);
+            return false;
+        }
+        inFlight_ = false;
+        completedId_ = flightId;
+        lastResult_ = result;
+        completedUs_ = esp_timer_get_time();
+        portEXIT_CRITICAL(&lock_);
+        if (eventGroup_ != nullptr) {
+            xEventGroupSetBits(eventGroup_, doneBit_);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Wait for the current flight (or the last one, if none is in progress)
+     *
+     * @param xTicksToWait Maximum time to wait
+     * @return Result passed to complete(); TIMEOUT if the flight did not
+     *         complete in time; DATA_NOT_READY if no flight was ever started
+     */
+    DeviceError wait(TickType_t xTicksToWait = portMAX_DELAY) noexcept {
+        portENTER_CRITICAL(&lock_);
+        const uint32_t target = flightId_;
+        portEXIT_CRITICAL(&lock_);
+        if (target == 0) {
+            return DeviceError::DATA_NOT_READY;
+        }
+
+        const TickType_t start = xTaskGetTickCount();
+        for (;;) {
+            portENTER_CRITICAL(&lock_);
+            const bool done = static_cast<int32_t>(completedId_ - target) >= 0;
+            const DeviceError result = lastResult_;
+            portEXIT_CRITICAL(&lock_);
+            if (done) {
+                return result;
+            }
+            if (eventGroup_ == nullptr) {
+                return DeviceError::NOT_INITIALIZED;
+            }
+
+            TickType_t remaining = portMAX_DELAY;
+            if (xTicksToWait != portMAX_DELAY) {
+                const TickType_t elapsed = xTaskGetTickCount() - start;
+                if (elapsed >= xTicksToWait) {
+                    return DeviceError::TIMEOUT;
+                }
+                remaining = xTicksToWait - elapsed;
+            }
+            // Never clear the bit here: other waiters share the same completion
+            xEventGroupWaitBits(eventGroup_, doneBit_, pdFALSE, pdTRUE, remaining);
+        }
+    }
+
+    /**
+     * @brief Check whether a flight is in progress
+     */
+    bool inFlight() const noexcept {
+        portENTER_CRITICAL(&lock_);
+        const bool active = inFlight_ || starting_;
+        portEXIT_CRITICAL(&lock_);
+        return active;
+    }
+
+    /**
+     * @brief Microseconds since the last successful completion (-1 if none)
+     */
+    int64_t ageUs() const noexcept {
+        portENTER_CRITICAL(&lock_);
+        const int64_t completed = completedId_ != 0 && lastResult_ == DeviceError::SUCCESS ? completedUs_ : -1;
+        portEXIT_CRITICAL(&lock_);
+        return completed < 0 ? -1 : esp_timer_get_time() - completed;
+    }
+
+    uint32_t startedCount() const noexcept { return started_; }   ///< Flights that issued a bus request
+    uint32_t joinedCount() const noexcept { return joined_; }     ///< Requests that joined a flight
+    uint32_t freshCount() const noexcept { return fresh_; }       ///< Requests served from fresh data
+
+private:
+    EventGroupHandle_t eventGroup_;
+    EventBits_t doneBit_;
+    uint32_t flightId_;
+    uint32_t completedId_;
+    bool inFlight_;
+    bool starting_;             // Id taken, completion bit still being cleared
+    DeviceError lastResult_;
+    int64_t startUs_;
+    int64_t completedUs_;
+    uint32_t started_;
+    uint32_t joined_;
+    uint32_t fresh_;
+    mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+};
+
+// Default IDeviceInstance::getDataFresh() - needs the complete DeviceRequestCoalescer
+inline IDeviceInstance::DeviceResult<IDeviceInstance::ChannelValues>
+IDeviceInstance::getDataFresh(DeviceDataType dataType, uint32_t maxAgeMs, TickType_t timeout, DataStamp* stamp) {
+    if (maxAgeMs > 0) {
+        DataStamp current;
+        auto cached = readWithStamp(dataType, &current);
+        if (cached.isOk() && current.generation != 0 &&
+            esp_timer_get_time() - current.timestampUs <= static_cast<int64_t>(maxAgeMs) * 1000) {
+            if (stamp != nullptr) {
+                *stamp = current;
+            }
+            return cached;
+        }
+    }
+
+    const TickType_t start = xTaskGetTickCount();
+    DeviceRequestCoalescer* flight = getRequestCoalescer();
+    if (flight == nullptr || !flight->inFlight()) {
+        auto request = requestData();
+        if (!request.isOk()) {
+            return DeviceResult<ChannelValues>(request.error());
+        }
+    }
+    TickType_t remaining = timeout;
+    if (timeout != portMAX_DELAY) {
+        const TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= timeout) {
+            return DeviceResult<ChannelValues>(DeviceError::TIMEOUT);
+        }
+        remaining = timeout - elapsed;
+    }
+
+    if (flight != nullptr) {
+        // The response handler processed the flight's data
+        const DeviceError waited = flight->wait(remaining);
+        if (waited != DeviceError::SUCCESS) {
+            return DeviceResult<ChannelValues>(waited);
+        }
+    } else {
+        const DeviceError waited = waitForData(remaining);
+        if (waited != DeviceError::SUCCESS) {
+            return DeviceResult<ChannelValues>(waited);
+        }
+        auto processed = processData();
+        if (!processed.isOk()) {
+            return DeviceResult<ChannelValues>(processed.error());
+        }
+    }
+    return readWithStamp(dataType, stamp);
+}
+
+#endif // DEVICE_REQUEST_COALESCER_H
@@ -0,0 +1,120 @@
+/**
+ * @file DeviceSeqLock.h
+ * @brief Sequence lock for lock-free publication of cached device data
+ *
+ * A single published value guarded by a sequence counter. Writers (usually
+ * processData()) publish a complete copy; readers copy it out without taking
+ * any mutex and retry if a publish raced with the copy.
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_SEQLOCK_H
+#define DEVICE_SEQLOCK_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief Busy retries of DeviceSeqLock::read() before it yields between attempts
+ *
+ * Override via build flag. A retry only happens while a publish is in
+ * progress, which takes a few hundred cycles at most, so the reader
+ * normally succeeds while still spinning.
+ */
+#ifndef IDEV_SEQLOCK_SPINS_BEFORE_YIELD
+#define IDEV_SEQLOCK_SPINS_BEFORE_YIELD 16
+#endif
+
+/**
+ * @class DeviceSeqLock
+ * @brief Lock-free single-value publication channel
+ * @tparam T Published type (must be trivially copyable)
+ *
+ * - publish(): task context only. The copy runs inside a short critical
+ *   section so a writer is never preempted mid-update and readers on the
+ *   other core spin for at most one copy.
+ * - read(): never takes a FreeRTOS mutex and never fails. It retries
+ *   until it gets a consistent copy, spinning first and then yielding
+ *   between attempts, so it waits at most for the copy of a writer on the
+ *   other core. Safe from any task on any core.
+ *
+ * version() counts completed publishes and doubles as a generation number.
+ */
+template<typename T>
+class DeviceSeqLock {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "DeviceSeqLock requires a trivially copyable type");
+public:
+    DeviceSeqLock() noexcept : sequence_(0), value_() {}
+
+    DeviceSeqLock(const DeviceSeqLock&) = delete;
+    DeviceSeqLock& operator=(const DeviceSeqLock&) = delete;
+
+    /**
+     * @brief Publish a new value
+     * @param value The value to publish
+     * @note Multiple writers are serialized by the internal spinlock
+     */
+    void publish(const T& value) noexcept {
+        portENTER_CRITICAL(&writerLock_);
+        const uint32_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&value_, &value, sizeof(T));
+        sequence_.store(seq + 2, std::memory_order_release);
+        portEXIT_CRITICAL(&writerLock_);
+    }
+
+    /**
+     * @brief Copy out the most recently published value
+     * @param out Destination for the value (a value-initialized T before the first publish)
+     * @param version Optional - receives the version of the copied value
+     * @return true if a value has been published, false if @p out holds the initial value
+     */
+    bool read(T& out, uint32_t* version = nullptr) const noexcept {
+        for (uint32_t attempt = 0;; attempt++) {
+            if (attempt >= IDEV_SEQLOCK_SPINS_BEFORE_YIELD) {
+                taskYIELD();
+            }
+            const uint32_t before = sequence_.load(std::memory_order_acquire);
+            if ((before & 1u) != 0) {
+                continue;  // Publish in progress
+            }
+            std::memcpy(&out, &value_, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) {
+                if (version != nullptr) {
+                    *version = before >> 1;
+                }
+                return before != 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Number of completed publishes (0 = nothing published yet)
+     */
+    uint32_t version() const noexcept {
+        return sequence_.load(std::memory_order_acquire) >> 1;
+    }
+
+    /**
+     * @brief Check whether a value has ever been published
+     */
+    bool hasValue() const noexcept {
+        return version() != 0;
+    }
+
+private:
+    std::atomic<uint32_t> sequence_;
+    T value_;
+    portMUX_TYPE writerLock_ = portMUX_INITIALIZER_UNLOCKED;
+};
+
+#endif // DEVICE_SEQLOCK_H
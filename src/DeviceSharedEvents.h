@@ -0,0 +1,278 @@
+/**
+ * @file DeviceSharedEvents.h
+ * @brief One event group shared by many devices, with waitForAnyData()
+ *
+ * Each device's own getEventGroup() forces a consumer that wants "the first
+ * of these 6 devices with new data" to poll or run a task per device.
+ * DeviceSharedEvents owns one statically allocated event group and assigns
+ * every attached device a DATA_READY and an ERROR bit; drivers set those
+ * bits in addition to their own. The aggregation task then blocks once.
+ *
+ * @code
+ * DeviceSharedEvents events;
+ * events.add(&mb8art);
+ * events.add(&ds18b20);
+ *
+ * IDeviceInstance* const inputs[] = {&mb8art, &ds18b20};
+ * for (;;) {
+ *     auto ready = events.waitForAnyData(inputs, 2, pdMS_TO_TICKS(1000));
+ *     if (ready.isOk() && ready.value().hasData(0)) { ... mb8art ... }
+ * }
+ * @endcode
+ *
+ * Driver side (DeviceSharedEventBinding):
+ * @code
+ * DeviceResult<void> attachSharedEventGroup(EventGroupHandle_t g, EventBits_t data, EventBits_t error) override {
+ *     return shared_.attach(g, data, error);
+ * }
+ * // On new data / on failure:
+ * shared_.signalData();
+ * shared_.signalError();
+ * @endcode
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_SHARED_EVENTS_H
+#define DEVICE_SHARED_EVENTS_H
+
+#include "IDeviceInstance.h"
+#include "freertos/event_groups.h"
+
+/**
+ * @brief Usable bits of an EventBits_t (FreeRTOS reserves the top 8 of 32)
+ */
+#ifndef IDEV_SHARED_EVENT_BITS
+#define IDEV_SHARED_EVENT_BITS 24
+#endif
+
+/**
+ * @class DeviceSharedEventBinding
+ * @brief Driver-side state for IDeviceInstance::attachSharedEventGroup()
+ *
+ * signalData() / signalError() are no-ops while not attached.
+ */
+class DeviceSharedEventBinding {
+public:
+    using DeviceError = IDeviceInstance::DeviceError;
+    template<typename T>
+    using DeviceResult = IDeviceInstance::DeviceResult<T>;
+
+    DeviceSharedEventBinding() noexcept : group_(nullptr), dataBit_(0), errorBit_(0) {}
+
+    /**
+     * @brief Attach to a shared group, or detach with a nullptr group
+     * @return INVALID_PARAMETER if the bits are zero or overlap
+     */
+    DeviceResult<void> attach(EventGroupHandle_t group, EventBits_t dataBit, EventBits_t errorBit) noexcept {
+        if (group == nullptr) {
+            group_ = nullptr;
+            dataBit_ = 0;
+            errorBit_ = 0;
+            return DeviceResult<void>();
+        }
+        if (dataBit == 0 || errorBit == 0 || (dataBit & errorBit) != 0) {
+            return DeviceResult<void>(DeviceError::INVALID_PARAMETER);
+        }
+        dataBit_ = dataBit;
+        errorBit_ = errorBit;
+        group_ = group;
+        return DeviceResult<void>();
+    }
+
+    bool isAttached() const noexcept { return group_ != nullptr; }
+
+    void signalData() const noexcept {
+        if (group_ != nullptr) {
+            xEventGroupSetBits(group_, dataBit_);
+        }
+    }
+
+    void signalError() const noexcept {
+        if (group_ != nullptr) {
+            xEventGroupSetBits(group_, errorBit_);
+        }
+    }
+
+private:
+    EventGroupHandle_t volatile group_;
+    EventBits_t dataBit_;
+    EventBits_t errorBit_;
+};
+
+/**
+ * @class DeviceSharedEvents
+ * @brief Shared event group with per-device DATA_READY / ERROR bits
+ *
+ * Device slot i uses data bit 2i and error bit 2i+1, so up to
+ * MAX_DEVICES (12 with 24 usable bits) devices share one group.
+ *
+ * - add(): setup time, calls attachSharedEventGroup() on the device
+ * - waitForAnyData() / waitForAny(): one consumer task; bits that are
+ *   reported are cleared
+ *
+ * @note Attached devices must outlive this object (the destructor detaches them)
+ */
+class DeviceSharedEvents {
+public:
+    using DeviceError = IDeviceInstance::DeviceError;
+    template<typename T>
+    using DeviceResult = IDeviceInstance::DeviceResult<T>;
+
+    static constexpr size_t MAX_DEVICES = IDEV_SHARED_EVENT_BITS / 2;
+    static_assert(MAX_DEVICES <= 32, "ReadySet masks hold at most 32 devices");
+
+    /**
+     * @brief Devices that signalled, as bit masks (bit n = n-th element of the
+     *        queried list, or slot n for waitForAny())
+     */
+    struct ReadySet {
+        uint32_t data;      ///< Devices with new data
+        uint32_t errors;    ///< Devices that reported an error
+
+        bool any() const noexcept { return (data | errors) != 0; }
+        bool hasData(size_t index) const noexcept { return (data >> index) & 1u; }
+        bool hasError(size_t index) const noexcept { return (errors >> index) & 1u; }
+    };
+
+    DeviceSharedEvents() noexcept : group_(xEventGroupCreateStatic(&groupBuffer_)), devices_(), count_(0) {}
+
+    /**
+     * @brief Detaches every device, then deletes the group
+     */
+    ~DeviceSharedEvents() {
+        for (size_t i = 0; i < count_; i++) {
+            devices_[i]->attachSharedEventGroup(nullptr, 0, 0);
+        }
+        vEventGroupDelete(group_);
+    }
+
+    DeviceSharedEvents(const DeviceSharedEvents&) = delete;
+    DeviceSharedEvents& operator=(const DeviceSharedEvents&) = delete;
+
+    /**
+     * @brief Attach a device and assign its bits
+     *
+     * @param device Device to attach
+     * @return INVALID_PARAMETER if null, MEMORY_ERROR if MAX_DEVICES are
+     *         attached, or the error of attachSharedEventGroup()
+     *         (NOT_SUPPORTED if the driver has no shared mode)
+     */
+    DeviceResult<void> add(IDeviceInstance* device) {
+        if (device == nullptr) {
+            return DeviceResult<void>(DeviceError::INVALID_PARAMETER);
+        }
+        if (slotOf(device) < count_) {
+            return DeviceResult<void>();
+        }
+        if (count_ >= MAX_DEVICES) {
+            return DeviceResult<void>(DeviceError::MEMORY_ERROR);
+        }
+        auto result = device->attachSharedEventGroup(group_, dataBit(count_), errorBit(count_));
+        if (!result.isOk()) {
+            return result;
+        }
+        xEventGroupClearBits(group_, dataBit(count_) | errorBit(count_));
+        devices_[count_++] = device;
+        return DeviceResult<void>();
+    }
+
+    size_t size() const noexcept { return count_; }
+    IDeviceInstance* device(size_t slot) const noexcept { return slot < count_ ? devices_[slot] : nullptr; }
+    EventGroupHandle_t getEventGroup() const noexcept { return group_; }
+
+    /**
+     * @brief Slot of an attached device (size() if not attached)
+     */
+    size_t slotOf(const IDeviceInstance* device) const noexcept {
+        for (size_t i = 0; i < count_; i++) {
+            if (devices_[i] == device) {
+                return i;
+            }
+        }
+        return count_;
+    }
+
+    static constexpr EventBits_t dataBit(size_t slot) noexcept { return EventBits_t(1) << (2 * slot); }
+    static constexpr EventBits_t errorBit(size_t slot) noexcept { return EventBits_t(1) << (2 * slot + 1); }
+
+    /**
+     * @brief Block until any of the listed devices has data or an error
+     *
+     * @param devices Devices to wait for (all must be attached)
+     * @param count Number of entries in @p devices (at most 32)
+     * @param xTicksToWait Maximum time to wait
+     * @return ReadySet indexed by position in @p devices; TIMEOUT if nothing
+     *         was signalled, INVALID_PARAMETER for an unattached device
+     *
+     * @note Only the bits of the listed devices are consumed
+     */
+    DeviceResult<ReadySet> waitForAnyData(IDeviceInstance* const* devices, size_t count, TickType_t xTicksToWait) {
+        if (devices == nullptr || count == 0 || count > 32) {
+            return DeviceResult<ReadySet>(DeviceError::INVALID_PARAMETER);
+        }
+        size_t slots[32];
+        EventBits_t waitBits = 0;
+        for (size_t i = 0; i < count; i++) {
+            slots[i] = slotOf(devices[i]);
+            if (slots[i] >= count_) {
+                return DeviceResult<ReadySet>(DeviceError::INVALID_PARAMETER);
+            }
+            waitBits |= dataBit(slots[i]) | errorBit(slots[i]);
+        }
+
+        const EventBits_t bits = waitAndTake(waitBits, xTicksToWait);
+        ReadySet ready{0, 0};
+        for (size_t i = 0; i < count; i++) {
+            if ((bits & dataBit(slots[i])) != 0) {
+                ready.data |= uint32_t(1) << i;
+            }
+            if ((bits & errorBit(slots[i])) != 0) {
+                ready.errors |= uint32_t(1) << i;
+            }
+        }
+        return ready.any() ? DeviceResult<ReadySet>(ready) : DeviceResult<ReadySet>(DeviceError::TIMEOUT);
+    }
+
+    /**
+     * @brief Block until any attached device has data or an error
+     * @return ReadySet indexed by slot; TIMEOUT if nothing was signalled
+     */
+    DeviceResult<ReadySet> waitForAny(TickType_t xTicksToWait) {
+        if (count_ == 0) {
+            return DeviceResult<ReadySet>(DeviceError::INVALID_PARAMETER);
+        }
+        const EventBits_t all = count_ >= MAX_DEVICES
+                                    ? static_cast<EventBits_t>((uint64_t(1) << IDEV_SHARED_EVENT_BITS) - 1)
+                                    : static_cast<EventBits_t>((EventBits_t(1) << (2 * count_)) - 1);
+        const EventBits_t bits = waitAndTake(all, xTicksToWait);
+        ReadySet ready{0, 0};
+        for (size_t slot = 0; slot < count_; slot++) {
+            if ((bits & dataBit(slot)) != 0) {
+                ready.data |= uint32_t(1) << slot;
+            }
+            if ((bits & errorBit(slot)) != 0) {
+                ready.errors |= uint32_t(1) << slot;
+            }
+        }
+        return ready.any() ? DeviceResult<ReadySet>(ready) : DeviceResult<ReadySet>(DeviceError::TIMEOUT);
+    }
+
+private:
+    // Wait for any of @p bits; the bits that are set on return are cleared
+    EventBits_t waitAndTake(EventBits_t bits, TickType_t xTicksToWait) {
+        const EventBits_t set = xEventGroupWaitBits(group_, bits, pdFALSE, pdFALSE, xTicksToWait) & bits;
+        if (set != 0) {
+            xEventGroupClearBits(group_, set);
+        }
+        return set;
+    }
+
+    StaticEventGroup_t groupBuffer_;
+    EventGroupHandle_t group_;
+    IDeviceInstance* devices_[MAX_DEVICES];
+    size_t count_;
+};
+
+#endif // DEVICE_SHARED_EVENTS_H
@@ -0,0 +1,246 @@
+/**
+ * @file DeviceStateBlob.h
+ * @brief CRC-protected driver state for fast initialization after deep sleep
+ *
+ * A driver that has probed its hardware (Modbus address scan, sensor type
+ * detection, per-channel scaling) serializes the validated result into a
+ * DeviceStateBlob through IDeviceInstance::saveState(). On the next wake
+ * the application hands the blob back through restoreState() before
+ * initialize(), which can then skip re-discovery. The blob lives in RTC
+ * slow memory (kept across deep sleep, zero after power-on) or in NVS.
+ *
+ * @code
+ * RTC_DATA_ATTR static DeviceStateBlob mb8artState;   // survives deep sleep
+ *
+ * if (esp_reset_reason() == ESP_RST_DEEPSLEEP) {
+ *     mb8art.restoreState(mb8artState);                // rejected if stale or corrupt
+ * }
+ * mb8art.initialize();                                 // fast path if restored
+ * ...
+ * mb8art.saveState(mb8artState);
+ * esp_deep_sleep_start();
+ * @endcode
+ *
+ * Driver side:
+ * @code
+ * struct Persisted { uint8_t address; uint8_t sensorType[8]; int16_t divider[8]; };
+ * static constexpr uint32_t STATE_TAG = DeviceStateBlob::makeTag('M', 'B', '8', 'A');
+ *
+ * DeviceResult<void> saveState(DeviceStateBlob& blob) const override {
+ *     return blob.store(STATE_TAG, 1, persisted_) ? DeviceResult<void>()
+ *                                                 : DeviceResult<void>(DeviceError::MEMORY_ERROR);
+ * }
+ * DeviceResult<void> restoreState(const DeviceStateBlob& blob) override {
+ *     if (!blob.load(STATE_TAG, 1, persisted_)) {
+ *         return DeviceResult<void>(DeviceError::INVALID_PARAMETER);
+ *     }
+ *     warmStart_ = true;                               // initialize() skips probing
+ *     return DeviceResult<void>();
+ * }
+ * @endcode
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_STATE_BLOB_H
+#define DEVICE_STATE_BLOB_H
+
+#include "esp_rom_crc.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief Payload capacity of one blob in bytes
+ *
+ * Sized for an 8-channel driver; override via build flag for larger state.
+ */
+#ifndef IDEV_STATE_BLOB_CAPACITY
+#define IDEV_STATE_BLOB_CAPACITY 64
+#endif
+
+/**
+ * @brief Build the NVS save/load helpers (requires nvs.h)
+ */
+#ifndef IDEV_STATE_BLOB_NVS
+#define IDEV_STATE_BLOB_NVS 0
+#endif
+
+#if IDEV_STATE_BLOB_NVS
+#include "nvs.h"
+#endif
+
+/**
+ * @class DeviceStateBlob
+ * @brief Fixed-size, trivially copyable state record with tag, version and CRC-32
+ *
+ * The tag identifies the driver, the version its payload layout; load()
+ * accepts a blob only if magic, tag, version, length and CRC all match.
+ * Uninitialized or zeroed memory never validates.
+ */
+class DeviceStateBlob {
+public:
+    static constexpr size_t CAPACITY = IDEV_STATE_BLOB_CAPACITY;
+    static constexpr uint32_t MAGIC = 0x42534449;     ///< "IDSB"
+    static_assert(CAPACITY <= 0xFFFF, "payload length is 16-bit");
+
+    /**
+     * @brief Four-character driver tag
+     */
+    static constexpr uint32_t makeTag(char a, char b, char c, char d) noexcept {
+        return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+               (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+               (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) |
+               (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+    }
+
+    constexpr DeviceStateBlob() noexcept : header_{0, 0, 0, 0, 0}, payload_() {}
+
+    /**
+     * @brief Replace the content and seal it with a CRC
+     *
+     * @param tag Driver tag (see makeTag())
+     * @param version Payload layout version
+     * @param data Payload bytes
+     * @param length Payload size (at most CAPACITY)
+     * @return false if the payload does not fit (the blob is then invalid)
+     */
+    bool store(uint32_t tag, uint16_t version, const void* data, size_t length) noexcept {
+        if (length > CAPACITY || (data == nullptr && length > 0)) {
+            invalidate();
+            return false;
+        }
+        header_.tag = tag;
+        header_.version = version;
+        header_.length = static_cast<uint16_t>(length);
+        if (length > 0) {
+            std::memcpy(payload_, data, length);
+        }
+        std::memset(payload_ + length, 0, CAPACITY - length);
+        header_.crc = computeCrc();
+        header_.magic = MAGIC;
+        return true;
+    }
+
+    /**
+     * @brief Store a trivially copyable state struct
+     */
+    template<typename T>
+    bool store(uint32_t tag, uint16_t version, const T& state) noexcept {
+        static_assert(std::is_trivially_copyable<T>::value, "state must be trivially copyable");
+        static_assert(sizeof(T) <= CAPACITY, "state exceeds IDEV_STATE_BLOB_CAPACITY");
+        return store(tag, version, &state, sizeof(T));
+    }
+
+    /**
+     * @brief Copy the payload out if the blob is valid for @p tag / @p version
+     *
+     * @param out Destination buffer
+     * @param capacity Size of @p out
+     * @return Payload size, or 0 if the blob does not validate or does not fit
+     */
+    size_t load(uint32_t tag, uint16_t version, void* out, size_t capacity) const noexcept {
+        if (!matches(tag, version) || header_.length > capacity || out == nullptr) {
+            return 0;
+        }
+        std::memcpy(out, payload_, header_.length);
+        return header_.length;
+    }
+
+    /**
+     * @brief Load a state struct; the stored size must equal sizeof(T)
+     * @return false (and @p state unchanged) if the blob does not validate
+     */
+    template<typename T>
+    bool load(uint32_t tag, uint16_t version, T& state) const noexcept {
+        static_assert(std::is_trivially_copyable<T>::value, "state must be trivially copyable");
+        if (!matches(tag, version) || header_.length != sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&state, payload_, sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief Check magic, length and CRC
+     */
+    bool isValid() const noexcept {
+        return header_.magic == MAGIC && header_.length <= CAPACITY && header_.crc == computeCrc();
+    }
+
+    /**
+     * @brief Check that the blob is valid and belongs to @p tag / @p version
+     */
+    bool matches(uint32_t tag, uint16_t version) const noexcept {
+        return header_.tag == tag && header_.version == version && isValid();
+    }
+
+    /**
+     * @brief Make the blob fail validation (e.g. after a configuration change)
+     */
+    void invalidate() noexcept {
+        header_.magic = 0;
+    }
+
+    uint32_t tag() const noexcept { return header_.tag; }
+    uint16_t version() const noexcept { return header_.version; }
+    size_t payloadSize() const noexcept { return header_.length; }
+    const uint8_t* payload() const noexcept { return payload_; }
+
+    /**
+     * @brief Bytes that must be persisted (header plus used payload)
+     */
+    size_t storedSize() const noexcept {
+        return sizeof(Header) + (header_.length <= CAPACITY ? header_.length : CAPACITY);
+    }
+
+#if IDEV_STATE_BLOB_NVS
+    /**
+     * @brief Write the used part of the blob to NVS and commit
+     * @return ESP_OK or the NVS error
+     */
+    esp_err_t saveToNvs(nvs_handle_t handle, const char* key) const {
+        esp_err_t err = nvs_set_blob(handle, key, this, storedSize());
+        return err == ESP_OK ? nvs_commit(handle) : err;
+    }
+
+    /**
+     * @brief Read a blob written by saveToNvs(); invalid on any error
+     * @return ESP_OK or the NVS error (ESP_ERR_NVS_NOT_FOUND on first boot)
+     */
+    esp_err_t loadFromNvs(nvs_handle_t handle, const char* key) {
+        invalidate();
+        size_t length = sizeof(*this);
+        esp_err_t err = nvs_get_blob(handle, key, this, &length);
+        if (err != ESP_OK || length < sizeof(Header)) {
+            invalidate();
+        }
+        return err;
+    }
+#endif
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t tag;
+        uint16_t version;
+        uint16_t length;
+        uint32_t crc;
+    };
+    static_assert(sizeof(Header) == 16, "header must be unpadded");
+
+    // CRC over tag, version, length and the used payload
+    uint32_t computeCrc() const noexcept {
+        const size_t length = header_.length <= CAPACITY ? header_.length : CAPACITY;
+        uint32_t crc = esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&header_.tag),
+                                        sizeof(header_.tag) + sizeof(header_.version) + sizeof(header_.length));
+        return esp_rom_crc32_le(crc, payload_, static_cast<uint32_t>(length));
+    }
+
+    Header header_;
+    uint8_t payload_[CAPACITY];
+};
+
+#endif // DEVICE_STATE_BLOB_H
@@ -0,0 +1,153 @@
+/**
+ * @file DeviceStaticSync.h
+ * @brief Heap-free mutexes and event group for IDeviceInstance drivers
+ *
+ * DeviceStaticSync owns the StaticSemaphore_t / StaticEventGroup_t storage
+ * and creates the primitives with the ...Static() FreeRTOS APIs, so a
+ * driver needs no heap at construction and its synchronization objects sit
+ * at a fixed place inside the driver object. WithStaticSync<Base> adds the
+ * getMutexInstance() / getMutexInterface() / getEventGroup() overrides on
+ * top of any IDeviceInstance base.
+ *
+ * @code
+ * static DeviceStaticMutex rs485Mutex;                  // shared by every device on the bus
+ *
+ * class MB8ART : public WithStaticSync<IDeviceInstance> {
+ * public:
+ *     MB8ART() { shareInterfaceMutex(rs485Mutex.handle()); }
+ *     // getMutexInstance(), getMutexInterface(), getEventGroup() are provided
+ * };
+ *
+ * class FastSensor : public WithStaticSync<DeviceInstanceBase<FastSensor>> { ... };
+ * @endcode
+ *
+ * @note Requires configSUPPORT_STATIC_ALLOCATION (enabled in ESP-IDF)
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_STATIC_SYNC_H
+#define DEVICE_STATIC_SYNC_H
+
+#include "IDeviceInstance.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+
+/**
+ * @class DeviceStaticMutex
+ * @brief One statically allocated mutex, e.g. the interface mutex of a shared bus
+ */
+class DeviceStaticMutex {
+public:
+    DeviceStaticMutex() noexcept : handle_(xSemaphoreCreateMutexStatic(&buffer_)) {}
+
+    ~DeviceStaticMutex() {
+        vSemaphoreDelete(handle_);
+    }
+
+    DeviceStaticMutex(const DeviceStaticMutex&) = delete;
+    DeviceStaticMutex& operator=(const DeviceStaticMutex&) = delete;
+
+    SemaphoreHandle_t handle() const noexcept { return handle_; }
+
+private:
+    StaticSemaphore_t buffer_;
+    SemaphoreHandle_t handle_;
+};
+
+/**
+ * @class DeviceStaticSync
+ * @brief Instance mutex, interface mutex and event group without heap allocation
+ *
+ * The interface mutex can be replaced by a shared one (all devices on one
+ * bus must report the same getMutexInterface()); the own interface mutex
+ * is then simply unused.
+ */
+class DeviceStaticSync {
+public:
+    DeviceStaticSync() noexcept
+        : instanceMutex_(xSemaphoreCreateMutexStatic(&instanceBuffer_)),
+          ownInterfaceMutex_(xSemaphoreCreateMutexStatic(&interfaceBuffer_)),
+          interfaceMutex_(ownInterfaceMutex_),
+          eventGroup_(xEventGroupCreateStatic(&eventGroupBuffer_)) {}
+
+    /**
+     * @note Deleting statically created objects only unregisters them
+     */
+    ~DeviceStaticSync() {
+        vSemaphoreDelete(instanceMutex_);
+        vSemaphoreDelete(ownInterfaceMutex_);
+        vEventGroupDelete(eventGroup_);
+    }
+
+    DeviceStaticSync(const DeviceStaticSync&) = delete;
+    DeviceStaticSync& operator=(const DeviceStaticSync&) = delete;
+
+    SemaphoreHandle_t instanceMutex() const noexcept { return instanceMutex_; }
+    SemaphoreHandle_t interfaceMutex() const noexcept { return interfaceMutex_; }
+    EventGroupHandle_t eventGroup() const noexcept { return eventGroup_; }
+
+    /**
+     * @brief Use a shared interface mutex instead of the own one
+     * @param mutex Shared mutex (must outlive this object), nullptr to revert
+     * @note Call during setup, before any task uses the device
+     */
+    void shareInterfaceMutex(SemaphoreHandle_t mutex) noexcept {
+        interfaceMutex_ = mutex != nullptr ? mutex : ownInterfaceMutex_;
+    }
+
+private:
+    StaticSemaphore_t instanceBuffer_;
+    StaticSemaphore_t interfaceBuffer_;
+    StaticEventGroup_t eventGroupBuffer_;
+    SemaphoreHandle_t instanceMutex_;
+    SemaphoreHandle_t ownInterfaceMutex_;
+    SemaphoreHandle_t interfaceMutex_;
+    EventGroupHandle_t eventGroup_;
+};
+
+/**
+ * @class WithStaticSync
+ * @brief Mixin implementing the synchronization getters from a DeviceStaticSync
+ * @tparam Base IDeviceInstance or a class derived from it (e.g. DeviceInstanceBase<Derived>)
+ *
+ * Constructors of @p Base are inherited.
+ *
+ * @note The primitives are created after @p Base is constructed: a Base
+ *       constructor must not use getMutexInstance() / getEventGroup()
+ */
+template<typename Base>
+class WithStaticSync : public Base {
+    static_assert(std::is_base_of<IDeviceInstance, Base>::value,
+                  "WithStaticSync requires an IDeviceInstance base");
+public:
+    using Base::Base;
+
+    SemaphoreHandle_t getMutexInstance() const noexcept override {
+        return sync_.instanceMutex();
+    }
+
+    SemaphoreHandle_t getMutexInterface() const noexcept override {
+        return sync_.interfaceMutex();
+    }
+
+    EventGroupHandle_t getEventGroup() const noexcept override {
+        return sync_.eventGroup();
+    }
+
+protected:
+    /**
+     * @brief Use the shared bus mutex as interface mutex (see DeviceStaticSync)
+     */
+    void shareInterfaceMutex(SemaphoreHandle_t mutex) noexcept {
+        sync_.shareInterfaceMutex(mutex);
+    }
+
+    DeviceStaticSync& staticSync() noexcept { return sync_; }
+
+private:
+    DeviceStaticSync sync_;
+};
+
+#endif // DEVICE_STATIC_SYNC_H
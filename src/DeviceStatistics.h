@@ -0,0 +1,312 @@
+/**
+ * @file DeviceStatistics.h
+ * @brief Per-device performance counters and latency histograms
+ *
+ * Drivers embed one DeviceStatistics, call the inline helpers at the right
+ * points (request start, data ready, processData(), mutex takes) and expose
+ * it through IDeviceInstance::getStatistics(). Every helper is a handful of
+ * instructions so the counters can stay enabled in production.
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_STATISTICS_H
+#define DEVICE_STATISTICS_H
+
+#include "IDeviceInstance.h"
+#include "esp_timer.h"
+#include <atomic>
+
+/**
+ * @class LatencyHistogram
+ * @brief Fixed-bucket latency histogram in microseconds
+ *
+ * Buckets are bounded by bucketUpperUs() (100 us ... 1 s, plus overflow);
+ * recording is one short critical section, no allocation.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t NUM_BUCKETS = 12;
+
+    LatencyHistogram() noexcept : buckets_(), count_(0), sumUs_(0), maxUs_(0) {}
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Upper bound (exclusive) of a bucket in microseconds
+     * @return UINT32_MAX for the overflow bucket
+     */
+    static constexpr uint32_t bucketUpperUs(size_t bucket) noexcept {
+        return bucket == 0  ? 100u :
+               bucket == 1  ? 250u :
+               bucket == 2  ? 500u :
+               bucket == 3  ? 1000u :
+               bucket == 4  ? 2500u :
+               bucket == 5  ? 5000u :
+               bucket == 6  ? 10000u :
+               bucket == 7  ? 25000u :
+               bucket == 8  ? 50000u :
+               bucket == 9  ? 100000u :
+               bucket == 10 ? 1000000u : UINT32_MAX;
+    }
+
+    /**
+     * @brief Record one sample
+     * @param us Latency in microseconds
+     */
+    void record(uint32_t us) noexcept {
+        size_t bucket = 0;
+        while (bucket < NUM_BUCKETS - 1 && us >= bucketUpperUs(bucket)) {
+            bucket++;
+        }
+        portENTER_CRITICAL(&lock_);
+        buckets_[bucket]++;
+        count_++;
+        sumUs_ += us;
+        if (us > maxUs_) {
+            maxUs_ = us;
+        }
+        portEXIT_CRITICAL(&lock_);
+    }
+
+    uint32_t bucket(size_t index) const noexcept {
+        return index < NUM_BUCKETS ? buckets_[index] : 0;
+    }
+
+    uint32_t count() const noexcept { return count_; }
+    uint32_t maxUs() const noexcept { return maxUs_; }
+
+    uint32_t meanUs() const noexcept {
+        portENTER_CRITICAL(&lock_);
+        const uint64_t sum = sumUs_;
+        const uint32_t count = count_;
+        portEXIT_CRITICAL(&lock_);
+        return count > 0 ? static_cast<uint32_t>(sum / count) : 0;
+    }
+
+    /**
+     * @brief Approximate percentile (upper bound of the bucket containing it)
+     * @param percent 0-100
+     * @return Bucket upper bound in us (capped at maxUs()), 0 if empty
+     */
+    uint32_t percentileUs(uint8_t percent) const noexcept {
+        uint32_t snapshot[NUM_BUCKETS];
+        uint32_t count;
+        uint32_t maxUs;
+        portENTER_CRITICAL(&lock_);
+        for (size_t i = 0; i < NUM_BUCKETS; i++) {
+            snapshot[i] = buckets_[i];
+        }
+        count = count_;
+        maxUs = maxUs_;
+        portEXIT_CRITICAL(&lock_);
+        if (count == 0) {
+            return 0;
+        }
+        const uint64_t target = (static_cast<uint64_t>(count) * (percent > 100 ? 100 : percent) + 99) / 100;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < NUM_BUCKETS - 1; i++) {
+            seen += snapshot[i];
+            if (seen >= target && seen > 0) {
+                return bucketUpperUs(i) < maxUs ? bucketUpperUs(i) : maxUs;
+            }
+        }
+        return maxUs;
+    }
+
+    void reset() noexcept {
+        portENTER_CRITICAL(&lock_);
+        for (auto& b : buckets_) {
+            b = 0;
+        }
+        count_ = 0;
+        sumUs_ = 0;
+        maxUs_ = 0;
+        portEXIT_CRITICAL(&lock_);
+    }
+
+private:
+    uint32_t buckets_[NUM_BUCKETS];
+    uint32_t count_;
+    uint64_t sumUs_;
+    uint32_t maxUs_;
+    mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+};
+
+/**
+ * @class DeviceStatistics
+ * @brief Standard counters for one IDeviceInstance
+ *
+ * requestLatency ends where the response arrives (the handler that sets
+ * the data-ready bit), so processData() time is not part of it. Drivers
+ * with several requests in flight keep the token returned by
+ * beginRequest() with each request and pass it to markDataReady().
+ *
+ * @code
+ * DeviceResult<void> MB8ART::requestData() {
+ *     pending_.statsToken = stats.beginRequest();
+ *     ...
+ * }
+ * void MB8ART::onResponse(const ModbusFrame& frame) {   // bus/response task
+ *     stats.markDataReady(pending_.statsToken);
+ *     xEventGroupSetBits(eventGroup, DATA_READY_BIT);
+ * }
+ * DeviceResult<void> MB8ART::processData() {
+ *     DeviceStatistics::ScopedLatency timer(stats.processLatency);
+ *     if (!stats.takeInstanceMutex(mutexInstance, pdMS_TO_TICKS(100))) {
+ *         stats.recordResult(DeviceError::MUTEX_ERROR);
+ *         ...
+ *     }
+ *     ...
+ *     stats.recordResult(DeviceError::SUCCESS);
+ * }
+ * const DeviceStatistics* getStatistics() const noexcept override { return &stats; }
+ * @endcode
+ */
+class DeviceStatistics {
+public:
+    using DeviceError = IDeviceInstance::DeviceError;
+
+    static constexpr size_t NUM_ERRORS = static_cast<size_t>(DeviceError::UNKNOWN_ERROR) + 1;
+
+    LatencyHistogram requestLatency;        ///< requestData() -> data ready
+    LatencyHistogram processLatency;        ///< processData() duration
+    LatencyHistogram instanceMutexWait;     ///< getMutexInstance() wait time
+    LatencyHistogram interfaceMutexWait;    ///< getMutexInterface() wait time
+
+    DeviceStatistics() noexcept : requests_(0), results_(), requestStartUs_(0) {}
+
+    DeviceStatistics(const DeviceStatistics&) = delete;
+    DeviceStatistics& operator=(const DeviceStatistics&) = delete;
+
+    /**
+     * @brief Count a request and remember its start time
+     * @return Start token of this request for markDataReady(uint32_t)
+     */
+    uint32_t beginRequest() noexcept {
+        const uint32_t start = nowUs();
+        requests_.fetch_add(1, std::memory_order_relaxed);
+        requestStartUs_.store(start, std::memory_order_relaxed);
+        return start;
+    }
+
+    /**
+     * @brief Record request -> data-ready latency of one request
+     * @param startToken Value returned by the request's beginRequest()
+     */
+    void markDataReady(uint32_t startToken) noexcept {
+        requestLatency.record(nowUs() - startToken);
+    }
+
+    /**
+     * @brief Record request -> data-ready latency of the last beginRequest()
+     * @note Only correct with at most one request in flight; overlapping
+     *       requests must use markDataReady(uint32_t)
+     */
+    void markDataReady() noexcept {
+        markDataReady(requestStartUs_.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Count the outcome of an operation
+     * @param result SUCCESS or the failure
+     */
+    void recordResult(DeviceError result) noexcept {
+        const auto index = static_cast<size_t>(result);
+        results_[index < NUM_ERRORS ? index : NUM_ERRORS - 1].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Take the instance mutex and record the wait time
+     * @return true if the mutex was obtained
+     */
+    bool takeInstanceMutex(SemaphoreHandle_t mutex, TickType_t timeout) noexcept {
+        return timedTake(mutex, timeout, instanceMutexWait);
+    }
+
+    /**
+     * @brief Take the interface mutex and record the wait time
+     * @return true if the mutex was obtained
+     */
+    bool takeInterfaceMutex(SemaphoreHandle_t mutex, TickType_t timeout) noexcept {
+        return timedTake(mutex, timeout, interfaceMutexWait);
+    }
+
+    /**
+     * @brief Take a mutex, recording the wait into @p histogram
+     * @return true if the mutex was obtained
+     */
+    static bool timedTake(SemaphoreHandle_t mutex, TickType_t timeout, LatencyHistogram& histogram) noexcept {
+        const uint32_t start = nowUs();
+        const bool taken = xSemaphoreTake(mutex, timeout) == pdTRUE;
+        histogram.record(nowUs() - start);
+        return taken;
+    }
+
+    /**
+     * @brief RAII timer recording its lifetime into a histogram
+     */
+    class ScopedLatency {
+    public:
+        explicit ScopedLatency(LatencyHistogram& histogram) noexcept
+            : histogram_(histogram), start_(nowUs()) {}
+        ~ScopedLatency() { histogram_.record(nowUs() - start_); }
+        ScopedLatency(const ScopedLatency&) = delete;
+        ScopedLatency& operator=(const ScopedLatency&) = delete;
+    private:
+        LatencyHistogram& histogram_;
+        uint32_t start_;
+    };
+
+    uint32_t requestCount() const noexcept {
+        return requests_.load(std::memory_order_relaxed);
+    }
+
+    uint32_t successCount() const noexcept {
+        return resultCount(DeviceError::SUCCESS);
+    }
+
+    /**
+     * @brief Number of recorded results with the given error code
+     */
+    uint32_t resultCount(DeviceError error) const noexcept {
+        const auto index = static_cast<size_t>(error);
+        return index < NUM_ERRORS ? results_[index].load(std::memory_order_relaxed) : 0;
+    }
+
+    /**
+     * @brief Number of recorded failures (all non-SUCCESS results)
+     */
+    uint32_t errorCount() const noexcept {
+        uint32_t total = 0;
+        for (size_t i = 1; i < NUM_ERRORS; i++) {
+            total += results_[i].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    void reset() noexcept {
+        requests_.store(0, std::memory_order_relaxed);
+        for (auto& r : results_) {
+            r.store(0, std::memory_order_relaxed);
+        }
+        requestLatency.reset();
+        processLatency.reset();
+        instanceMutexWait.reset();
+        interfaceMutexWait.reset();
+    }
+
+private:
+    // 32-bit microsecond clock; differences stay valid across wrap-around
+    static uint32_t nowUs() noexcept {
+        return static_cast<uint32_t>(esp_timer_get_time());
+    }
+
+    std::atomic<uint32_t> requests_;
+    std::atomic<uint32_t> results_[NUM_ERRORS];
+    std::atomic<uint32_t> requestStartUs_;
+};
+
+#endif // DEVICE_STATISTICS_H
@@ -0,0 +1,541 @@
+/**
+ * @file DeviceTelemetryCodec.h
+ * @brief Compact, allocation-free binary telemetry frames for many devices
+ *
+ * The encoder reads raw int16 values and scale dividers straight from
+ * getDataRawInto() / getDataScaleDivider() and writes one frame for all
+ * registered devices into a caller buffer: no floats, no JSON, no heap.
+ * Values are delta-encoded against the previous frame as zigzag varints,
+ * so unchanged channels cost one byte. Periodic key frames carry absolute
+ * values and resynchronize a decoder that missed a message.
+ *
+ * @code
+ * DeviceTelemetryEncoder telemetry;              // key frame every IDEV_TELEMETRY_KEYFRAME_INTERVAL
+ * telemetry.add(&mb8art, 0x01);
+ * telemetry.add(&andrtf3, 0x02, IDeviceInstance::dataTypeBit(DeviceDataType::TEMPERATURE));
+ *
+ * uint8_t payload[128];
+ * auto frame = telemetry.encode(payload, sizeof(payload));
+ * if (frame.isOk()) {
+ *     esp_mqtt_client_publish(client, "boiler/t", (const char*)payload, frame.value(), 0, 0);
+ * }
+ * @endcode
+ *
+ * Frame layout (varint = LEB128, zvarint = zigzag varint):
+ * @verbatim
+ * Frame  := MAGIC(0xD7) VERSION(1) flags(u8, bit0 = key frame) sequence(varint) devices(u8) Device*
+ * Device := id(u8) types(varint DataTypeMask) Type*        ; ascending DeviceDataType
+ * Type   := channels(varint) divSpec(u8) [dividers] value*
+ * divSpec: 0 = same dividers as the previous frame (delta frames only)
+ *          1 = one zvarint divider for every channel
+ *          2 = channels x zvarint divider
+ * value  := zvarint(raw - previous raw); the previous raw is 0 in key frames
+ *           and whenever the channel count changed
+ * @endverbatim
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_TELEMETRY_CODEC_H
+#define DEVICE_TELEMETRY_CODEC_H
+
+#include "IDeviceInstance.h"
+
+/**
+ * @brief Maximum devices per frame (encoder) and tracked devices (decoder)
+ */
+#ifndef IDEV_TELEMETRY_MAX_DEVICES
+#define IDEV_TELEMETRY_MAX_DEVICES 8
+#endif
+
+/**
+ * @brief Frames between two key frames (1 = key frames only)
+ */
+#ifndef IDEV_TELEMETRY_KEYFRAME_INTERVAL
+#define IDEV_TELEMETRY_KEYFRAME_INTERVAL 30
+#endif
+
+/**
+ * @class DeviceTelemetryFormat
+ * @brief Constants, varint helpers and the delta reference shared by encoder and decoder
+ */
+class DeviceTelemetryFormat {
+public:
+    using DeviceDataType = IDeviceInstance::DeviceDataType;
+    using DeviceError = IDeviceInstance::DeviceError;
+    using DataTypeMask = IDeviceInstance::DataTypeMask;
+    template<typename T>
+    using DeviceResult = IDeviceInstance::DeviceResult<T>;
+
+    static constexpr uint8_t MAGIC = 0xD7;
+    static constexpr uint8_t VERSION = 1;
+    static constexpr uint8_t FLAG_KEY_FRAME = 0x01;
+    static constexpr size_t MAX_DEVICES = IDEV_TELEMETRY_MAX_DEVICES;
+    static constexpr size_t MAX_CHANNELS = IDeviceInstance::MAX_CHANNELS;
+    static constexpr size_t NUM_DATA_TYPES = IDeviceInstance::NUM_DATA_TYPES;
+    static_assert(MAX_DEVICES <= 255, "device count is one byte");
+    static_assert(MAX_CHANNELS <= 255, "channel count is tracked in one byte");
+
+    enum DividerSpec : uint8_t {
+        DIVIDERS_UNCHANGED = 0,
+        DIVIDERS_COMMON = 1,
+        DIVIDERS_PER_CHANNEL = 2
+    };
+
+    static uint32_t zigzag(int32_t value) noexcept {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+
+    static int32_t unzigzag(uint32_t value) noexcept {
+        return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+    }
+
+    /**
+     * @brief Bounded byte writer; sticks at overflow so callers check once
+     */
+    class Writer {
+    public:
+        Writer(uint8_t* out, size_t capacity) noexcept : out_(out), capacity_(capacity), size_(0), overflow_(false) {}
+
+        void byte(uint8_t value) noexcept {
+            if (size_ < capacity_) {
+                out_[size_++] = value;
+            } else {
+                overflow_ = true;
+            }
+        }
+
+        void varint(uint32_t value) noexcept {
+            while (value >= 0x80) {
+                byte(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            byte(static_cast<uint8_t>(value));
+        }
+
+        void zvarint(int32_t value) noexcept { varint(zigzag(value)); }
+
+        size_t size() const noexcept { return size_; }
+        bool overflow() const noexcept { return overflow_; }
+
+    private:
+        uint8_t* out_;
+        size_t capacity_;
+        size_t size_;
+        bool overflow_;
+    };
+
+    /**
+     * @brief Bounded byte reader; every accessor fails past the end
+     */
+    class Reader {
+    public:
+        Reader(const uint8_t* in, size_t length) noexcept : in_(in), length_(length), pos_(0) {}
+
+        bool byte(uint8_t& value) noexcept {
+            if (pos_ >= length_) {
+                return false;
+            }
+            value = in_[pos_++];
+            return true;
+        }
+
+        bool varint(uint32_t& value) noexcept {
+            value = 0;
+            for (unsigned shift = 0; shift < 35; shift += 7) {
+                uint8_t b;
+                if (!byte(b)) {
+                    return false;
+                }
+                value |= static_cast<uint32_t>(b & 0x7F) << shift;
+                if ((b & 0x80) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool zvarint(int32_t& value) noexcept {
+            uint32_t raw;
+            if (!varint(raw)) {
+                return false;
+            }
+            value = unzigzag(raw);
+            return true;
+        }
+
+        bool atEnd() const noexcept { return pos_ == length_; }
+
+    private:
+        const uint8_t* in_;
+        size_t length_;
+        size_t pos_;
+    };
+
+protected:
+    // Values of one data type as last sent/received (count 0 = none)
+    struct TypeReference {
+        uint8_t count = 0;
+        int16_t raw[MAX_CHANNELS] = {};
+        int16_t divider[MAX_CHANNELS] = {};
+    };
+
+    struct DeviceReference {
+        TypeReference types[NUM_DATA_TYPES];
+
+        void reset() noexcept {
+            for (auto& type : types) {
+                type.count = 0;
+            }
+        }
+    };
+
+    static int16_t clampRaw(int32_t value) noexcept {
+        return static_cast<int16_t>(value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value));
+    }
+};
+
+/**
+ * @class DeviceTelemetryEncoder
+ * @brief Batches several devices into one delta-encoded frame
+ *
+ * add() at setup time; encode() from one task. About 130 bytes of
+ * reference state per device (8 channels), no heap.
+ */
+class DeviceTelemetryEncoder : public DeviceTelemetryFormat {
+public:
+    explicit DeviceTelemetryEncoder(uint16_t keyFrameInterval = IDEV_TELEMETRY_KEYFRAME_INTERVAL) noexcept
+        : entries_(), count_(0), keyFrameInterval_(keyFrameInterval > 0 ? keyFrameInterval : 1),
+          sinceKeyFrame_(0), sequence_(0), needKeyFrame_(true) {}
+
+    DeviceTelemetryEncoder(const DeviceTelemetryEncoder&) = delete;
+    DeviceTelemetryEncoder& operator=(const DeviceTelemetryEncoder&) = delete;
+
+    /**
+     * @brief Add a device to every frame
+     *
+     * @param device Device to encode
+     * @param id Device ID written into the frame (unique per encoder)
+     * @param types Data types to include; types not in getCapabilities()
+     *        are skipped when the driver declares capabilities
+     * @return SUCCESS, INVALID_PARAMETER for a null device or a duplicate
+     *         ID, MEMORY_ERROR if full
+     * @note Forces the next frame to be a key frame
+     */
+    DeviceError add(IDeviceInstance* device, uint8_t id,
+                    DataTypeMask types = IDeviceInstance::ALL_DATA_TYPES) noexcept {
+        if (device == nullptr) {
+            return DeviceError::INVALID_PARAMETER;
+        }
+        for (size_t i = 0; i < count_; i++) {
+            if (entries_[i].id == id) {
+                return DeviceError::INVALID_PARAMETER;
+            }
+        }
+        if (count_ >= MAX_DEVICES) {
+            return DeviceError::MEMORY_ERROR;
+        }
+        const IDeviceInstance::DeviceCapabilities& caps = device->getCapabilities();
+        const DataTypeMask declared = caps.isDeclared() ? caps.supportedTypes : IDeviceInstance::ALL_DATA_TYPES;
+        Entry& entry = entries_[count_++];
+        entry.device = device;
+        entry.id = id;
+        entry.types = types & declared & IDeviceInstance::ALL_DATA_TYPES;
+        entry.reference.reset();
+        needKeyFrame_ = true;
+        return DeviceError::SUCCESS;
+    }
+
+    /**
+     * @brief Make the next frame a key frame (e.g. after a reconnect)
+     */
+    void forceKeyFrame() noexcept {
+        needKeyFrame_ = true;
+    }
+
+    /**
+     * @brief Read every device and write one frame
+     *
+     * Types whose read fails (DATA_NOT_READY, NOT_SUPPORTED, ...) are left
+     * out of the frame; the decoder keeps their previous values.
+     *
+     * @param out Destination buffer
+     * @param capacity Size of @p out
+     * @return Frame size in bytes; MEMORY_ERROR if it does not fit (the
+     *         next frame is then a key frame); INVALID_PARAMETER for a null buffer
+     */
+    DeviceResult<size_t> encode(uint8_t* out, size_t capacity) {
+        if (out == nullptr) {
+            return DeviceResult<size_t>(DeviceError::INVALID_PARAMETER);
+        }
+        const bool key = needKeyFrame_ || sinceKeyFrame_ + 1 >= keyFrameInterval_;
+        Writer writer(out, capacity);
+        writer.byte(MAGIC);
+        writer.byte(VERSION);
+        writer.byte(key ? FLAG_KEY_FRAME : 0);
+        writer.varint(sequence_);
+        writer.byte(static_cast<uint8_t>(count_));
+
+        for (size_t i = 0; i < count_; i++) {
+            encodeDevice(entries_[i], key, writer);
+        }
+
+        if (writer.overflow()) {
+            needKeyFrame_ = true;   // References already advanced past the lost frame
+            return DeviceResult<size_t>(DeviceError::MEMORY_ERROR);
+        }
+        sequence_++;
+        sinceKeyFrame_ = key ? 0 : sinceKeyFrame_ + 1;
+        needKeyFrame_ = false;
+        return DeviceResult<size_t>(writer.size());
+    }
+
+    size_t size() const noexcept { return count_; }
+    uint32_t sequence() const noexcept { return sequence_; }   ///< Sequence number of the next frame
+
+private:
+    struct Entry {
+        IDeviceInstance* device = nullptr;
+        uint8_t id = 0;
+        DataTypeMask types = 0;
+        DeviceReference reference;
+    };
+
+    void encodeDevice(Entry& entry, bool key, Writer& writer) {
+        int16_t raw[NUM_DATA_TYPES][MAX_CHANNELS];
+        uint8_t counts[NUM_DATA_TYPES] = {};
+        DataTypeMask present = 0;
+        for (size_t type = 0; type < NUM_DATA_TYPES; type++) {
+            const auto dataType = static_cast<DeviceDataType>(type);
+            if ((entry.types & IDeviceInstance::dataTypeBit(dataType)) == 0) {
+                continue;
+            }
+            auto result = entry.device->getDataRawInto(dataType, raw[type], MAX_CHANNELS);
+            if (result.isOk() && result.value() > 0) {
+                counts[type] = static_cast<uint8_t>(result.value());
+                present |= IDeviceInstance::dataTypeBit(dataType);
+            }
+        }
+
+        writer.byte(entry.id);
+        writer.varint(present);
+        for (size_t type = 0; type < NUM_DATA_TYPES; type++) {
+            if (counts[type] == 0) {
+                if (key) {
+                    entry.reference.types[type].count = 0;   // The decoder resets on key frames too
+                }
+                continue;
+            }
+            const auto dataType = static_cast<DeviceDataType>(type);
+            const uint8_t count = counts[type];
+            TypeReference& ref = entry.reference.types[type];
+            const bool delta = !key && ref.count == count;
+
+            int16_t dividers[MAX_CHANNELS];
+            bool common = true;
+            bool unchanged = delta;
+            for (uint8_t ch = 0; ch < count; ch++) {
+                dividers[ch] = entry.device->getDataScaleDivider(dataType, ch);
+                common = common && dividers[ch] == dividers[0];
+                unchanged = unchanged && dividers[ch] == ref.divider[ch];
+            }
+
+            writer.varint(count);
+            if (unchanged) {
+                writer.byte(DIVIDERS_UNCHANGED);
+            } else if (common) {
+                writer.byte(DIVIDERS_COMMON);
+                writer.zvarint(dividers[0]);
+            } else {
+                writer.byte(DIVIDERS_PER_CHANNEL);
+                for (uint8_t ch = 0; ch < count; ch++) {
+                    writer.zvarint(dividers[ch]);
+                }
+            }
+            for (uint8_t ch = 0; ch < count; ch++) {
+                const int32_t base = delta ? ref.raw[ch] : 0;
+                writer.zvarint(static_cast<int32_t>(raw[type][ch]) - base);
+                ref.raw[ch] = raw[type][ch];
+                ref.divider[ch] = dividers[ch];
+            }
+            ref.count = count;
+        }
+    }
+
+    Entry entries_[MAX_DEVICES];
+    size_t count_;
+    uint16_t keyFrameInterval_;
+    uint16_t sinceKeyFrame_;
+    uint32_t sequence_;
+    bool needKeyFrame_;
+};
+
+/**
+ * @class DeviceTelemetryDecoder
+ * @brief Rebuilds readings from DeviceTelemetryEncoder frames
+ *
+ * Delta frames are only applied on top of the frame with the preceding
+ * sequence number; after a gap every frame is rejected with DATA_NOT_READY
+ * until the next key frame.
+ */
+class DeviceTelemetryDecoder : public DeviceTelemetryFormat {
+public:
+    /**
+     * @brief Receives one decoded data type
+     * @param context User context passed to decode()
+     * @param deviceId ID given to DeviceTelemetryEncoder::add()
+     * @param dataType The data type
+     * @param values Decoded readings (raw plus divider)
+     * @param count Number of channels
+     */
+    using ValueFn = void (*)(void* context, uint8_t deviceId, DeviceDataType dataType,
+                             const ScaledValue* values, size_t count);
+
+    DeviceTelemetryDecoder() noexcept : devices_(), count_(0), nextSequence_(0), synced_(false) {}
+
+    DeviceTelemetryDecoder(const DeviceTelemetryDecoder&) = delete;
+    DeviceTelemetryDecoder& operator=(const DeviceTelemetryDecoder&) = delete;
+
+    /**
+     * @brief Decode one frame
+     *
+     * @param in Frame bytes
+     * @param length Frame size
+     * @param onValues Called once per decoded data type (may be nullptr)
+     * @param context Passed to @p onValues
+     * @return Number of devices in the frame; INVALID_PARAMETER for a
+     *         malformed frame; DATA_NOT_READY for a delta frame without its
+     *         predecessor; MEMORY_ERROR if more than MAX_DEVICES IDs appear
+     *
+     * @note A malformed frame also drops synchronization; @p onValues may
+     *       have been called for the devices before the defect
+     */
+    DeviceResult<size_t> decode(const uint8_t* in, size_t length, ValueFn onValues = nullptr,
+                                void* context = nullptr) {
+        Reader reader(in, in != nullptr ? length : 0);
+        uint8_t magic, version, flags, devices;
+        uint32_t sequence;
+        if (!reader.byte(magic) || !reader.byte(version) || !reader.byte(flags) ||
+            !reader.varint(sequence) || !reader.byte(devices) || magic != MAGIC || version != VERSION) {
+            return DeviceResult<size_t>(DeviceError::INVALID_PARAMETER);
+        }
+        const bool key = (flags & FLAG_KEY_FRAME) != 0;
+        if (!key && (!synced_ || sequence != nextSequence_)) {
+            synced_ = false;
+            return DeviceResult<size_t>(DeviceError::DATA_NOT_READY);
+        }
+        if (key) {
+            for (size_t i = 0; i < count_; i++) {
+                devices_[i].reference.reset();
+            }
+        }
+
+        for (uint8_t d = 0; d < devices; d++) {
+            const DeviceError error = decodeDevice(reader, key, onValues, context);
+            if (error != DeviceError::SUCCESS) {
+                synced_ = false;
+                return DeviceResult<size_t>(error);
+            }
+        }
+        if (!reader.atEnd()) {
+            synced_ = false;
+            return DeviceResult<size_t>(DeviceError::INVALID_PARAMETER);
+        }
+        synced_ = true;
+        nextSequence_ = sequence + 1;
+        return DeviceResult<size_t>(static_cast<size_t>(devices));
+    }
+
+    bool isSynced() const noexcept { return synced_; }
+
+private:
+    struct Tracked {
+        uint8_t id = 0;
+        DeviceReference reference;
+    };
+
+    DeviceError decodeDevice(Reader& reader, bool key, ValueFn onValues, void* context) {
+        uint8_t id;
+        uint32_t present;
+        if (!reader.byte(id) || !reader.varint(present) || (present & ~IDeviceInstance::ALL_DATA_TYPES) != 0) {
+            return DeviceError::INVALID_PARAMETER;
+        }
+        Tracked* tracked = find(id);
+        if (tracked == nullptr) {
+            if (count_ >= MAX_DEVICES) {
+                return DeviceError::MEMORY_ERROR;
+            }
+            tracked = &devices_[count_++];
+            tracked->id = id;
+            tracked->reference.reset();
+        }
+
+        for (size_t type = 0; type < NUM_DATA_TYPES; type++) {
+            const auto dataType = static_cast<DeviceDataType>(type);
+            if ((present & IDeviceInstance::dataTypeBit(dataType)) == 0) {
+                continue;
+            }
+            uint32_t count;
+            uint8_t spec;
+            if (!reader.varint(count) || count == 0 || count > MAX_CHANNELS || !reader.byte(spec)) {
+                return DeviceError::INVALID_PARAMETER;
+            }
+            TypeReference& ref = tracked->reference.types[type];
+            const bool delta = !key && ref.count == count;
+
+            int16_t dividers[MAX_CHANNELS];
+            if (spec == DIVIDERS_UNCHANGED) {
+                if (!delta) {
+                    return DeviceError::INVALID_PARAMETER;
+                }
+                for (uint32_t ch = 0; ch < count; ch++) {
+                    dividers[ch] = ref.divider[ch];
+                }
+            } else if (spec == DIVIDERS_COMMON || spec == DIVIDERS_PER_CHANNEL) {
+                for (uint32_t ch = 0; ch < count; ch++) {
+                    int32_t divider = 0;
+                    if ((spec == DIVIDERS_PER_CHANNEL || ch == 0) && !reader.zvarint(divider)) {
+                        return DeviceError::INVALID_PARAMETER;
+                    }
+                    dividers[ch] = spec == DIVIDERS_COMMON && ch > 0 ? dividers[0] : clampRaw(divider);
+                }
+            } else {
+                return DeviceError::INVALID_PARAMETER;
+            }
+
+            ScaledValue values[MAX_CHANNELS];
+            for (uint32_t ch = 0; ch < count; ch++) {
+                int32_t diff;
+                if (!reader.zvarint(diff)) {
+                    return DeviceError::INVALID_PARAMETER;
+                }
+                const int32_t base = delta ? ref.raw[ch] : 0;
+                ref.raw[ch] = clampRaw(base + diff);
+                ref.divider[ch] = dividers[ch];
+                values[ch] = ScaledValue(ref.raw[ch], dividers[ch]);
+            }
+            ref.count = static_cast<uint8_t>(count);
+            if (onValues != nullptr) {
+                onValues(context, id, dataType, values, count);
+            }
+        }
+        return DeviceError::SUCCESS;
+    }
+
+    Tracked* find(uint8_t id) noexcept {
+        for (size_t i = 0; i < count_; i++) {
+            if (devices_[i].id == id) {
+                return &devices_[i];
+            }
+        }
+        return nullptr;
+    }
+
+    Tracked devices_[MAX_DEVICES];
+    size_t count_;
+    uint32_t nextSequence_;
+    bool synced_;
+};
+
+#endif // DEVICE_TELEMETRY_CODEC_H
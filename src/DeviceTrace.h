@@ -0,0 +1,398 @@
+/**
+ * @file DeviceTrace.h
+ * @brief Microsecond span recorder with per-core lock-free ring buffers
+ *
+ * Scoped spans are timed with esp_timer_get_time() and written into a
+ * fixed-size ring per core: recording is a handful of stores and one atomic
+ * increment, never logs and never allocates, so it can stay enabled in the
+ * field. The buffers are dumped on demand as compact binary records or as
+ * Chrome trace JSON (chrome://tracing, Perfetto).
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef DEVICE_TRACE_H
+#define DEVICE_TRACE_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+
+/**
+ * @brief Events kept per core (must be a power of two)
+ */
+#ifndef IDEV_TRACE_BUFFER_EVENTS
+#define IDEV_TRACE_BUFFER_EVENTS 256
+#endif
+
+/**
+ * @class DeviceTrace
+ * @brief Process-wide trace recorder
+ *
+ * @code
+ * DeviceResult<void> MB8ART::requestData() {
+ *     IDEV_TRACE_SCOPE_ARG("mb8art.request", address);
+ *     ...
+ * }
+ *
+ * // Later, e.g. from a console command
+ * DeviceTrace::instance().writeChromeTrace(
+ *     [](void*, const char* data, size_t len) { fwrite(data, 1, len, stdout); }, nullptr);
+ * @endcode
+ *
+ * @note Span names must be string literals (or otherwise outlive the trace);
+ *       only the pointer is stored
+ * @note A ring overwrites its oldest events; a writer preempted for longer
+ *       than a full ring wrap may lose its event
+ */
+class DeviceTrace {
+public:
+    static constexpr size_t BUFFER_EVENTS = IDEV_TRACE_BUFFER_EVENTS;
+    static_assert(BUFFER_EVENTS >= 2 && (BUFFER_EVENTS & (BUFFER_EVENTS - 1)) == 0,
+                  "IDEV_TRACE_BUFFER_EVENTS must be a power of two");
+
+    static constexpr size_t NUM_CORES = portNUM_PROCESSORS;
+
+    /**
+     * @brief One completed span
+     */
+    struct Event {
+        const char* name;       ///< Span name (static string)
+        uint32_t startUs;       ///< Start, low 32 bits of esp_timer_get_time()
+        uint32_t durationUs;    ///< Duration in microseconds
+        uint32_t arg;           ///< User value (device address, job id, ...)
+        uint8_t core;           ///< Core that recorded the span
+    };
+
+    /**
+     * @brief Binary dump record (little-endian, 20 bytes)
+     *
+     * nameAddr is the address of the span name; resolve it against the
+     * firmware ELF on the host.
+     */
+    struct __attribute__((packed)) BinaryRecord {
+        uint32_t nameAddr;
+        uint32_t startUs;
+        uint32_t durationUs;
+        uint32_t arg;
+        uint32_t core;
+    };
+
+    /// Magic at the start of a binary dump ("IDTR")
+    static constexpr uint32_t BINARY_MAGIC = 0x52544449;
+    static constexpr uint16_t BINARY_VERSION = 1;
+
+    /**
+     * @brief Binary dump header, followed by @c count BinaryRecords
+     */
+    struct __attribute__((packed)) BinaryHeader {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t recordSize;
+        uint32_t count;
+    };
+
+    /**
+     * @brief Sink for dump output
+     */
+    using WriteFn = void (*)(void* context, const char* data, size_t length);
+
+    /**
+     * @note constexpr so that the library-wide instance is constant-initialized
+     */
+    constexpr DeviceTrace() noexcept : enabled_(true), rings_() {}
+
+    DeviceTrace(const DeviceTrace&) = delete;
+    DeviceTrace& operator=(const DeviceTrace&) = delete;
+
+    /**
+     * @brief Library-wide trace recorder
+     *
+     * A constant-initialized namespace-scope object: no guard variable and
+     * no lock on first use, so spans may be recorded from ISRs and before
+     * static constructors have run.
+     */
+    static DeviceTrace& instance() noexcept;
+
+    /**
+     * @brief Current time for span timestamps
+     */
+    static uint32_t nowUs() noexcept {
+        return static_cast<uint32_t>(esp_timer_get_time());
+    }
+
+    /**
+     * @brief Enable or disable recording at runtime (enabled by default)
+     */
+    void setEnabled(bool enabled) noexcept {
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool isEnabled() const noexcept {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Record a completed span into the calling core's ring
+     *
+     * @param name Span name (static string)
+     * @param startUs Start time from nowUs()
+     * @param durationUs Duration in microseconds
+     * @param arg Optional user value
+     * @note Lock-free; safe from tasks and ISRs
+     */
+    void record(const char* name, uint32_t startUs, uint32_t durationUs, uint32_t arg = 0) noexcept {
+        if (!enabled_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        const size_t core = currentCore();
+        Ring& ring = rings_[core];
+        const uint32_t index = ring.head.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = ring.slots[index & MASK];
+
+        // Per-slot sequence: 0 while writing, index + 1 once complete
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.event.name = name;
+        slot.event.startUs = startUs;
+        slot.event.durationUs = durationUs;
+        slot.event.arg = arg;
+        slot.event.core = static_cast<uint8_t>(core);
+        slot.sequence.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief RAII span recorded on destruction
+     */
+    class Span {
+    public:
+        explicit Span(const char* name, uint32_t arg = 0) noexcept
+            : name_(name), arg_(arg), startUs_(nowUs()) {}
+        ~Span() {
+            DeviceTrace::instance().record(name_, startUs_, nowUs() - startUs_, arg_);
+        }
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+    private:
+        const char* name_;
+        uint32_t arg_;
+        uint32_t startUs_;
+    };
+
+    /**
+     * @brief Copy the buffered events, oldest first per core
+     *
+     * Slots being written concurrently are skipped.
+     *
+     * @param out Destination array
+     * @param capacity Size of @p out
+     * @return Number of events copied
+     */
+    size_t snapshot(Event* out, size_t capacity) const noexcept {
+        size_t count = 0;
+        for (size_t core = 0; core < NUM_CORES; core++) {
+            count += snapshotCore(core, out + count, capacity - count);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Stream all buffered events as binary records
+     *
+     * Writes a BinaryHeader followed by BinaryRecords. Events are copied one
+     * at a time, so no buffer is needed.
+     *
+     * @return Number of records written
+     */
+    size_t writeBinary(WriteFn write, void* context) const {
+        const size_t count = forEachEvent(nullptr, nullptr);
+        BinaryHeader header{BINARY_MAGIC, BINARY_VERSION, static_cast<uint16_t>(sizeof(BinaryRecord)),
+                            static_cast<uint32_t>(count)};
+        write(context, reinterpret_cast<const char*>(&header), sizeof(header));
+        Sink sink{write, context, 0, count};
+        forEachEvent(&DeviceTrace::emitBinary, &sink);
+        // Pad with zeroed records if events were overwritten between passes
+        BinaryRecord empty{};
+        for (; sink.written < count; sink.written++) {
+            write(context, reinterpret_cast<const char*>(&empty), sizeof(empty));
+        }
+        return count;
+    }
+
+    /**
+     * @brief Stream all buffered events as Chrome trace JSON
+     *
+     * Complete ("X") events with the core as thread id; load the output in
+     * chrome://tracing or ui.perfetto.dev.
+     *
+     * @return Number of events written
+     */
+    size_t writeChromeTrace(WriteFn write, void* context) const {
+        static const char prologue[] = "{\"traceEvents\":[";
+        static const char epilogue[] = "]}\n";
+        write(context, prologue, sizeof(prologue) - 1);
+        Sink sink{write, context, 0, SIZE_MAX};
+        forEachEvent(&DeviceTrace::emitChrome, &sink);
+        write(context, epilogue, sizeof(epilogue) - 1);
+        return sink.written;
+    }
+
+    /**
+     * @brief Discard all buffered events
+     * @note Not synchronized with concurrent record() calls
+     */
+    void clear() noexcept {
+        for (auto& ring : rings_) {
+            for (auto& slot : ring.slots) {
+                slot.sequence.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Total spans recorded since boot (including overwritten ones)
+     */
+    uint32_t recordedCount() const noexcept {
+        uint32_t total = 0;
+        for (const auto& ring : rings_) {
+            total += ring.head.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    static constexpr uint32_t MASK = static_cast<uint32_t>(BUFFER_EVENTS - 1);
+
+    struct Slot {
+        std::atomic<uint32_t> sequence{0};
+        Event event{};
+    };
+
+    struct Ring {
+        std::atomic<uint32_t> head{0};
+        Slot slots[BUFFER_EVENTS];
+    };
+
+    struct Sink {
+        WriteFn write;
+        void* context;
+        size_t written;
+        size_t limit;
+    };
+
+    using EventFn = void (*)(Sink* sink, const Event& event);
+
+    static size_t currentCore() noexcept {
+#if portNUM_PROCESSORS > 1
+        const BaseType_t core = xPortGetCoreID();
+        return core >= 0 && static_cast<size_t>(core) < NUM_CORES ? static_cast<size_t>(core) : 0;
+#else
+        return 0;
+#endif
+    }
+
+    bool readSlot(const Ring& ring, uint32_t index, Event& out) const noexcept {
+        const Slot& slot = ring.slots[index & MASK];
+        const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before != index + 1) {
+            return false;  // Empty, being written, or already overwritten
+        }
+        out = slot.event;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.sequence.load(std::memory_order_relaxed) == before;
+    }
+
+    size_t snapshotCore(size_t core, Event* out, size_t capacity) const noexcept {
+        const Ring& ring = rings_[core];
+        const uint32_t head = ring.head.load(std::memory_order_acquire);
+        const uint32_t first = head > BUFFER_EVENTS ? head - static_cast<uint32_t>(BUFFER_EVENTS) : 0;
+        size_t count = 0;
+        for (uint32_t index = first; index != head && count < capacity; index++) {
+            if (readSlot(ring, index, out[count])) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    // Visit every readable event without a copy buffer; returns the count
+    size_t forEachEvent(EventFn fn, Sink* sink) const {
+        size_t count = 0;
+        for (size_t core = 0; core < NUM_CORES; core++) {
+            const Ring& ring = rings_[core];
+            const uint32_t head = ring.head.load(std::memory_order_acquire);
+            const uint32_t first = head > BUFFER_EVENTS ? head - static_cast<uint32_t>(BUFFER_EVENTS) : 0;
+            for (uint32_t index = first; index != head; index++) {
+                Event event;
+                if (readSlot(ring, index, event)) {
+                    if (fn != nullptr) {
+                        fn(sink, event);
+                    }
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+
+    static void emitBinary(Sink* sink, const Event& event) {
+        if (sink->written >= sink->limit) {
+            return;  // Keep the record count in the header exact
+        }
+        BinaryRecord record{static_cast<uint32_t>(reinterpret_cast<uintptr_t>(event.name)),
+                            event.startUs, event.durationUs, event.arg, event.core};
+        sink->write(sink->context, reinterpret_cast<const char*>(&record), sizeof(record));
+        sink->written++;
+    }
+
+    static void emitChrome(Sink* sink, const Event& event) {
+        char line[160];
+        const int length = snprintf(line, sizeof(line),
+            "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":0,\"tid\":%u,\"args\":{\"arg\":%lu}}",
+            sink->written > 0 ? "," : "",
+            event.name != nullptr ? event.name : "?",
+            static_cast<unsigned long>(event.startUs),
+            static_cast<unsigned long>(event.durationUs),
+            static_cast<unsigned>(event.core),
+            static_cast<unsigned long>(event.arg));
+        if (length > 0) {
+            const size_t size = static_cast<size_t>(length) < sizeof(line) ? static_cast<size_t>(length)
+                                                                           : sizeof(line) - 1;
+            sink->write(sink->context, line, size);
+            sink->written++;
+        }
+    }
+
+    std::atomic<bool> enabled_;
+    Ring rings_[NUM_CORES];
+};
+
+namespace idev_detail {
+// constexpr constructor: constant-initialized, no dynamic initializer or guard
+inline DeviceTrace traceInstance;
+}
+
+inline DeviceTrace& DeviceTrace::instance() noexcept {
+    return idev_detail::traceInstance;
+}
+
+// Scoped span macros - compiled in with -DIDEVICEINSTANCE_TRACE
+#define IDEV_TRACE_CONCAT_INNER(a, b) a##b
+#define IDEV_TRACE_CONCAT(a, b) IDEV_TRACE_CONCAT_INNER(a, b)
+
+#ifdef IDEVICEINSTANCE_TRACE
+    #define IDEV_TRACE_SCOPE(name) \
+        DeviceTrace::Span IDEV_TRACE_CONCAT(_idev_span_, __LINE__)(name)
+    #define IDEV_TRACE_SCOPE_ARG(name, arg) \
+        DeviceTrace::Span IDEV_TRACE_CONCAT(_idev_span_, __LINE__)(name, static_cast<uint32_t>(arg))
+#else
+    #define IDEV_TRACE_SCOPE(name) ((void)0)
+    #define IDEV_TRACE_SCOPE_ARG(name, arg) ((void)0)
+#endif
+
+#endif // DEVICE_TRACE_H
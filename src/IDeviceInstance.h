@@ -15,15 +15,72 @@
 
 #include "freertos/semphr.h"
 #include "freertos/event_groups.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
 #include <vector>
 #include <functional>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <atomic>
 
 // Include common Result type
 #include "Result.h"
 
+// Lock-free publication of cached data
+#include "DeviceSeqLock.h"
+
+// Integer fixed-point readings
+#include "ScaledValue.h"
+
+// Persisted driver state for warm restarts
+#include "DeviceStateBlob.h"
+
 // Include logging configuration
 #include "IDeviceInstanceLogging.h"
 
+/**
+ * @brief Maximum number of channels per data type for inline containers
+ *
+ * Sizes ChannelValues / RawChannelValues. Override via build flag
+ * (e.g. -DIDEV_MAX_CHANNELS=16) for devices with more channels.
+ */
+#ifndef IDEV_MAX_CHANNELS
+#define IDEV_MAX_CHANNELS 8
+#endif
+
+/**
+ * @brief Inline storage of an EventDelegate in bytes
+ *
+ * Enough for a lambda capturing two pointers. Override via build flag.
+ */
+#ifndef IDEV_EVENT_DELEGATE_STORAGE
+#define IDEV_EVENT_DELEGATE_STORAGE (2 * sizeof(void*))
+#endif
+
+/**
+ * @brief Capacity of an EventCallbackTable
+ */
+#ifndef IDEV_MAX_CALLBACKS
+#define IDEV_MAX_CALLBACKS 4
+#endif
+
+/**
+ * @brief Longest wait for getMutexInstance() in the default getSnapshot()
+ *
+ * Bounds telemetry readers behind a stuck writer. Override via build flag.
+ */
+#ifndef IDEV_SNAPSHOT_MUTEX_TIMEOUT_MS
+#define IDEV_SNAPSHOT_MUTEX_TIMEOUT_MS 100
+#endif
+
+// Per-device counters and histograms (DeviceStatistics.h)
+class DeviceStatistics;
+
+// Single-flight request coalescing (DeviceRequestCoalescer.h)
+class DeviceRequestCoalescer;
+
 /**
  * @class IDeviceInstance
  * @brief Abstract base class for device instance implementations
@@ -93,6 +150,390 @@ public:
     template<typename T>
     using DeviceResult = common::Result<T, DeviceError>;
 
+    /**
+     * @class StaticVector
+     * @brief Fixed-capacity vector with inline storage
+     * @tparam T Element type (must be trivially copyable)
+     * @tparam N Maximum number of elements
+     *
+     * Drop-in replacement for std::vector on read paths: never touches the
+     * heap, copies and moves are plain memberwise copies.
+     */
+    template<typename T, size_t N>
+    class StaticVector {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "StaticVector requires a trivially copyable element type");
+    public:
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        constexpr StaticVector() noexcept : data_(), size_(0) {}
+
+        static constexpr size_t capacity() noexcept { return N; }
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        bool full() const noexcept { return size_ == N; }
+
+        /**
+         * @brief Append an element
+         * @return false if the container is full (element not added)
+         */
+        bool push_back(const T& value) noexcept {
+            if (size_ >= N) {
+                return false;
+            }
+            data_[size_++] = value;
+            return true;
+        }
+
+        /**
+         * @brief Change the element count without initializing new elements
+         * @return false if @p count exceeds the capacity
+         */
+        bool resize(size_t count) noexcept {
+            if (count > N) {
+                return false;
+            }
+            size_ = count;
+            return true;
+        }
+
+        void clear() noexcept { size_ = 0; }
+
+        T& operator[](size_t index) noexcept { return data_[index]; }
+        const T& operator[](size_t index) const noexcept { return data_[index]; }
+        T& front() noexcept { return data_[0]; }
+        const T& front() const noexcept { return data_[0]; }
+        T& back() noexcept { return data_[size_ - 1]; }
+        const T& back() const noexcept { return data_[size_ - 1]; }
+
+        T* data() noexcept { return data_; }
+        const T* data() const noexcept { return data_; }
+        iterator begin() noexcept { return data_; }
+        iterator end() noexcept { return data_ + size_; }
+        const_iterator begin() const noexcept { return data_; }
+        const_iterator end() const noexcept { return data_ + size_; }
+
+    private:
+        T data_[N];
+        size_t size_;
+    };
+
+    /**
+     * @brief Maximum channel count of the inline channel containers
+     */
+    static constexpr size_t MAX_CHANNELS = IDEV_MAX_CHANNELS;
+
+    /**
+     * @brief Inline container for scaled multi-channel readings
+     */
+    using ChannelValues = StaticVector<float, MAX_CHANNELS>;
+
+    /**
+     * @brief Inline container for raw multi-channel readings
+     */
+    using RawChannelValues = StaticVector<int16_t, MAX_CHANNELS>;
+
+    /**
+     * @brief Fixed-point reading (raw value plus its divider)
+     */
+    using ScaledValue = ::ScaledValue;
+
+    /**
+     * @brief CRC-protected driver state (see saveState() / restoreState())
+     */
+    using DeviceStateBlob = ::DeviceStateBlob;
+
+    /**
+     * @brief Inline container for fixed-point multi-channel readings
+     */
+    using ScaledChannelValues = StaticVector<ScaledValue, MAX_CHANNELS>;
+
+    /**
+     * @brief Bitmask of channels (bit n = channel n)
+     */
+    using ChannelMask = uint32_t;
+
+    /**
+     * @brief Bitmask of DeviceDataType values (bit n = data type n)
+     */
+    using DataTypeMask = uint32_t;
+
+    /**
+     * @brief Number of defined data types
+     */
+    static constexpr size_t NUM_DATA_TYPES = static_cast<size_t>(DeviceDataType::NUM_TYPES);
+
+    /**
+     * @brief Mask with every defined data type set
+     */
+    static constexpr DataTypeMask ALL_DATA_TYPES = (DataTypeMask(1) << NUM_DATA_TYPES) - 1;
+
+    /**
+     * @brief Get the mask bit for a data type
+     * @param dataType The data type
+     * @return Bit in a DataTypeMask corresponding to @p dataType
+     */
+    static constexpr DataTypeMask dataTypeBit(DeviceDataType dataType) noexcept {
+        return DataTypeMask(1) << static_cast<unsigned>(dataType);
+    }
+
+    /**
+     * @struct DeviceCapabilities
+     * @brief Compile-time description of what a device provides
+     *
+     * Drivers declare one as a static constexpr member and return it from
+     * getCapabilities(). Consumers query it to size buffers and skip
+     * unsupported types without a lock.
+     *
+     * @code
+     * static constexpr DeviceCapabilities CAPABILITIES = DeviceCapabilities()
+     *     .withType(DeviceDataType::TEMPERATURE, 8, 10)
+     *     .withMinInterval(100);
+     * const DeviceCapabilities& getCapabilities() const noexcept override { return CAPABILITIES; }
+     * @endcode
+     *
+     * @note Scale dividers are the defaults; devices with runtime-detected
+     *       scaling still report the live value via getDataScaleDivider()
+     */
+    struct DeviceCapabilities {
+        DataTypeMask supportedTypes;                        ///< Supported data types
+        uint8_t channelCount[NUM_DATA_TYPES];               ///< Channels per data type
+        int16_t scaleDivider[NUM_DATA_TYPES][MAX_CHANNELS]; ///< Default raw divider per channel
+        uint32_t minIntervalMs;                             ///< Max refresh rate as minimum update interval (0 = unspecified)
+
+        constexpr DeviceCapabilities() noexcept
+            : supportedTypes(0), channelCount(), scaleDivider(), minIntervalMs(0) {}
+
+        /**
+         * @brief Declare a supported data type
+         * @param dataType The data type
+         * @param channels Number of channels (clamped to MAX_CHANNELS)
+         * @param divider Raw scale divider applied to every channel
+         * @return Updated copy of the descriptor
+         */
+        constexpr DeviceCapabilities withType(DeviceDataType dataType, uint8_t channels,
+                                              int16_t divider = 1) const noexcept {
+            DeviceCapabilities caps = *this;
+            const auto index = static_cast<size_t>(dataType);
+            if (index >= NUM_DATA_TYPES) {
+                return caps;
+            }
+            const uint8_t count = channels > MAX_CHANNELS ? static_cast<uint8_t>(MAX_CHANNELS) : channels;
+            caps.supportedTypes |= dataTypeBit(dataType);
+            caps.channelCount[index] = count;
+            for (size_t ch = 0; ch < count; ch++) {
+                caps.scaleDivider[index][ch] = divider;
+            }
+            return caps;
+        }
+
+        /**
+         * @brief Override the divider of one channel
+         * @return Updated copy of the descriptor
+         */
+        constexpr DeviceCapabilities withChannelDivider(DeviceDataType dataType, uint8_t channel,
+                                                        int16_t divider) const noexcept {
+            DeviceCapabilities caps = *this;
+            const auto index = static_cast<size_t>(dataType);
+            if (index < NUM_DATA_TYPES && channel < MAX_CHANNELS) {
+                caps.scaleDivider[index][channel] = divider;
+            }
+            return caps;
+        }
+
+        /**
+         * @brief Set the minimum interval between updates
+         * @return Updated copy of the descriptor
+         */
+        constexpr DeviceCapabilities withMinInterval(uint32_t intervalMs) const noexcept {
+            DeviceCapabilities caps = *this;
+            caps.minIntervalMs = intervalMs;
+            return caps;
+        }
+
+        constexpr bool supports(DeviceDataType dataType) const noexcept {
+            return isValidDataType(static_cast<int>(dataType)) &&
+                   (supportedTypes & dataTypeBit(dataType)) != 0;
+        }
+
+        /**
+         * @brief Check whether anything was declared (empty means "unknown")
+         */
+        constexpr bool isDeclared() const noexcept {
+            return supportedTypes != 0;
+        }
+
+        /**
+         * @brief Like supports(), but an undeclared descriptor excludes nothing
+         */
+        constexpr bool mayProvide(DeviceDataType dataType) const noexcept {
+            return !isDeclared() || supports(dataType);
+        }
+
+        constexpr uint8_t channels(DeviceDataType dataType) const noexcept {
+            return supports(dataType) ? channelCount[static_cast<size_t>(dataType)] : 0;
+        }
+
+        constexpr int16_t divider(DeviceDataType dataType, uint8_t channel) const noexcept {
+            return (channel < channels(dataType)) ? scaleDivider[static_cast<size_t>(dataType)][channel] : 1;
+        }
+
+        /**
+         * @brief Largest channel count over all supported types
+         */
+        constexpr uint8_t maxChannels() const noexcept {
+            uint8_t result = 0;
+            for (size_t i = 0; i < NUM_DATA_TYPES; i++) {
+                if (channelCount[i] > result) {
+                    result = channelCount[i];
+                }
+            }
+            return result;
+        }
+    };
+
+    /**
+     * @brief Get the device's capability descriptor
+     * @return Descriptor with static storage duration; an empty descriptor
+     *         by default
+     * @note Check hasCapabilities() - an empty descriptor means "unknown",
+     *       not "supports nothing"
+     * @note Drivers with runtime-detected variants return one of several
+     *       static constexpr descriptors
+     * @note Virtual so that the interface stays free of data members. The
+     *       descriptor has static storage duration: consumers on a hot path
+     *       keep the reference and query it without further virtual calls
+     */
+    virtual const DeviceCapabilities& getCapabilities() const noexcept {
+        static constexpr DeviceCapabilities unknown{};
+        return unknown;
+    }
+
+    /**
+     * @brief Check whether the driver declared a capability descriptor
+     */
+    bool hasCapabilities() const noexcept {
+        return getCapabilities().isDeclared();
+    }
+
+    /**
+     * @brief Check whether a data type may be supported
+     * @return false only if a descriptor is declared and excludes the type
+     */
+    bool supportsDataType(DeviceDataType dataType) const noexcept {
+        return getCapabilities().mayProvide(dataType);
+    }
+
+    /**
+     * @brief Freshness information for the cached readings of one data type
+     */
+    struct DataStamp {
+        uint32_t generation = 0;    ///< Incremented by every processData() update (0 = no data yet)
+        int64_t timestampUs = 0;    ///< esp_timer_get_time() of the update
+    };
+
+    /**
+     * @brief Importance of a data request (higher values are served first)
+     *
+     * Values map directly onto DeviceBusScheduler::Job::priority.
+     */
+    enum class RequestPriority : uint8_t {
+        BACKGROUND = 0,     ///< Diagnostics, statistics
+        TELEMETRY = 64,     ///< MQTT/UI reporting
+        NORMAL = 128,       ///< Default
+        CONTROL = 192,      ///< Control-loop inputs
+        SAFETY = 255        ///< Safety-relevant reads (overtemperature, interlocks)
+    };
+
+    /**
+     * @brief Options for requestData(const RequestOptions&)
+     */
+    struct RequestOptions {
+        RequestPriority priority;       ///< Priority class
+        TickType_t deadline;            ///< Absolute tick count by which data is needed, 0 = none
+        TickType_t expectedDuration;    ///< Estimated request duration in ticks, 0 = unknown
+
+        RequestOptions(RequestPriority requestPriority = RequestPriority::NORMAL,
+                       TickType_t absoluteDeadline = 0, TickType_t duration = 0) noexcept
+            : priority(requestPriority), deadline(absoluteDeadline), expectedDuration(duration) {}
+
+        /**
+         * @brief Options with a deadline @p timeout ticks from now
+         */
+        static RequestOptions within(TickType_t timeout, RequestPriority requestPriority = RequestPriority::NORMAL,
+                                     TickType_t duration = 0) noexcept {
+            const TickType_t target = xTaskGetTickCount() + timeout;
+            return RequestOptions(requestPriority, target != 0 ? target : 1, duration);
+        }
+
+        /**
+         * @brief Check whether the request can no longer finish in time
+         * @param now Current tick count
+         * @param estimate Duration estimate in ticks (default expectedDuration)
+         * @return true if the deadline has passed or less than @p estimate remains
+         */
+        bool cannotMeet(TickType_t now, TickType_t estimate) const noexcept {
+            if (deadline == 0) {
+                return false;
+            }
+            const int32_t remaining = static_cast<int32_t>(deadline - now);
+            return remaining <= 0 || remaining < static_cast<int32_t>(estimate);
+        }
+
+        bool cannotMeet(TickType_t now) const noexcept {
+            return cannotMeet(now, expectedDuration);
+        }
+    };
+
+    /**
+     * @brief Flat multi-type snapshot filled by getSnapshot()
+     *
+     * Values are indexed by DeviceDataType. Only types set in validMask
+     * hold meaningful data.
+     */
+    struct DeviceSnapshot {
+        DataTypeMask validMask = 0;                 ///< Types captured in this snapshot
+        ChannelValues values[NUM_DATA_TYPES];       ///< Values per data type
+        DataStamp stamps[NUM_DATA_TYPES];           ///< Freshness per data type (zero if unknown)
+
+        bool has(DeviceDataType dataType) const noexcept {
+            return (validMask & dataTypeBit(dataType)) != 0;
+        }
+
+        const ChannelValues& get(DeviceDataType dataType) const noexcept {
+            return values[static_cast<size_t>(dataType)];
+        }
+
+        void clear() noexcept {
+            validMask = 0;
+            for (auto& v : values) {
+                v.clear();
+            }
+            for (auto& stamp : stamps) {
+                stamp = DataStamp();
+            }
+        }
+    };
+
+    /**
+     * @brief Cached readings of one data type as published by processData()
+     */
+    struct PublishedData {
+        ChannelValues values;       ///< Scaled values
+        RawChannelValues raw;       ///< Raw values (empty if not provided)
+        int64_t timestampUs = 0;    ///< Set by publishData()
+    };
+
+    /**
+     * @brief Lock-free publication slot for one data type
+     *
+     * processData() calls publishData(), readers copy without any mutex.
+     * The slot version is the generation number of the data.
+     */
+    using PublishedSlot = DeviceSeqLock<PublishedData>;
+
     /**
      * @enum EventType
      * @brief Types of events that can be notified via callbacks
@@ -111,15 +552,205 @@ public:
     struct EventNotification {
         EventType type;         ///< Type of event
         DeviceError error;      ///< Associated error code (if applicable)
-        int customData;         ///< Custom data for device-specific events
+        int customData;         ///< Custom data for device-specific events; for DATA_READY
+                                ///< the changed ChannelMask when filtered by a deadband (0 = unspecified)
     };
     
+    /**
+     * @brief One entry of a performActions() batch
+     */
+    struct ActionRequest {
+        int actionId;       ///< Device-specific action identifier
+        int actionParam;    ///< Parameter for the action
+    };
+
     /**
      * @brief Callback function type for event notifications
      * @param notification The event notification data
      */
     using EventCallback = std::function<void(const EventNotification& notification)>;
 
+    /**
+     * @brief Number of EventType values
+     */
+    static constexpr size_t NUM_EVENT_TYPES = static_cast<size_t>(EventType::CUSTOM_EVENT) + 1;
+
+    /**
+     * @class EventDelegate
+     * @brief Allocation-free callable for event notifications
+     *
+     * Stores a small, trivially copyable callable (function pointer or a
+     * lambda capturing a few pointers/values) inline. Construction never
+     * allocates and invocation is a single indirect call.
+     *
+     * @code
+     * device->registerDelegate([this](const EventNotification& n) { onEvent(n); });
+     * @endcode
+     */
+    class EventDelegate {
+    public:
+        static constexpr size_t STORAGE_SIZE = IDEV_EVENT_DELEGATE_STORAGE;
+
+        EventDelegate() noexcept : invoker_(nullptr) {}
+
+        template<typename F,
+                 typename = typename std::enable_if<
+                     !std::is_same<typename std::decay<F>::type, EventDelegate>::value>::type>
+        EventDelegate(F callable) noexcept : storage_(), invoker_(&invoke<F>) {
+            static_assert(sizeof(F) <= STORAGE_SIZE,
+                          "Callable too large for EventDelegate - capture less or raise IDEV_EVENT_DELEGATE_STORAGE");
+            static_assert(alignof(F) <= alignof(std::max_align_t),
+                          "Callable over-aligned for EventDelegate storage");
+            static_assert(std::is_trivially_copyable<F>::value && std::is_trivially_destructible<F>::value,
+                          "EventDelegate callables must be trivially copyable - capture pointers or values only");
+            ::new (static_cast<void*>(storage_)) F(callable);
+        }
+
+        /**
+         * @brief Invoke the callable (no-op if empty)
+         */
+        void operator()(const EventNotification& notification) const {
+            if (invoker_ != nullptr) {
+                invoker_(storage_, notification);
+            }
+        }
+
+        explicit operator bool() const noexcept {
+            return invoker_ != nullptr;
+        }
+
+    private:
+        template<typename F>
+        static void invoke(const void* storage, const EventNotification& notification) {
+            (*static_cast<F*>(const_cast<void*>(storage)))(notification);
+        }
+
+        alignas(std::max_align_t) unsigned char storage_[STORAGE_SIZE];
+        void (*invoker_)(const void*, const EventNotification&);
+    };
+
+    /**
+     * @class EventCallbackTable
+     * @brief Fixed-capacity, allocation-free callback registry for drivers
+     *
+     * Holds up to IDEV_MAX_CALLBACKS delegates plus a per-EventType enable
+     * mask. add()/clear()/setEnabled() serialize on a short spinlock and bump
+     * a sequence counter; dispatch() takes no lock, copies the registered
+     * delegates and retries only if a registration raced with the copy, then
+     * invokes them outside.
+     */
+    class EventCallbackTable {
+    public:
+        static constexpr size_t CAPACITY = IDEV_MAX_CALLBACKS;
+
+        EventCallbackTable() noexcept
+            : sequence_(0), count_(0), enabledMask_((1u << NUM_EVENT_TYPES) - 1) {}
+
+        EventCallbackTable(const EventCallbackTable&) = delete;
+        EventCallbackTable& operator=(const EventCallbackTable&) = delete;
+
+        /**
+         * @brief Register a delegate
+         * @return SUCCESS, INVALID_PARAMETER for an empty delegate,
+         *         MEMORY_ERROR if the table is full
+         */
+        DeviceError add(const EventDelegate& delegate) noexcept {
+            if (!delegate) {
+                return DeviceError::INVALID_PARAMETER;
+            }
+            DeviceError error = DeviceError::MEMORY_ERROR;
+            beginWrite();
+            if (count_ < CAPACITY) {
+                slots_[count_++] = delegate;
+                error = DeviceError::SUCCESS;
+            }
+            endWrite();
+            return error;
+        }
+
+        /**
+         * @brief Remove all delegates
+         */
+        void clear() noexcept {
+            beginWrite();
+            count_ = 0;
+            endWrite();
+        }
+
+        /**
+         * @brief Enable or disable dispatch of one event type
+         * @return SUCCESS or INVALID_PARAMETER for an unknown type
+         */
+        DeviceError setEnabled(EventType eventType, bool enable) noexcept {
+            const auto index = static_cast<size_t>(eventType);
+            if (index >= NUM_EVENT_TYPES) {
+                return DeviceError::INVALID_PARAMETER;
+            }
+            beginWrite();
+            if (enable) {
+                enabledMask_ |= (1u << index);
+            } else {
+                enabledMask_ &= ~(1u << index);
+            }
+            endWrite();
+            return DeviceError::SUCCESS;
+        }
+
+        bool isEnabled(EventType eventType) const noexcept {
+            const auto index = static_cast<size_t>(eventType);
+            return index < NUM_EVENT_TYPES && (enabledMask_ & (1u << index)) != 0;
+        }
+
+        size_t size() const noexcept {
+            return count_;
+        }
+
+        /**
+         * @brief Invoke every registered delegate if the event type is enabled
+         * @param notification The event to deliver
+         */
+        void dispatch(const EventNotification& notification) const {
+            EventDelegate targets[CAPACITY];
+            size_t count = 0;
+            for (;;) {
+                const uint32_t before = sequence_.load(std::memory_order_acquire);
+                if ((before & 1u) != 0) {
+                    continue;  // Registration in progress
+                }
+                count = isEnabled(notification.type) ? count_ : 0;
+                for (size_t i = 0; i < count; i++) {
+                    targets[i] = slots_[i];
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence_.load(std::memory_order_relaxed) == before) {
+                    break;
+                }
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                targets[i](notification);
+            }
+        }
+
+    private:
+        void beginWrite() noexcept {
+            portENTER_CRITICAL(&lock_);
+            sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        void endWrite() noexcept {
+            sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            portEXIT_CRITICAL(&lock_);
+        }
+
+        std::atomic<uint32_t> sequence_;
+        EventDelegate slots_[CAPACITY];
+        size_t count_;
+        uint32_t enabledMask_;
+        portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+    };
+
     /**
      * @brief Initialize the device instance
      * 
@@ -181,6 +812,38 @@ public:
      * @note Implementations should convert ErrorCode from waitForInitialization() if needed
      */
     virtual DeviceResult<void> waitForInitializationComplete(TickType_t timeout = portMAX_DELAY) = 0;
+
+    /**
+     * @brief Serialize validated configuration for a fast restart
+     *
+     * Drivers store what initialize() discovered (bus address, sensor types,
+     * scale dividers) so a later restoreState() lets initialize() skip the
+     * probe sequence, e.g. after waking from deep sleep.
+     *
+     * @param blob Destination, typically in RTC slow memory or saved to NVS
+     * @return DeviceResult<void>; NOT_INITIALIZED if there is nothing
+     *         validated to save; NOT_SUPPORTED by default
+     */
+    virtual DeviceResult<void> saveState(DeviceStateBlob& blob) const {
+        (void)blob;
+        return DeviceResult<void>(DeviceError::NOT_SUPPORTED);
+    }
+
+    /**
+     * @brief Offer saved state to the next initialize()
+     *
+     * Call before initialize(). On success initialize() may take its fast
+     * path (and should still fall back to full discovery if the hardware
+     * does not answer as recorded).
+     *
+     * @param blob State written by saveState()
+     * @return DeviceResult<void>; INVALID_PARAMETER if the blob does not
+     *         validate (stale, foreign or corrupt); NOT_SUPPORTED by default
+     */
+    virtual DeviceResult<void> restoreState(const DeviceStateBlob& blob) {
+        (void)blob;
+        return DeviceResult<void>(DeviceError::NOT_SUPPORTED);
+    }
     
     /**
      * @brief Request data from the device
@@ -192,6 +855,29 @@ public:
      * @note Non-blocking operation
      */
     virtual DeviceResult<void> requestData() = 0;
+
+    /**
+     * @brief Request data with a priority class and an absolute deadline
+     *
+     * Drivers with an internal request queue (or a DeviceBusScheduler in
+     * front of them) use the options to order pending work. A request
+     * that can no longer meet its deadline fails fast with TIMEOUT
+     * instead of occupying the bus.
+     *
+     * @param options Priority class, deadline and optional duration estimate
+     * @return DeviceResult<void>; TIMEOUT if the deadline cannot be met
+     *
+     * @note Default implementation checks the deadline and forwards to
+     *       requestData(); the priority is ignored
+     * @note Classes overriding requestData() should add
+     *       `using IDeviceInstance::requestData;` to keep this overload visible
+     */
+    virtual DeviceResult<void> requestData(const RequestOptions& options) {
+        if (options.cannotMeet(xTaskGetTickCount())) {
+            return DeviceResult<void>(DeviceError::TIMEOUT);
+        }
+        return requestData();
+    }
     
     /**
      * @brief Wait for pending data request to complete
@@ -211,10 +897,14 @@ public:
      *                     Use portMAX_DELAY for indefinite wait
      * @return DeviceError indicating the result of the operation
      *
-     * @note Default implementation calls waitForData() and converts result
+     * @note Default implementation calls waitForData() and converts result.
+     *       The blocking waitForData() cannot poll, so a zero timeout
+     *       returns NOT_SUPPORTED instead of blocking
      */
     virtual DeviceError waitForData(TickType_t xTicksToWait) {
-        (void)xTicksToWait; // Suppress unused parameter warning
+        if (xTicksToWait == 0) {
+            return DeviceError::NOT_SUPPORTED;
+        }
         return waitForData() ? DeviceError::SUCCESS : DeviceError::UNKNOWN_ERROR;
     }
     
@@ -261,6 +951,305 @@ public:
         return DeviceResult<std::vector<int16_t>>(DeviceError::NOT_SUPPORTED);
     }
 
+    /**
+     * @brief Retrieve float data into a caller-provided buffer
+     *
+     * Allocation-free counterpart of getData() for hot paths that read
+     * several times per second.
+     *
+     * @param dataType The type of data to retrieve
+     * @param out Destination buffer (must not be nullptr)
+     * @param capacity Number of elements available in @p out
+     * @return DeviceResult<size_t> with the number of values written
+     *
+     * @note Returns INVALID_PARAMETER if @p out is nullptr or @p capacity is
+     *       smaller than the number of available values (nothing is written)
+     * @note Default implementation reads the published slot lock-free when
+     *       getPublishedSlot() provides one, otherwise forwards to getData()
+     *       and copies - override in derived classes to skip the heap completely
+     */
+    virtual DeviceResult<size_t> getDataInto(DeviceDataType dataType, float* out, size_t capacity) {
+        if (const PublishedSlot* slot = getPublishedSlot(dataType)) {
+            return readPublished(*slot, &PublishedData::values, out, capacity);
+        }
+        auto result = getData(dataType);
+        if (!result.isOk()) {
+            return DeviceResult<size_t>(result.error());
+        }
+        return copyToBuffer(result.value(), out, capacity);
+    }
+
+    /**
+     * @brief Retrieve raw integer data into a caller-provided buffer
+     *
+     * Allocation-free counterpart of getDataRaw().
+     *
+     * @param dataType The type of data to retrieve
+     * @param out Destination buffer (must not be nullptr)
+     * @param capacity Number of elements available in @p out
+     * @return DeviceResult<size_t> with the number of values written
+     *
+     * @note Same buffer rules as getDataInto()
+     * @note Default implementation reads the published slot lock-free when
+     *       getPublishedSlot() provides one and the driver publishes raw
+     *       values, otherwise forwards to getDataRaw() (NOT_SUPPORTED by default)
+     */
+    virtual DeviceResult<size_t> getDataRawInto(DeviceDataType dataType, int16_t* out, size_t capacity) {
+        if (const PublishedSlot* slot = getPublishedSlot(dataType)) {
+            auto published = readPublished(*slot, &PublishedData::raw, out, capacity);
+            if (!published.isOk() || published.value() > 0) {
+                return published;
+            }
+            // Published without raw values
+        }
+        auto result = getDataRaw(dataType);
+        if (!result.isOk()) {
+            return DeviceResult<size_t>(result.error());
+        }
+        return copyToBuffer(result.value(), out, capacity);
+    }
+
+    /**
+     * @brief Get the lock-free publication slot for a data type
+     *
+     * Drivers that opt in own one PublishedSlot per supported type and call
+     * publish() at the end of processData(). The default getDataInto(),
+     * getDataRawInto() and everything built on them then read from the slot
+     * without taking getMutexInstance(), so readers never wait behind a bus
+     * transaction.
+     *
+     * @param dataType The type of data
+     * @return Pointer to the slot, or nullptr if not published (default)
+     * @note The slot must live as long as the device instance
+     */
+    virtual const PublishedSlot* getPublishedSlot(DeviceDataType dataType) const noexcept {
+        (void)dataType;
+        return nullptr;
+    }
+
+    /**
+     * @brief Get generation and timestamp of the cached data for a type
+     *
+     * @param dataType The type of data
+     * @return DeviceResult<DataStamp>; NOT_SUPPORTED if the driver does not
+     *         track freshness
+     *
+     * @note Default implementation reads the published slot when available
+     */
+    virtual DeviceResult<DataStamp> getDataStamp(DeviceDataType dataType) const {
+        const PublishedSlot* slot = getPublishedSlot(dataType);
+        if (slot == nullptr) {
+            return DeviceResult<DataStamp>(DeviceError::NOT_SUPPORTED);
+        }
+        PublishedData data;
+        uint32_t generation = 0;
+        slot->read(data, &generation);
+        DataStamp stamp;
+        stamp.generation = generation;
+        stamp.timestampUs = data.timestampUs;
+        return DeviceResult<DataStamp>(stamp);
+    }
+
+    /**
+     * @brief Retrieve float data only if it changed since the caller's last read
+     *
+     * @param dataType The type of data to retrieve
+     * @param lastGeneration In: generation seen by the caller (0 initially).
+     *                       Out: generation of the returned data on success
+     * @param out Destination buffer
+     * @param capacity Number of elements available in @p out
+     * @return DeviceResult<size_t> with the number of values written, or
+     *         DATA_NOT_READY without copying anything if nothing changed
+     *
+     * @note With a published slot the check is a single atomic load
+     */
+    virtual DeviceResult<size_t> getDataIfNewer(DeviceDataType dataType, uint32_t& lastGeneration,
+                                                float* out, size_t capacity) {
+        if (const PublishedSlot* slot = getPublishedSlot(dataType)) {
+            if (slot->version() == lastGeneration) {
+                return DeviceResult<size_t>(DeviceError::DATA_NOT_READY);
+            }
+            return readPublished(*slot, &PublishedData::values, out, capacity, &lastGeneration);
+        }
+
+        auto stamp = getDataStamp(dataType);
+        if (!stamp.isOk()) {
+            return DeviceResult<size_t>(stamp.error());
+        }
+        if (stamp.value().generation == lastGeneration) {
+            return DeviceResult<size_t>(DeviceError::DATA_NOT_READY);
+        }
+        auto result = getDataInto(dataType, out, capacity);
+        if (result.isOk()) {
+            lastGeneration = stamp.value().generation;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Retrieve float data as an inline, heap-free container
+     *
+     * @tparam N Container capacity (default: MAX_CHANNELS)
+     * @param dataType The type of data to retrieve
+     * @return DeviceResult<StaticVector<float, N>> containing the values
+     *
+     * @note Built on getDataInto() - allocation-free when the driver overrides it
+     * @note Returns INVALID_PARAMETER if the device has more than N values
+     */
+    template<size_t N = MAX_CHANNELS>
+    DeviceResult<StaticVector<float, N>> getDataStatic(DeviceDataType dataType) {
+        StaticVector<float, N> values;
+        auto result = getDataInto(dataType, values.data(), N);
+        if (!result.isOk()) {
+            return DeviceResult<StaticVector<float, N>>(result.error());
+        }
+        values.resize(result.value());
+        return DeviceResult<StaticVector<float, N>>(values);
+    }
+
+    /**
+     * @brief Retrieve raw integer data as an inline, heap-free container
+     *
+     * @tparam N Container capacity (default: MAX_CHANNELS)
+     * @param dataType The type of data to retrieve
+     * @return DeviceResult<StaticVector<int16_t, N>> containing the raw values
+     *
+     * @note Built on getDataRawInto() - allocation-free when the driver overrides it
+     */
+    template<size_t N = MAX_CHANNELS>
+    DeviceResult<StaticVector<int16_t, N>> getDataRawStatic(DeviceDataType dataType) {
+        StaticVector<int16_t, N> values;
+        auto result = getDataRawInto(dataType, values.data(), N);
+        if (!result.isOk()) {
+            return DeviceResult<StaticVector<int16_t, N>>(result.error());
+        }
+        values.resize(result.value());
+        return DeviceResult<StaticVector<int16_t, N>>(values);
+    }
+
+    /**
+     * @brief Check whether the cached data of a type is at most @p maxAgeMs old
+     *
+     * @param dataType The type of data
+     * @param maxAgeMs Maximum acceptable age in milliseconds
+     * @param stamp Optional - receives the stamp that was checked
+     * @return false if nothing was cached yet or getDataStamp() is not supported
+     */
+    bool isDataFresh(DeviceDataType dataType, uint32_t maxAgeMs, DataStamp* stamp = nullptr) const {
+        auto current = getDataStamp(dataType);
+        if (!current.isOk() || current.value().generation == 0) {
+            return false;
+        }
+        if (stamp != nullptr) {
+            *stamp = current.value();
+        }
+        return esp_timer_get_time() - current.value().timestampUs <= static_cast<int64_t>(maxAgeMs) * 1000;
+    }
+
+    /**
+     * @brief Retrieve data no older than @p maxAgeMs, refreshing only if needed
+     *
+     * Returns the cached values when their stamp shows they are young
+     * enough. Otherwise refreshes within @p timeout and returns the new
+     * values:
+     * - Drivers with getRequestCoalescer(): a flight in progress is joined
+     *   instead of issuing another requestData(); the driver's response
+     *   handler runs processData()
+     * - Other drivers: one requestData() / waitForData() / processData()
+     *   cycle of the caller's own
+     *
+     * @param dataType The type of data to retrieve
+     * @param maxAgeMs Maximum acceptable age in milliseconds (0 = always refresh)
+     * @param timeout Deadline for the refresh
+     * @param stamp Optional - receives the stamp of the returned values
+     *        (left untouched if the driver does not track freshness)
+     * @return DeviceResult<ChannelValues>; TIMEOUT if the refresh did not
+     *         complete in time, or the error of the failed step
+     *
+     * @note Without getDataStamp() support every call refreshes
+     * @note With a published slot values and stamp come from one slot copy
+     * @note Defined in DeviceRequestCoalescer.h, which this header includes
+     */
+    virtual DeviceResult<ChannelValues> getDataFresh(DeviceDataType dataType, uint32_t maxAgeMs,
+                                                     TickType_t timeout = portMAX_DELAY,
+                                                     DataStamp* stamp = nullptr);
+
+    /**
+     * @brief Join hook for getDataFresh()
+     *
+     * Drivers whose requestData() starts or joins flights on a
+     * DeviceRequestCoalescer, and whose response handler runs processData()
+     * before complete(), return it here.
+     *
+     * @return The coalescer, or nullptr (default)
+     */
+    virtual DeviceRequestCoalescer* getRequestCoalescer() noexcept {
+        return nullptr;
+    }
+
+    /**
+     * @brief Capture several data types in one consistent snapshot
+     *
+     * @param typeMask Data types to capture (combine dataTypeBit() values)
+     * @param snapshot Destination; cleared first, validMask reports captured types
+     * @return DeviceResult<void> - SUCCESS if at least one requested type was
+     *         captured; INVALID_PARAMETER for an empty mask or unknown bits;
+     *         NOT_SUPPORTED if a requested type has no published slot;
+     *         MUTEX_ERROR if getMutexInstance() was not free within
+     *         IDEV_SNAPSHOT_MUTEX_TIMEOUT_MS; DATA_NOT_READY if nothing was
+     *         published yet
+     *
+     * @note Default implementation copies every requested type from its
+     *       published slot while holding getMutexInstance() once, so a
+     *       processData() that publishes under that mutex cannot interleave.
+     *       Each stamp comes from the same slot copy as its values. Types
+     *       excluded by getCapabilities() are skipped.
+     * @note Drivers without published slots must override this to copy all
+     *       types under a single getMutexInstance() acquisition
+     */
+    virtual DeviceResult<void> getSnapshot(DataTypeMask typeMask, DeviceSnapshot& snapshot) {
+        snapshot.clear();
+        if (typeMask == 0 || (typeMask & ~ALL_DATA_TYPES) != 0) {
+            return DeviceResult<void>(DeviceError::INVALID_PARAMETER);
+        }
+
+        const DeviceCapabilities& caps = getCapabilities();
+        const PublishedSlot* slots[NUM_DATA_TYPES] = {};
+        for (size_t i = 0; i < NUM_DATA_TYPES; i++) {
+            const auto dataType = static_cast<DeviceDataType>(i);
+            if ((typeMask & dataTypeBit(dataType)) == 0 || !caps.mayProvide(dataType)) {
+                continue;
+            }
+            slots[i] = getPublishedSlot(dataType);
+            if (slots[i] == nullptr) {
+                return DeviceResult<void>(DeviceError::NOT_SUPPORTED);
+            }
+        }
+
+        SemaphoreHandle_t mutex = getMutexInstance();
+        if (mutex == nullptr || xSemaphoreTake(mutex, pdMS_TO_TICKS(IDEV_SNAPSHOT_MUTEX_TIMEOUT_MS)) != pdTRUE) {
+            return DeviceResult<void>(DeviceError::MUTEX_ERROR);
+        }
+        for (size_t i = 0; i < NUM_DATA_TYPES; i++) {
+            if (slots[i] == nullptr || !slots[i]->hasValue()) {
+                continue;
+            }
+            PublishedData data;
+            uint32_t generation = 0;
+            slots[i]->read(data, &generation);
+            snapshot.values[i] = data.values;
+            snapshot.stamps[i].generation = generation;
+            snapshot.stamps[i].timestampUs = data.timestampUs;
+            snapshot.validMask |= dataTypeBit(static_cast<DeviceDataType>(i));
+        }
+        xSemaphoreGive(mutex);
+
+        if (snapshot.validMask == 0) {
+            return DeviceResult<void>(DeviceError::DATA_NOT_READY);
+        }
+        return DeviceResult<void>();
+    }
+
     /**
      * @brief Get scale divider for raw data interpretation
      *
@@ -292,6 +1281,93 @@ public:
         (void)channel;
         return getDataScaleDivider(dataType);
     }
+
+    /**
+     * @brief Retrieve a single channel as float
+     *
+     * @param dataType The type of data to retrieve
+     * @param channel The channel index (0-based)
+     * @return DeviceResult<float>; INVALID_PARAMETER if @p channel is out of range
+     *
+     * @note Matches the per-channel getDataScaleDivider(dataType, channel)
+     * @note Default implementation reads all channels through getDataStatic()
+     *       and indexes; override for an O(1), allocation-free read
+     */
+    virtual DeviceResult<float> getChannel(DeviceDataType dataType, uint8_t channel) {
+        auto result = getDataStatic(dataType);
+        if (!result.isOk()) {
+            return DeviceResult<float>(result.error());
+        }
+        if (channel >= result.value().size()) {
+            return DeviceResult<float>(DeviceError::INVALID_PARAMETER);
+        }
+        return DeviceResult<float>(result.value()[channel]);
+    }
+
+    /**
+     * @brief Retrieve a single channel as raw integer
+     *
+     * @param dataType The type of data to retrieve
+     * @param channel The channel index (0-based)
+     * @return DeviceResult<int16_t>; INVALID_PARAMETER if @p channel is out of range
+     *
+     * @note Interpret with getDataScaleDivider(dataType, channel)
+     * @note Default implementation reads all channels through getDataRawStatic()
+     */
+    virtual DeviceResult<int16_t> getChannelRaw(DeviceDataType dataType, uint8_t channel) {
+        auto result = getDataRawStatic(dataType);
+        if (!result.isOk()) {
+            return DeviceResult<int16_t>(result.error());
+        }
+        if (channel >= result.value().size()) {
+            return DeviceResult<int16_t>(DeviceError::INVALID_PARAMETER);
+        }
+        return DeviceResult<int16_t>(result.value()[channel]);
+    }
+
+    /**
+     * @brief Retrieve all channels as fixed-point values
+     *
+     * Float-free alternative to getData() for targets without an FPU: each
+     * raw value is paired with getDataScaleDivider(dataType, channel).
+     *
+     * @param dataType The type of data to retrieve
+     * @return DeviceResult<ScaledChannelValues> containing the readings
+     *
+     * @note Default implementation is built on getDataRawInto(), so it is
+     *       allocation-free with a published slot or an overridden raw read
+     */
+    virtual DeviceResult<ScaledChannelValues> getDataScaled(DeviceDataType dataType) {
+        int16_t raw[MAX_CHANNELS];
+        auto result = getDataRawInto(dataType, raw, MAX_CHANNELS);
+        if (!result.isOk()) {
+            return DeviceResult<ScaledChannelValues>(result.error());
+        }
+        ScaledChannelValues values;
+        values.resize(result.value());
+        for (size_t ch = 0; ch < result.value(); ch++) {
+            values[ch] = ScaledValue(raw[ch], getDataScaleDivider(dataType, static_cast<uint8_t>(ch)));
+        }
+        return DeviceResult<ScaledChannelValues>(values);
+    }
+
+    /**
+     * @brief Retrieve a single channel as a fixed-point value
+     *
+     * @param dataType The type of data to retrieve
+     * @param channel The channel index (0-based)
+     * @return DeviceResult<ScaledValue>; INVALID_PARAMETER if @p channel is out of range
+     *
+     * @note Default implementation combines getChannelRaw() with the
+     *       per-channel divider
+     */
+    virtual DeviceResult<ScaledValue> getChannelScaled(DeviceDataType dataType, uint8_t channel) {
+        auto result = getChannelRaw(dataType, channel);
+        if (!result.isOk()) {
+            return DeviceResult<ScaledValue>(result.error());
+        }
+        return DeviceResult<ScaledValue>(ScaledValue(result.value(), getDataScaleDivider(dataType, channel)));
+    }
     
     /**
      * @brief Get the instance-level mutex
@@ -327,6 +1403,43 @@ public:
      */
     virtual EventGroupHandle_t getEventGroup() const noexcept = 0;
 
+    /**
+     * @brief Additionally signal data and errors on a shared event group
+     *
+     * In shared mode the driver sets @p dataReadyBit in @p group whenever it
+     * would signal new data on its own event group, and @p errorBit when a
+     * request fails. The own event group keeps working unchanged.
+     *
+     * @param group Shared event group, nullptr to detach
+     * @param dataReadyBit Bit assigned to this device for new data
+     * @param errorBit Bit assigned to this device for errors
+     * @return DeviceResult<void>; NOT_SUPPORTED if the driver has no shared mode
+     *
+     * @note Usually called by DeviceSharedEvents::add(); drivers typically
+     *       forward to an embedded DeviceSharedEventBinding
+     */
+    virtual DeviceResult<void> attachSharedEventGroup(EventGroupHandle_t group, EventBits_t dataReadyBit,
+                                                      EventBits_t errorBit) {
+        (void)group;
+        (void)dataReadyBit;
+        (void)errorBit;
+        return DeviceResult<void>(DeviceError::NOT_SUPPORTED);
+    }
+
+    /**
+     * @brief Get the device's performance counters
+     *
+     * Drivers embedding a DeviceStatistics (DeviceStatistics.h) return it
+     * here so monitoring code can read request/error counts and latency
+     * histograms of any device through the common interface.
+     *
+     * @return Statistics, or nullptr if the driver does not collect them
+     * @note Default returns nullptr
+     */
+    virtual const DeviceStatistics* getStatistics() const noexcept {
+        return nullptr;
+    }
+
     /**
      * @brief Perform a device-specific action
      * 
@@ -342,6 +1455,44 @@ public:
      */
     virtual DeviceResult<void> performAction(int actionId, int actionParam) = 0;
 
+    /**
+     * @brief Perform several device-specific actions as one batch
+     *
+     * Lets drivers map a group of actions (e.g. switching 3-4 relays for a
+     * boiler stage) onto a single bus transaction such as one Modbus
+     * multi-coil or multi-register write, under one mutex acquisition.
+     *
+     * @param batch Actions to perform, in order
+     * @param count Number of entries in @p batch
+     * @param results Optional - receives one DeviceError per entry
+     *        (must hold @p count entries)
+     * @return DeviceResult<void> - SUCCESS if every action succeeded,
+     *         otherwise the error of the first failed action;
+     *         INVALID_PARAMETER if @p batch is nullptr with a non-zero count
+     *
+     * @note Default implementation calls performAction() for every entry and
+     *       continues after failures; drivers that merge the batch should
+     *       keep the same per-item result semantics
+     */
+    virtual DeviceResult<void> performActions(const ActionRequest* batch, size_t count,
+                                              DeviceError* results = nullptr) {
+        if (batch == nullptr && count > 0) {
+            return DeviceResult<void>(DeviceError::INVALID_PARAMETER);
+        }
+        DeviceError firstError = DeviceError::SUCCESS;
+        for (size_t i = 0; i < count; i++) {
+            auto result = performAction(batch[i].actionId, batch[i].actionParam);
+            const DeviceError error = result.isOk() ? DeviceError::SUCCESS : result.error();
+            if (results != nullptr) {
+                results[i] = error;
+            }
+            if (firstError == DeviceError::SUCCESS) {
+                firstError = error;
+            }
+        }
+        return firstError == DeviceError::SUCCESS ? DeviceResult<void>() : DeviceResult<void>(firstError);
+    }
+
     /**
      * @brief Validate if a data type value is within valid range
      * 
@@ -408,10 +1559,29 @@ public:
      * @return DeviceResult<void> with appropriate error code
      * 
      * @note Implementation should support multiple callbacks
-     * @note Callbacks should be invoked from a separate task to avoid blocking
+     * @note Callbacks should be invoked from a separate task to avoid blocking;
+     *       DeviceEventDispatcher provides one shared task for all devices
      * @note Implementations can return UNKNOWN_ERROR for unsupported operations
      */
     virtual DeviceResult<void> registerCallback(EventCallback callback) = 0;
+
+    /**
+     * @brief Register an allocation-free callback
+     *
+     * Separate name rather than a registerCallback() overload, so drivers
+     * overriding only registerCallback(EventCallback) cannot hide it.
+     *
+     * @param callback The delegate to register
+     * @return DeviceResult<void> with appropriate error code
+     *
+     * @note Drivers typically store delegates in an EventCallbackTable, which
+     *       never allocates; MEMORY_ERROR signals a full table
+     * @note Default implementation returns NOT_SUPPORTED
+     */
+    virtual DeviceResult<void> registerDelegate(EventDelegate callback) {
+        (void)callback;
+        return DeviceResult<void>(DeviceError::NOT_SUPPORTED);
+    }
     
     /**
      * @brief Unregister all callbacks
@@ -433,6 +1603,154 @@ public:
      */
     virtual DeviceResult<void> setEventNotification(EventType eventType, bool enable) = 0;
 
+    /**
+     * @brief Suppress DATA_READY for changes within a deadband
+     *
+     * After this call DATA_READY for @p dataType fires only when at least
+     * one channel moved by more than @p threshold since it was last reported,
+     * or when @p maxSilenceMs passed without a report. customData then
+     * carries the ChannelMask of the reported channels.
+     *
+     * @param dataType The data type to filter
+     * @param threshold Minimum change in physical units (zero = report any change)
+     * @param maxSilenceMs Report at least this often even without change (0 = never)
+     * @return DeviceResult<void>; NOT_SUPPORTED if the driver does not filter
+     *
+     * @note Drivers typically forward to an embedded DeviceDeadband
+     */
+    virtual DeviceResult<void> setDeadband(DeviceDataType dataType, ScaledValue threshold,
+                                           uint32_t maxSilenceMs = 0) {
+        (void)dataType;
+        (void)threshold;
+        (void)maxSilenceMs;
+        return DeviceResult<void>(DeviceError::NOT_SUPPORTED);
+    }
+
+    /**
+     * @brief Remove the deadband for a data type (DATA_READY on every update)
+     * @param dataType The data type
+     * @return DeviceResult<void>; NOT_SUPPORTED if the driver does not filter
+     */
+    virtual DeviceResult<void> clearDeadband(DeviceDataType dataType) {
+        (void)dataType;
+        return DeviceResult<void>(DeviceError::NOT_SUPPORTED);
+    }
+
+protected:
+    IDeviceInstance() noexcept = default;
+
+    /**
+     * @brief Copy a value vector into a caller-provided buffer
+     *
+     * @tparam T Element type
+     * @param values Source values
+     * @param out Destination buffer
+     * @param capacity Number of elements available in @p out
+     * @return DeviceResult<size_t> with the number of values copied, or
+     *         INVALID_PARAMETER if the buffer is missing or too small
+     */
+    template<typename T>
+    static DeviceResult<size_t> copyToBuffer(const std::vector<T>& values, T* out, size_t capacity) noexcept {
+        if (out == nullptr || capacity < values.size()) {
+            return DeviceResult<size_t>(DeviceError::INVALID_PARAMETER);
+        }
+        for (size_t i = 0; i < values.size(); i++) {
+            out[i] = values[i];
+        }
+        return DeviceResult<size_t>(values.size());
+    }
+
+    /**
+     * @brief Copy one field of a published slot into a caller-provided buffer
+     *
+     * @param slot The publication slot to read
+     * @param field PublishedData::values or PublishedData::raw
+     * @param out Destination buffer
+     * @param capacity Number of elements available in @p out
+     * @param generation Optional - receives the generation of the copied data
+     * @return DeviceResult<size_t> with the number of values copied;
+     *         DATA_NOT_READY if nothing was published yet
+     */
+    template<typename Container, typename T>
+    static DeviceResult<size_t> readPublished(const PublishedSlot& slot,
+                                              Container PublishedData::*field,
+                                              T* out, size_t capacity,
+                                              uint32_t* generation = nullptr) noexcept {
+        if (out == nullptr) {
+            return DeviceResult<size_t>(DeviceError::INVALID_PARAMETER);
+        }
+        PublishedData data;
+        uint32_t version = 0;
+        if (!slot.read(data, &version)) {
+            return DeviceResult<size_t>(DeviceError::DATA_NOT_READY);
+        }
+        const Container& values = data.*field;
+        if (capacity < values.size()) {
+            return DeviceResult<size_t>(DeviceError::INVALID_PARAMETER);
+        }
+        for (size_t i = 0; i < values.size(); i++) {
+            out[i] = values[i];
+        }
+        if (generation != nullptr) {
+            *generation = version;
+        }
+        return DeviceResult<size_t>(values.size());
+    }
+
+    /**
+     * @brief Timestamp and publish new readings (call from processData())
+     *
+     * @param slot The slot returned by getPublishedSlot() for this type
+     * @param data The new readings; timestampUs is set to esp_timer_get_time()
+     * @note Publish while holding getMutexInstance() so the default
+     *       getSnapshot() never sees half of a processData() cycle
+     */
+    static void publishData(PublishedSlot& slot, PublishedData& data) noexcept {
+        data.timestampUs = esp_timer_get_time();
+        slot.publish(data);
+    }
+
+    /**
+     * @brief Read the values of a type together with their stamp
+     *
+     * With a published slot both come from one slot copy. Otherwise the
+     * stamp is read before and after getDataStatic() and the read is
+     * retried while processData() moved the generation in between.
+     *
+     * @param dataType The type of data
+     * @param stamp Optional - receives the stamp of the returned values
+     *        (left untouched if the driver does not track freshness)
+     */
+    DeviceResult<ChannelValues> readWithStamp(DeviceDataType dataType, DataStamp* stamp) {
+        if (const PublishedSlot* slot = getPublishedSlot(dataType)) {
+            PublishedData data;
+            uint32_t version = 0;
+            if (!slot->read(data, &version)) {
+                return DeviceResult<ChannelValues>(DeviceError::DATA_NOT_READY);
+            }
+            if (stamp != nullptr) {
+                stamp->generation = version;
+                stamp->timestampUs = data.timestampUs;
+            }
+            return DeviceResult<ChannelValues>(data.values);
+        }
+
+        for (int attempt = 0;; attempt++) {
+            auto before = getDataStamp(dataType);
+            auto values = getDataStatic(dataType);
+            if (!before.isOk() || stamp == nullptr || !values.isOk()) {
+                return values;
+            }
+            auto after = getDataStamp(dataType);
+            if ((after.isOk() && after.value().generation == before.value().generation) || attempt >= 3) {
+                *stamp = before.value();    // Never newer than the values
+                return values;
+            }
+        }
+    }
 };
 
+// getDataFresh() joins coalesced flights
+#include "DeviceRequestCoalescer.h"
+
 #endif // IDEVICEINSTANCE_H
@@ -5,7 +5,9 @@
  * This header provides flexible logging configuration with support for:
  * - ESP-IDF logging (default)
  * - Custom Logger via LogInterface (when USE_CUSTOM_LOGGER is defined)
+ * - Deferred binary logging (when IDEVICEINSTANCE_DEFERRED_LOG is defined)
  * - Debug level control (when IDEVICEINSTANCE_DEBUG is defined)
+ * - Span tracing of IDEV_TIME_* (when IDEVICEINSTANCE_TRACE is defined)
  * 
  * @version 1.5.0
  * @date 2025-01-21
@@ -33,8 +35,21 @@
     #define IDEV_LOG_LEVEL_V ESP_LOG_NONE  // Suppress
 #endif
 
-// Route to custom logger or ESP-IDF
-#ifdef USE_CUSTOM_LOGGER
+// Route to deferred binary log, custom logger or ESP-IDF
+#if defined(IDEVICEINSTANCE_DEFERRED_LOG)
+    // Store format pointer, timestamp, raw arguments and string copies; format later
+    #include "DeviceDeferredLog.h"
+    #define IDEV_LOG_E(...) IDEV_DEFERRED_LOG(ESP_LOG_ERROR, IDEV_LOG_TAG, __VA_ARGS__)
+    #define IDEV_LOG_W(...) IDEV_DEFERRED_LOG(ESP_LOG_WARN, IDEV_LOG_TAG, __VA_ARGS__)
+    #define IDEV_LOG_I(...) IDEV_DEFERRED_LOG(ESP_LOG_INFO, IDEV_LOG_TAG, __VA_ARGS__)
+    #ifdef IDEVICEINSTANCE_DEBUG
+        #define IDEV_LOG_D(...) IDEV_DEFERRED_LOG(ESP_LOG_DEBUG, IDEV_LOG_TAG, __VA_ARGS__)
+        #define IDEV_LOG_V(...) IDEV_DEFERRED_LOG(ESP_LOG_VERBOSE, IDEV_LOG_TAG, __VA_ARGS__)
+    #else
+        #define IDEV_LOG_D(...) ((void)0)
+        #define IDEV_LOG_V(...) ((void)0)
+    #endif
+#elif defined(USE_CUSTOM_LOGGER)
     #include <LogInterface.h>
     #define IDEV_LOG_E(...) LOG_WRITE(IDEV_LOG_LEVEL_E, IDEV_LOG_TAG, __VA_ARGS__)
     #define IDEV_LOG_W(...) LOG_WRITE(IDEV_LOG_LEVEL_W, IDEV_LOG_TAG, __VA_ARGS__)
@@ -69,10 +84,19 @@
     #define IDEVICEINSTANCE_DEBUG_DATA       // Data dumps
 #endif
 
-// Performance timing macros
-#ifdef IDEVICEINSTANCE_DEBUG_TIMING
-    #define IDEV_TIME_START() unsigned long _idev_start = millis()
-    #define IDEV_TIME_END(msg) IDEV_LOG_D("Timing: %s took %lu ms", msg, millis() - _idev_start)
+// Performance timing macros (microsecond resolution via esp_timer)
+// With IDEVICEINSTANCE_TRACE the measurement is recorded as a DeviceTrace
+// span instead of being logged, so it does not distort the timing.
+#if defined(IDEVICEINSTANCE_TRACE)
+    #include "DeviceTrace.h"
+    #define IDEV_TIME_START() const uint32_t _idev_start = DeviceTrace::nowUs()
+    #define IDEV_TIME_END(msg) \
+        DeviceTrace::instance().record(msg, _idev_start, DeviceTrace::nowUs() - _idev_start)
+#elif defined(IDEVICEINSTANCE_DEBUG_TIMING)
+    #include <esp_timer.h>
+    #define IDEV_TIME_START() const int64_t _idev_start = esp_timer_get_time()
+    #define IDEV_TIME_END(msg) IDEV_LOG_D("Timing: %s took %lld us", msg, \
+                                          static_cast<long long>(esp_timer_get_time() - _idev_start))
 #else
     #define IDEV_TIME_START() ((void)0)
     #define IDEV_TIME_END(msg) ((void)0)
@@ -86,7 +110,11 @@
 #endif
 
 // Data dump macro
-#ifdef IDEVICEINSTANCE_DEBUG_DATA
+#if defined(IDEVICEINSTANCE_DEBUG_DATA) && defined(IDEVICEINSTANCE_DEFERRED_LOG)
+    // One raw binary record instead of a log line per byte
+    #define IDEV_DUMP_DATA(msg, data, len) \
+        DeviceDeferredLog::instance().dump(ESP_LOG_DEBUG, IDEV_LOG_TAG, msg, data, len)
+#elif defined(IDEVICEINSTANCE_DEBUG_DATA)
     #define IDEV_DUMP_DATA(msg, data, len) do { \
         IDEV_LOG_D("%s (%d bytes):", msg, len); \
         for (int _i = 0; _i < len && _i < 32; _i++) { \
@@ -0,0 +1,232 @@
+/**
+ * @file ScaledValue.h
+ * @brief Integer fixed-point value for raw device readings
+ *
+ * Carries a raw int16 reading together with its scale divider, so control
+ * logic can compare, combine and print readings on targets without an FPU
+ * (ESP32-C3/C6) without ever converting to float.
+ *
+ * @code
+ * auto temp = device->getChannelScaled(IDeviceInstance::DeviceDataType::TEMPERATURE, 0);
+ * if (temp.isOk() && temp.value() > ScaledValue::fromInteger(60)) {
+ *     // 2205/100 vs 60/1: compared by cross-multiplication, no float
+ * }
+ * char text[ScaledValue::FORMAT_BUFFER_SIZE];
+ * temp.value().format(text, sizeof(text));    // "22.05"
+ * @endcode
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef SCALED_VALUE_H
+#define SCALED_VALUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @class ScaledValue
+ * @brief Fixed-point reading: value = raw / divider
+ *
+ * - All operations use integer math only (no float, no soft-float calls)
+ * - Comparisons are exact across different dividers
+ * - Arithmetic results use the finer of the two dividers and saturate at
+ *   the int16 range, matching what getDataRaw() can represent
+ *
+ * Trivially copyable (4 bytes), so it fits StaticVector and queues.
+ */
+class ScaledValue {
+public:
+    /**
+     * @brief Buffer size that fits any formatted value (at most 9 chars + NUL, e.g. "-16383.50")
+     */
+    static constexpr size_t FORMAT_BUFFER_SIZE = 12;
+
+    constexpr ScaledValue() noexcept : raw_(0), divider_(1) {}
+
+    /**
+     * @brief Construct from a raw reading and its divider
+     * @param raw Raw value as returned by getDataRaw()/getChannelRaw()
+     * @param divider Value of getDataScaleDivider(); values below 1 are treated as 1
+     */
+    constexpr ScaledValue(int16_t raw, int16_t divider) noexcept
+        : raw_(raw), divider_(divider > 0 ? divider : int16_t(1)) {}
+
+    /**
+     * @brief Construct a whole number (e.g. a setpoint) at a given resolution
+     * @param whole Whole-unit value
+     * @param divider Resolution of the result (default 1)
+     * @note Saturates if whole * divider exceeds the int16 range
+     */
+    static constexpr ScaledValue fromInteger(int32_t whole, int16_t divider = 1) noexcept {
+        return ScaledValue(saturate(static_cast<int64_t>(whole) * (divider > 0 ? divider : 1)), divider);
+    }
+
+    constexpr int16_t raw() const noexcept { return raw_; }
+    constexpr int16_t divider() const noexcept { return divider_; }
+
+    /**
+     * @brief Whole part, truncated toward zero (2205/100 -> 22, -55/10 -> -5)
+     */
+    constexpr int32_t wholePart() const noexcept { return raw_ / divider_; }
+
+    /**
+     * @brief Magnitude of the fractional part in units of 1/divider (2205/100 -> 5)
+     */
+    constexpr int32_t fractionPart() const noexcept {
+        return raw_ % divider_ < 0 ? -(raw_ % divider_) : raw_ % divider_;
+    }
+
+    /**
+     * @brief Value expressed in 1/targetDivider units, rounded half away from zero
+     *
+     * Typical use: `value.toUnits(10)` gives tenths of a degree as int32
+     * regardless of whether the channel reports tenths or hundredths.
+     */
+    constexpr int32_t toUnits(int16_t targetDivider) const noexcept {
+        return targetDivider == divider_
+                   ? raw_
+                   : roundedDiv(static_cast<int32_t>(raw_) * (targetDivider > 0 ? targetDivider : 1), divider_);
+    }
+
+    /**
+     * @brief Same value at a different resolution (rounded, saturating)
+     */
+    constexpr ScaledValue rescale(int16_t newDivider) const noexcept {
+        return ScaledValue(saturate(toUnits(newDivider)), newDivider);
+    }
+
+    /**
+     * @brief Convert to float for display paths that already use the FPU
+     * @note Not used by any ScaledValue operation
+     */
+    float toFloat() const noexcept {
+        return static_cast<float>(raw_) / static_cast<float>(divider_);
+    }
+
+    /**
+     * @brief Three-way comparison without float or precision loss
+     * @return <0, 0 or >0
+     */
+    static constexpr int32_t compare(const ScaledValue& a, const ScaledValue& b) noexcept {
+        return static_cast<int32_t>(a.raw_) * b.divider_ - static_cast<int32_t>(b.raw_) * a.divider_;
+    }
+
+    friend constexpr bool operator==(const ScaledValue& a, const ScaledValue& b) noexcept { return compare(a, b) == 0; }
+    friend constexpr bool operator!=(const ScaledValue& a, const ScaledValue& b) noexcept { return compare(a, b) != 0; }
+    friend constexpr bool operator<(const ScaledValue& a, const ScaledValue& b) noexcept { return compare(a, b) < 0; }
+    friend constexpr bool operator<=(const ScaledValue& a, const ScaledValue& b) noexcept { return compare(a, b) <= 0; }
+    friend constexpr bool operator>(const ScaledValue& a, const ScaledValue& b) noexcept { return compare(a, b) > 0; }
+    friend constexpr bool operator>=(const ScaledValue& a, const ScaledValue& b) noexcept { return compare(a, b) >= 0; }
+
+    constexpr ScaledValue operator-() const noexcept {
+        return ScaledValue(saturate(-static_cast<int32_t>(raw_)), divider_);
+    }
+
+    friend constexpr ScaledValue operator+(const ScaledValue& a, const ScaledValue& b) noexcept {
+        return combine(a, b, 1);
+    }
+
+    friend constexpr ScaledValue operator-(const ScaledValue& a, const ScaledValue& b) noexcept {
+        return combine(a, b, -1);
+    }
+
+    /**
+     * @brief Scale by an integer factor (e.g. averaging weights)
+     */
+    friend constexpr ScaledValue operator*(const ScaledValue& a, int32_t factor) noexcept {
+        return ScaledValue(saturate(static_cast<int64_t>(a.raw_) * factor), a.divider_);
+    }
+
+    /**
+     * @brief Divide by an integer (rounded half away from zero; divisor 0 returns the value unchanged)
+     */
+    friend constexpr ScaledValue operator/(const ScaledValue& a, int32_t divisor) noexcept {
+        return divisor == 0 ? a : ScaledValue(saturate(roundedDiv(a.raw_, divisor)), a.divider_);
+    }
+
+    ScaledValue& operator+=(const ScaledValue& other) noexcept { return *this = *this + other; }
+    ScaledValue& operator-=(const ScaledValue& other) noexcept { return *this = *this - other; }
+
+    constexpr ScaledValue abs() const noexcept {
+        return raw_ < 0 ? -*this : *this;
+    }
+
+    /**
+     * @brief Format as decimal text without float ("22.05", "-0.5", "7")
+     *
+     * Power-of-ten dividers print exactly their number of fraction digits.
+     * Other dividers print two decimals.
+     *
+     * @param buffer Destination (FORMAT_BUFFER_SIZE always suffices)
+     * @param capacity Size of @p buffer in bytes
+     * @return Characters written excluding the terminator (0 if @p buffer is
+     *         nullptr or too small)
+     */
+    size_t format(char* buffer, size_t capacity) const noexcept {
+        if (buffer == nullptr || capacity == 0) {
+            return 0;
+        }
+        int16_t div = divider_;
+        int32_t units = raw_;
+        int digits = decimalDigits(div);
+        if (digits < 0) {
+            div = 100;
+            units = toUnits(div);
+            digits = 2;
+        }
+        const bool negative = units < 0;
+        const int32_t magnitude = negative ? -units : units;
+        int written;
+        if (digits == 0) {
+            written = snprintf(buffer, capacity, "%s%ld", negative ? "-" : "",
+                               static_cast<long>(magnitude));
+        } else {
+            written = snprintf(buffer, capacity, "%s%ld.%0*ld", negative ? "-" : "",
+                               static_cast<long>(magnitude / div), digits, static_cast<long>(magnitude % div));
+        }
+        if (written < 0 || static_cast<size_t>(written) >= capacity) {
+            buffer[0] = '\0';
+            return 0;
+        }
+        return static_cast<size_t>(written);
+    }
+
+private:
+    static constexpr int16_t saturate(int64_t value) noexcept {
+        return value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : static_cast<int16_t>(value));
+    }
+
+    static constexpr int32_t roundedDiv(int32_t numerator, int32_t denominator) noexcept {
+        return (numerator < 0) == (denominator < 0)
+                   ? (numerator + denominator / 2) / denominator
+                   : (numerator - denominator / 2) / denominator;
+    }
+
+    /**
+     * @brief Number of decimal digits for a power-of-ten divider, -1 otherwise
+     */
+    static constexpr int decimalDigits(int16_t divider) noexcept {
+        return divider == 1 ? 0
+             : divider == 10 ? 1
+             : divider == 100 ? 2
+             : divider == 1000 ? 3
+             : divider == 10000 ? 4
+             : -1;
+    }
+
+    static constexpr ScaledValue combine(const ScaledValue& a, const ScaledValue& b, int32_t sign) noexcept {
+        return a.divider_ == b.divider_
+                   ? ScaledValue(saturate(static_cast<int32_t>(a.raw_) + sign * b.raw_), a.divider_)
+                   : a.divider_ > b.divider_
+                         ? ScaledValue(saturate(static_cast<int32_t>(a.raw_) + sign * b.toUnits(a.divider_)), a.divider_)
+                         : ScaledValue(saturate(a.toUnits(b.divider_) + sign * static_cast<int32_t>(b.raw_)), b.divider_);
+    }
+
+    int16_t raw_;
+    int16_t divider_;
+};
+
+#endif // SCALED_VALUE_H
@@ -0,0 +1,449 @@
+/**
+ * @file DeviceBenchmark.h
+ * @brief On-target benchmark harness for IDeviceInstance implementations
+ *
+ * Times individual interface calls with the CPU cycle counter and
+ * throughput with esp_timer, reporting min/p50/p99/max per method. It also
+ * measures lock contention with reader/writer tasks pinned to each core.
+ * Works with any IDeviceInstance - mocks as well as real drivers.
+ *
+ * @code
+ * DeviceBenchmark::Stats stats[DeviceBenchmark::MAX_METHODS];
+ * size_t n = DeviceBenchmark::benchmarkDevice(&mb8art, IDeviceInstance::DeviceDataType::TEMPERATURE,
+ *                                             stats, DeviceBenchmark::MAX_METHODS);
+ * DeviceBenchmark::printHeader();
+ * for (size_t i = 0; i < n; i++) DeviceBenchmark::printStats(stats[i]);
+ *
+ * DeviceBenchmark::ContentionConfig config;
+ * config.readersPerCore = 2;
+ * config.writersPerCore = 1;
+ * DeviceBenchmark::printContention(DeviceBenchmark::measureContention(&mb8art, config));
+ * @endcode
+ *
+ * @note The cycle counter is per core: run the benchmarks from a task
+ *       pinned to one core
+ */
+
+#ifndef DEVICE_BENCHMARK_H
+#define DEVICE_BENCHMARK_H
+
+#include "../src/IDeviceInstance.h"
+#include "freertos/task.h"
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+
+/**
+ * @brief Latency samples kept per measurement (older samples are overwritten)
+ */
+#ifndef IDEV_BENCH_MAX_SAMPLES
+#define IDEV_BENCH_MAX_SAMPLES 1024
+#endif
+
+namespace DeviceBenchmark {
+
+using DeviceDataType = IDeviceInstance::DeviceDataType;
+
+static constexpr size_t MAX_SAMPLES = IDEV_BENCH_MAX_SAMPLES;
+
+/// Number of Stats entries benchmarkDevice() can produce
+static constexpr size_t MAX_METHODS = 9;
+
+/**
+ * @brief Current CPU cycle count of the calling core
+ */
+inline uint32_t cycles() {
+    return static_cast<uint32_t>(esp_cpu_get_cycle_count());
+}
+
+/**
+ * @brief CPU cycles per microsecond
+ */
+inline uint32_t cyclesPerUs() {
+    const uint32_t perUs = esp_rom_get_cpu_ticks_per_us();
+    return perUs > 0 ? perUs : 1;
+}
+
+/**
+ * @brief Summary of one measurement
+ */
+struct Stats {
+    const char* name = "";
+    uint32_t operations = 0;        ///< Calls made (samples may be fewer)
+    uint32_t errors = 0;            ///< Calls reporting failure
+    uint32_t minCycles = 0;
+    uint32_t p50Cycles = 0;
+    uint32_t p99Cycles = 0;
+    uint32_t maxCycles = 0;
+    uint32_t meanCycles = 0;
+    float opsPerSecond = 0.0f;      ///< Wall-clock throughput (esp_timer)
+
+    float toUs(uint32_t cycleCount) const {
+        return static_cast<float>(cycleCount) / static_cast<float>(cyclesPerUs());
+    }
+};
+
+/**
+ * @class SampleBuffer
+ * @brief Fixed-capacity latency recorder (cycles)
+ */
+class SampleBuffer {
+public:
+    SampleBuffer() : count_(0), operations_(0), errors_(0), sum_(0) {}
+
+    void add(uint32_t cycleCount, bool ok) {
+        samples_[count_ % MAX_SAMPLES] = cycleCount;
+        count_++;
+        operations_++;
+        sum_ += cycleCount;
+        if (!ok) {
+            errors_++;
+        }
+    }
+
+    /**
+     * @brief Append all samples and counters of @p other
+     */
+    void merge(const SampleBuffer& other) {
+        const size_t n = std::min<size_t>(other.count_, MAX_SAMPLES);
+        for (size_t i = 0; i < n; i++) {
+            samples_[count_ % MAX_SAMPLES] = other.samples_[i];
+            count_++;
+        }
+        operations_ += other.operations_;
+        errors_ += other.errors_;
+        sum_ += other.sum_;
+    }
+
+    uint32_t operations() const { return operations_; }
+
+    /**
+     * @brief Compute percentiles (sorts the stored samples)
+     * @param name Label for the result
+     * @param elapsedUs Wall-clock duration for the throughput figure
+     */
+    Stats summarize(const char* name, int64_t elapsedUs) {
+        Stats stats;
+        stats.name = name;
+        stats.operations = operations_;
+        stats.errors = errors_;
+        const size_t n = std::min<size_t>(count_, MAX_SAMPLES);
+        if (n == 0) {
+            return stats;
+        }
+        std::sort(samples_, samples_ + n);
+        stats.minCycles = samples_[0];
+        stats.p50Cycles = samples_[(n - 1) / 2];
+        stats.p99Cycles = samples_[((n - 1) * 99) / 100];
+        stats.maxCycles = samples_[n - 1];
+        stats.meanCycles = static_cast<uint32_t>(sum_ / operations_);
+        if (elapsedUs > 0) {
+            stats.opsPerSecond = static_cast<float>(operations_) * 1e6f / static_cast<float>(elapsedUs);
+        }
+        return stats;
+    }
+
+private:
+    uint32_t samples_[MAX_SAMPLES];
+    uint32_t count_;
+    uint32_t operations_;
+    uint32_t errors_;
+    uint64_t sum_;
+};
+
+/**
+ * @brief Time @p iterations calls of @p fn
+ *
+ * @param name Label for the result
+ * @param iterations Number of timed calls (after 4 warm-up calls)
+ * @param fn Callable returning true on success
+ */
+template<typename Fn>
+Stats measure(const char* name, uint32_t iterations, Fn&& fn) {
+    std::unique_ptr<SampleBuffer> buffer(new SampleBuffer());
+    for (int i = 0; i < 4; i++) {
+        fn();
+    }
+    const int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < iterations; i++) {
+        const uint32_t c0 = cycles();
+        const bool ok = fn();
+        const uint32_t c1 = cycles();
+        buffer->add(c1 - c0, ok);
+    }
+    return buffer->summarize(name, esp_timer_get_time() - start);
+}
+
+/**
+ * @brief Benchmark the standard interface methods of a device
+ *
+ * Covers isInitialized, getData, getDataRaw, getDataInto, getDataRawInto,
+ * getChannel, getSnapshot, instance mutex take/give and the full
+ * requestData/waitForData/processData cycle (initializing the device first
+ * if needed). Methods the driver does not support show up as errors.
+ *
+ * @param device Device under test
+ * @param dataType Data type to read
+ * @param out Results (up to MAX_METHODS)
+ * @param capacity Size of @p out
+ * @param iterations Calls per data-path method
+ * @param cycleIterations Full request/process cycles (these hit the bus)
+ * @param responseTimeout waitForData() timeout per cycle
+ * @return Number of Stats written
+ */
+inline size_t benchmarkDevice(IDeviceInstance* device, DeviceDataType dataType,
+                              Stats* out, size_t capacity,
+                              uint32_t iterations = 500, uint32_t cycleIterations = 20,
+                              TickType_t responseTimeout = pdMS_TO_TICKS(1000)) {
+    if (device == nullptr || out == nullptr) {
+        return 0;
+    }
+    if (!device->isInitialized()) {
+        device->initialize();
+    }
+    size_t n = 0;
+    auto add = [&](const Stats& stats) {
+        if (n < capacity) {
+            out[n++] = stats;
+        }
+    };
+
+    float values[IDeviceInstance::MAX_CHANNELS];
+    int16_t raw[IDeviceInstance::MAX_CHANNELS];
+    IDeviceInstance::DeviceSnapshot snapshot;
+
+    add(measure("isInitialized", iterations, [&] { return device->isInitialized(); }));
+    add(measure("getData", iterations, [&] { return device->getData(dataType).isOk(); }));
+    add(measure("getDataRaw", iterations, [&] { return device->getDataRaw(dataType).isOk(); }));
+    add(measure("getDataInto", iterations, [&] {
+        return device->getDataInto(dataType, values, IDeviceInstance::MAX_CHANNELS).isOk();
+    }));
+    add(measure("getDataRawInto", iterations, [&] {
+        return device->getDataRawInto(dataType, raw, IDeviceInstance::MAX_CHANNELS).isOk();
+    }));
+    add(measure("getChannel", iterations, [&] { return device->getChannel(dataType, 0).isOk(); }));
+    add(measure("getSnapshot", iterations, [&] {
+        return device->getSnapshot(IDeviceInstance::dataTypeBit(dataType), snapshot).isOk();
+    }));
+    SemaphoreHandle_t mutex = device->getMutexInstance();
+    add(measure("mutexInstance take/give", iterations, [&] {
+        if (mutex == nullptr || xSemaphoreTake(mutex, portMAX_DELAY) != pdTRUE) {
+            return false;
+        }
+        xSemaphoreGive(mutex);
+        return true;
+    }));
+    add(measure("request/wait/process", cycleIterations, [&] {
+        return device->requestData().isOk() &&
+               device->waitForData(responseTimeout) == IDeviceInstance::DeviceError::SUCCESS &&
+               device->processData().isOk();
+    }));
+    return n;
+}
+
+/**
+ * @brief Reader/writer contention setup
+ */
+struct ContentionConfig {
+    uint8_t readersPerCore = 1;         ///< Tasks per core calling getDataInto()
+    uint8_t writersPerCore = 0;         ///< Tasks per core running request/wait/process
+    uint32_t durationMs = 1000;         ///< Measurement window
+    UBaseType_t priority = 5;           ///< Priority of all benchmark tasks
+    uint32_t stackSize = 4096;          ///< Stack per task in bytes
+    DeviceDataType dataType = DeviceDataType::TEMPERATURE;
+    TickType_t responseTimeout = pdMS_TO_TICKS(1000);
+};
+
+/**
+ * @brief Result of measureContention()
+ */
+struct ContentionResult {
+    Stats baselineRead;                 ///< getDataInto() with no other tasks
+    Stats contendedRead;                ///< getDataInto() across all reader tasks
+    Stats write;                        ///< request/wait/process across all writer tasks
+    uint32_t readerTasks = 0;
+    uint32_t writerTasks = 0;
+    int32_t contentionCostCycles = 0;   ///< contendedRead.p50 - baselineRead.p50
+    bool completed = false;             ///< false if a task did not stop in time
+};
+
+namespace detail {
+
+struct ContentionRun {
+    IDeviceInstance* device;
+    ContentionConfig config;    // Copy: tasks may outlive the caller's config
+    std::atomic<bool> stop;
+    SemaphoreHandle_t done;
+};
+
+struct ContentionWorker {
+    ContentionRun* run;
+    bool writer;
+    SampleBuffer samples;
+};
+
+inline void contentionTask(void* param) {
+    auto* worker = static_cast<ContentionWorker*>(param);
+    ContentionRun* run = worker->run;
+    IDeviceInstance* device = run->device;
+    float values[IDeviceInstance::MAX_CHANNELS];
+    while (!run->stop.load(std::memory_order_relaxed)) {
+        const uint32_t c0 = cycles();
+        bool ok;
+        if (worker->writer) {
+            ok = device->requestData().isOk() &&
+                 device->waitForData(run->config.responseTimeout) == IDeviceInstance::DeviceError::SUCCESS &&
+                 device->processData().isOk();
+        } else {
+            ok = device->getDataInto(run->config.dataType, values, IDeviceInstance::MAX_CHANNELS).isOk();
+        }
+        const uint32_t c1 = cycles();
+        worker->samples.add(c1 - c0, ok);
+        if (!worker->writer) {
+            taskYIELD();  // Let equal-priority tasks on this core interleave
+        }
+    }
+    xSemaphoreGive(run->done);
+    vTaskDelete(nullptr);
+}
+
+} // namespace detail
+
+/**
+ * @brief Measure read latency/throughput under concurrent readers and writers
+ *
+ * Starts readersPerCore + writersPerCore tasks pinned to every core, lets
+ * them run for durationMs and aggregates their samples. The cost of
+ * contention is the p50 read latency increase over an uncontended baseline.
+ *
+ * @param device Device under test (initialized if needed)
+ * @param config Task counts, duration and priority
+ */
+inline ContentionResult measureContention(IDeviceInstance* device,
+                                          const ContentionConfig& config = ContentionConfig()) {
+    ContentionResult result;
+    if (device == nullptr) {
+        return result;
+    }
+    if (!device->isInitialized()) {
+        device->initialize();
+    }
+
+    float values[IDeviceInstance::MAX_CHANNELS];
+    result.baselineRead = measure("getDataInto (baseline)", 500, [&] {
+        return device->getDataInto(config.dataType, values, IDeviceInstance::MAX_CHANNELS).isOk();
+    });
+
+    const size_t perCore = static_cast<size_t>(config.readersPerCore) + config.writersPerCore;
+    const size_t total = perCore * portNUM_PROCESSORS;
+    if (total == 0) {
+        result.completed = true;
+        return result;
+    }
+
+    auto* run = new detail::ContentionRun();
+    run->device = device;
+    run->config = config;
+    run->stop.store(false);
+    run->done = xSemaphoreCreateCounting(total, 0);
+    if (run->done == nullptr) {
+        IDEV_LOG_E("Benchmark: completion semaphore creation failed");
+        delete run;
+        return result;
+    }
+    std::unique_ptr<detail::ContentionWorker[]> workers(new detail::ContentionWorker[total]);
+
+    size_t started = 0;
+    const int64_t start = esp_timer_get_time();
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++) {
+        for (size_t i = 0; i < perCore; i++) {
+            detail::ContentionWorker& worker = workers[started];
+            worker.run = run;
+            worker.writer = i >= config.readersPerCore;
+            if (xTaskCreatePinnedToCore(&detail::contentionTask, worker.writer ? "BenchW" : "BenchR",
+                                        config.stackSize, &worker, config.priority, nullptr, core) != pdPASS) {
+                IDEV_LOG_E("Benchmark task creation failed");
+                continue;
+            }
+            started++;
+            if (worker.writer) {
+                result.writerTasks++;
+            } else {
+                result.readerTasks++;
+            }
+        }
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(config.durationMs));
+    run->stop.store(true);
+    size_t finished = 0;
+    const TickType_t grace = pdMS_TO_TICKS(config.durationMs) + config.responseTimeout * 2;
+    while (finished < started && xSemaphoreTake(run->done, grace) == pdTRUE) {
+        finished++;
+    }
+    const int64_t elapsed = esp_timer_get_time() - start;
+
+    std::unique_ptr<SampleBuffer> reads(new SampleBuffer());
+    std::unique_ptr<SampleBuffer> writes(new SampleBuffer());
+    for (size_t i = 0; i < started; i++) {
+        (workers[i].writer ? writes : reads)->merge(workers[i].samples);
+    }
+    result.contendedRead = reads->summarize("getDataInto (contended)", elapsed);
+    result.write = writes->summarize("request/wait/process (contended)", elapsed);
+    result.contentionCostCycles = static_cast<int32_t>(result.contendedRead.p50Cycles) -
+                                  static_cast<int32_t>(result.baselineRead.p50Cycles);
+    result.completed = finished == started;
+
+    if (result.completed) {
+        vSemaphoreDelete(run->done);
+        delete run;
+    } else {
+        // Tasks still reference run/workers - leak rather than free under them
+        IDEV_LOG_E("Benchmark: %u of %u tasks did not stop", static_cast<unsigned>(started - finished),
+                   static_cast<unsigned>(started));
+        workers.release();
+    }
+    return result;
+}
+
+/**
+ * @brief Print the column header for printStats()
+ */
+inline void printHeader() {
+    printf("%-34s %8s %6s %9s %9s %9s %9s %12s\n",
+           "Method", "Ops", "Errors", "min(us)", "p50(us)", "p99(us)", "max(us)", "ops/s");
+}
+
+/**
+ * @brief Print one result line
+ */
+inline void printStats(const Stats& stats) {
+    printf("%-34s %8u %6u %9.2f %9.2f %9.2f %9.2f %12.0f\n", stats.name,
+           static_cast<unsigned>(stats.operations), static_cast<unsigned>(stats.errors),
+           stats.toUs(stats.minCycles), stats.toUs(stats.p50Cycles),
+           stats.toUs(stats.p99Cycles), stats.toUs(stats.maxCycles),
+           static_cast<double>(stats.opsPerSecond));
+}
+
+/**
+ * @brief Print a contention result
+ */
+inline void printContention(const ContentionResult& result) {
+    printf("Contention: %u reader(s), %u writer(s)%s\n", static_cast<unsigned>(result.readerTasks),
+           static_cast<unsigned>(result.writerTasks), result.completed ? "" : " (incomplete)");
+    printHeader();
+    printStats(result.baselineRead);
+    printStats(result.contendedRead);
+    if (result.writerTasks > 0) {
+        printStats(result.write);
+    }
+    printf("Contention cost (p50): %ld cycles (%.2f us)\n", static_cast<long>(result.contentionCostCycles),
+           static_cast<double>(result.contentionCostCycles) / cyclesPerUs());
+}
+
+} // namespace DeviceBenchmark
+
+#endif // DEVICE_BENCHMARK_H
@@ -1,289 +1,350 @@
 /**
  * @file MockDeviceInstance.h
- * @brief Mock implementation of IDeviceInstance for unit testing
- * 
+ * @brief Mock implementation of IDeviceInstance for unit and load testing
+ *
  * This mock class provides a configurable test double for IDeviceInstance
- * that can simulate various behaviors and error conditions.
+ * that can simulate various behaviors and error conditions, from a fixed
+ * delay up to production-like load: jittery latency with tail spikes,
+ * random errors, a bus shared with other mocks and high-rate data streams.
+ *
+ * @code
+ * SemaphoreHandle_t rs485 = xSemaphoreCreateMutex();
+ * MockDeviceInstance mb8art, ryn4;
+ * for (auto* mock : {&mb8art, &ryn4}) {
+ *     mock->shareInterfaceMutex(rs485);                          // requests contend for the bus
+ *     mock->setDataLatency(MockDeviceInstance::LatencyProfile(20000, 5000, 10, 200000));
+ *     mock->setErrorRate(IDeviceInstance::DeviceError::TIMEOUT, 5);              // 0.5 % lost responses
+ *     mock->setErrorRate(IDeviceInstance::DeviceError::COMMUNICATION_ERROR, 10); // 1 % CRC errors
+ * }
+ * @endcode
  */
 
 #ifndef MOCK_DEVICE_INSTANCE_H
 #define MOCK_DEVICE_INSTANCE_H
 
 #include "../src/IDeviceInstance.h"
+#include "esp_rom_sys.h"
+#include <atomic>
 #include <map>
-#include <queue>
-#include <chrono>
+#include <vector>
 
 /**
  * @class MockDeviceInstance
  * @brief Mock implementation for testing IDeviceInstance consumers
- * 
+ *
  * Features:
  * - Configurable initialization behavior
- * - Simulated data acquisition with configurable delays
- * - Error injection capabilities
+ * - Simulated data acquisition with latency distributions (base, jitter, tail spikes)
+ * - One-shot and probabilistic per-DeviceError error injection
+ * - Bus contention through a shared interface mutex
+ * - Scripted data frames and autonomous high-rate streams
  * - Event notification testing
- * - Thread safety verification
+ * - Load statistics for comparing consumers
+ *
+ * Concurrent requestData() calls while a transaction is in flight join it.
+ * Transactions with non-zero latency run on the mock's worker task, which
+ * holds the interface mutex for the simulated bus time; callbacks are
+ * invoked synchronously from the task that completes the event.
+ *
+ * Random outcomes: TIMEOUT is a lost response (no event bit, waiters time
+ * out); any other error sets ERROR_BIT and is returned by waitForData().
  */
 class MockDeviceInstance : public IDeviceInstance {
-private:
-    // State management
-    bool initialized;
-    bool dataRequested;
-    bool dataProcessed;
-    
-    // Synchronization primitives
-    SemaphoreHandle_t mutexInstance;
-    SemaphoreHandle_t mutexInterface;
-    EventGroupHandle_t eventGroup;
-    
-    // Test data storage
-    std::map<DeviceDataType, std::vector<float>> testData;
-    
-    // Error injection
-    ErrorCode nextError;
-    bool shouldFailNext;
-    
-    // Callback storage
-    std::vector<EventCallback> callbacks;
-    bool eventsEnabled[5];  // For each EventType
-    
-    // Action tracking
-    std::vector<std::pair<int, int>> performedActions;
-    
-    // Timing simulation
-    TickType_t initDelay;
-    TickType_t dataDelay;
-    
+public:
     // Event bits
     static constexpr EventBits_t INIT_COMPLETE_BIT = BIT0;
     static constexpr EventBits_t DATA_READY_BIT = BIT1;
     static constexpr EventBits_t ERROR_BIT = BIT2;
 
-public:
+    /**
+     * @brief Latency distribution of one operation
+     *
+     * latency = baseUs + uniform[0, jitterUs] (+ tailUs with probability tailPermille / 1000)
+     */
+    struct LatencyProfile {
+        uint32_t baseUs;        ///< Minimum latency
+        uint32_t jitterUs;      ///< Uniformly distributed extra latency
+        uint16_t tailPermille;  ///< Probability of a tail spike in 1/1000
+        uint32_t tailUs;        ///< Extra latency of a tail spike
+
+        constexpr LatencyProfile(uint32_t base = 0, uint32_t jitter = 0, uint16_t tailPerMille = 0,
+                                 uint32_t tail = 0) noexcept
+            : baseUs(base), jitterUs(jitter), tailPermille(tailPerMille), tailUs(tail) {}
+
+        static constexpr LatencyProfile fixedMs(uint32_t ms) noexcept {
+            return LatencyProfile(ms * 1000);
+        }
+    };
+
+    /**
+     * @brief Load counters since construction or reset()
+     */
+    struct Stats {
+        uint32_t requests = 0;          ///< Transactions started
+        uint32_t joined = 0;            ///< requestData() calls that joined a transaction in flight
+        uint32_t completed = 0;         ///< Transactions that delivered data
+        uint32_t failed = 0;            ///< Transactions that ended with ERROR_BIT
+        uint32_t lost = 0;              ///< Transactions without response (TIMEOUT)
+        uint32_t streamSamples = 0;     ///< Samples emitted by startStream()
+        uint32_t maxLatencyUs = 0;      ///< Longest request-to-completion time
+        uint64_t totalLatencyUs = 0;    ///< Sum of request-to-completion times
+        uint64_t busWaitUs = 0;         ///< Time spent waiting for the interface mutex
+    };
+
     /**
      * @brief Constructor with configurable delays
      * @param initDelayMs Initialization delay in milliseconds
      * @param dataDelayMs Data acquisition delay in milliseconds
      */
-    MockDeviceInstance(uint32_t initDelayMs = 0, uint32_t dataDelayMs = 0) 
-        : initialized(false), dataRequested(false), dataProcessed(false),
-          nextError(ErrorCode::SUCCESS), shouldFailNext(false),
-          initDelay(pdMS_TO_TICKS(initDelayMs)), 
-          dataDelay(pdMS_TO_TICKS(dataDelayMs)) {
-        
+    MockDeviceInstance(uint32_t initDelayMs = 0, uint32_t dataDelayMs = 0)
+        : initialized(false), dataProcessed(false), inFlight(false), stopping(false),
+          transactionPending(false), shouldFailNext(false), streamPeriod(0), completedSamples(0),
+          nextError(DeviceError::SUCCESS), lastError(DeviceError::SUCCESS),
+          initLatency(LatencyProfile::fixedMs(initDelayMs)),
+          dataLatency(LatencyProfile::fixedMs(dataDelayMs)),
+          errorPermille(), rngState(0x2545F491u), transactionLatencyUs(0),
+          transactionOutcome(DeviceError::SUCCESS), requestStartUs(0), worker(nullptr) {
+
         mutexInstance = xSemaphoreCreateMutex();
-        mutexInterface = xSemaphoreCreateMutex();
+        ownInterfaceMutex = xSemaphoreCreateMutex();
+        mutexInterface = ownInterfaceMutex;
+        callbackMutex = xSemaphoreCreateMutex();
+        workerExited = xSemaphoreCreateBinary();
         eventGroup = xEventGroupCreate();
-        
+
         // Initialize all events as enabled
-        for (int i = 0; i < 5; i++) {
+        for (int i = 0; i < NUM_EVENT_TYPES; i++) {
             eventsEnabled[i] = true;
         }
-        
-        IDEV_LOG_D("MockDeviceInstance created with init delay %u ms, data delay %u ms", 
+
+        if (xTaskCreate(&MockDeviceInstance::workerEntry, "MockDevice", 3072, this, 1, &worker) != pdPASS) {
+            // Transactions then complete inline in requestData(); streams are unavailable
+            worker = nullptr;
+            IDEV_LOG_E("MockDevice worker task creation failed");
+        }
+
+        IDEV_LOG_D("MockDeviceInstance created with init delay %u ms, data delay %u ms",
                    initDelayMs, dataDelayMs);
     }
-    
-    ~MockDeviceInstance() {
-        if (mutexInstance) vSemaphoreDelete(mutexInstance);
-        if (mutexInterface) vSemaphoreDelete(mutexInterface);
-        if (eventGroup) vEventGroupDelete(eventGroup);
+
+    ~MockDeviceInstance() override {
+        stopping = true;
+        if (worker != nullptr) {
+            xTaskNotifyGive(worker);
+            xSemaphoreTake(workerExited, portMAX_DELAY);
+        }
+        vSemaphoreDelete(mutexInstance);
+        vSemaphoreDelete(ownInterfaceMutex);
+        vSemaphoreDelete(callbackMutex);
+        vSemaphoreDelete(workerExited);
+        vEventGroupDelete(eventGroup);
     }
-    
+
+    MockDeviceInstance(const MockDeviceInstance&) = delete;
+    MockDeviceInstance& operator=(const MockDeviceInstance&) = delete;
+
+    using IDeviceInstance::requestData;
+
     // Core interface implementation
-    void initialize() override {
-        if (xSemaphoreTake(mutexInstance, portMAX_DELAY) == pdTRUE) {
-            IDEV_LOG_I("MockDevice initializing...");
-            
-            // Simulate initialization delay
-            if (initDelay > 0) {
-                xSemaphoreGive(mutexInstance);
-                vTaskDelay(initDelay);
-                xSemaphoreTake(mutexInstance, portMAX_DELAY);
-            }
-            
-            initialized = true;
-            xEventGroupSetBits(eventGroup, INIT_COMPLETE_BIT);
-            
-            // Notify callbacks
-            notifyEvent(EventType::INITIALIZED, ErrorCode::SUCCESS);
-            
-            IDEV_LOG_I("MockDevice initialized");
-            xSemaphoreGive(mutexInstance);
+    DeviceResult<void> initialize() override {
+        if (initialized) {
+            return DeviceResult<void>();
         }
+        IDEV_LOG_I("MockDevice initializing...");
+        delayUs(drawLatency(initLatency));
+
+        initialized = true;
+        xEventGroupSetBits(eventGroup, INIT_COMPLETE_BIT);
+
+        // Notify callbacks
+        notifyEvent(EventType::INITIALIZED, DeviceError::SUCCESS);
+
+        IDEV_LOG_I("MockDevice initialized");
+        return DeviceResult<void>();
     }
-    
+
     bool isInitialized() const noexcept override {
         return initialized;
     }
-    
+
     void waitForInitialization() override {
         xEventGroupWaitBits(eventGroup, INIT_COMPLETE_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
     }
-    
-    ErrorCode waitForInitialization(TickType_t xTicksToWait) override {
+
+    DeviceError waitForInitialization(TickType_t xTicksToWait) override {
         EventBits_t bits = xEventGroupWaitBits(
             eventGroup, INIT_COMPLETE_BIT, pdFALSE, pdTRUE, xTicksToWait
         );
-        return (bits & INIT_COMPLETE_BIT) ? ErrorCode::SUCCESS : ErrorCode::TIMEOUT;
+        return (bits & INIT_COMPLETE_BIT) ? DeviceError::SUCCESS : DeviceError::TIMEOUT;
+    }
+
+    DeviceResult<void> waitForInitializationComplete(TickType_t timeout = portMAX_DELAY) override {
+        const DeviceError result = waitForInitialization(timeout);
+        return result == DeviceError::SUCCESS ? DeviceResult<void>() : DeviceResult<void>(result);
     }
-    
-    bool requestData() override {
+
+    DeviceResult<void> requestData() override {
         if (!initialized) {
             IDEV_LOG_E("Cannot request data - not initialized");
-            return false;
+            return DeviceResult<void>(DeviceError::NOT_INITIALIZED);
         }
-        
-        if (shouldFailNext) {
-            shouldFailNext = false;
-            notifyEvent(EventType::ERROR_OCCURRED, nextError);
-            return false;
+
+        if (shouldFailNext.exchange(false)) {
+            const DeviceError error = nextError;
+            notifyEvent(EventType::ERROR_OCCURRED, error);
+            return DeviceResult<void>(error);
         }
-        
-        if (xSemaphoreTake(mutexInterface, portMAX_DELAY) == pdTRUE) {
-            IDEV_LOG_D("Data request initiated");
-            dataRequested = true;
-            dataProcessed = false;
-            
-            // Clear previous data ready bit
-            xEventGroupClearBits(eventGroup, DATA_READY_BIT);
-            
-            // Simulate async data acquisition
-            if (dataDelay > 0) {
-                xTaskCreate([](void* param) {
-                    MockDeviceInstance* self = static_cast<MockDeviceInstance*>(param);
-                    vTaskDelay(self->dataDelay);
-                    xEventGroupSetBits(self->eventGroup, DATA_READY_BIT);
-                    self->notifyEvent(EventType::DATA_READY, ErrorCode::SUCCESS);
-                    vTaskDelete(nullptr);
-                }, "MockDataAcq", 2048, this, 1, nullptr);
-            } else {
-                xEventGroupSetBits(eventGroup, DATA_READY_BIT);
-                notifyEvent(EventType::DATA_READY, ErrorCode::SUCCESS);
-            }
-            
-            xSemaphoreGive(mutexInterface);
-            return true;
+
+        portENTER_CRITICAL(&lock);
+        if (inFlight) {
+            stats.joined++;
+            portEXIT_CRITICAL(&lock);
+            return DeviceResult<void>();
         }
-        
-        return false;
+        inFlight = true;
+        stats.requests++;
+        const uint32_t latency = drawLatencyLocked(dataLatency);
+        const DeviceError outcome = drawOutcomeLocked();
+        requestStartUs = esp_timer_get_time();
+        portEXIT_CRITICAL(&lock);
+
+        IDEV_LOG_D("Data request initiated");
+        dataProcessed = false;
+
+        // Clear bits of the previous transaction
+        xEventGroupClearBits(eventGroup, DATA_READY_BIT | ERROR_BIT);
+
+        if (latency == 0 || worker == nullptr) {
+            runTransaction(latency, outcome);
+        } else {
+            // Simulate async data acquisition on the worker task
+            transactionLatencyUs = latency;
+            transactionOutcome = outcome;
+            transactionPending = true;
+            xTaskNotifyGive(worker);
+        }
+        return DeviceResult<void>();
     }
-    
+
     bool waitForData() override {
-        EventBits_t bits = xEventGroupWaitBits(
-            eventGroup, DATA_READY_BIT | ERROR_BIT, pdFALSE, pdFALSE, portMAX_DELAY
-        );
-        return (bits & DATA_READY_BIT) != 0;
+        return waitForData(portMAX_DELAY) == DeviceError::SUCCESS;
     }
-    
-    ErrorCode waitForData(TickType_t xTicksToWait) override {
+
+    DeviceError waitForData(TickType_t xTicksToWait) override {
         EventBits_t bits = xEventGroupWaitBits(
             eventGroup, DATA_READY_BIT | ERROR_BIT, pdFALSE, pdFALSE, xTicksToWait
         );
-        
+
         if (bits & DATA_READY_BIT) {
-            return ErrorCode::SUCCESS;
+            return DeviceError::SUCCESS;
         } else if (bits & ERROR_BIT) {
-            return nextError;
+            return lastError;
         } else {
-            return ErrorCode::TIMEOUT;
+            return DeviceError::TIMEOUT;
         }
     }
-    
-    void processData() override {
-        if (xSemaphoreTake(mutexInstance, portMAX_DELAY) == pdTRUE) {
-            IDEV_LOG_D("Processing data");
-            dataProcessed = true;
-            xSemaphoreGive(mutexInstance);
+
+    DeviceResult<void> processData() override {
+        if (xSemaphoreTake(mutexInstance, portMAX_DELAY) != pdTRUE) {
+            return DeviceResult<void>(DeviceError::MUTEX_ERROR);
+        }
+        IDEV_LOG_D("Processing data");
+        const uint32_t samples = completedSamples.load();
+        for (const auto& entry : scripts) {
+            const Script& script = entry.second;
+            if (samples == 0 || script.frameCount == 0) {
+                continue;
+            }
+            const float* frame = script.frames + ((samples - 1) % script.frameCount) * script.channels;
+            testData[entry.first].assign(frame, frame + script.channels);
         }
+        dataProcessed = true;
+        xSemaphoreGive(mutexInstance);
+        return DeviceResult<void>();
     }
-    
-    DataResult getData(DeviceDataType dataType) override {
-        DataResult result = {false, {}};
-        
-        if (xSemaphoreTake(mutexInstance, portMAX_DELAY) == pdTRUE) {
-            if (!initialized) {
-                IDEV_LOG_E("getData called on uninitialized device");
-            } else if (!dataProcessed) {
-                IDEV_LOG_W("getData called before processData");
+
+    DeviceResult<std::vector<float>> getData(DeviceDataType dataType) override {
+        if (xSemaphoreTake(mutexInstance, portMAX_DELAY) != pdTRUE) {
+            return DeviceResult<std::vector<float>>(DeviceError::MUTEX_ERROR);
+        }
+        DeviceResult<std::vector<float>> result(DeviceError::DATA_NOT_READY);
+        if (!initialized) {
+            IDEV_LOG_E("getData called on uninitialized device");
+            result = DeviceResult<std::vector<float>>(DeviceError::NOT_INITIALIZED);
+        } else if (!dataProcessed) {
+            IDEV_LOG_W("getData called before processData");
+        } else {
+            auto it = testData.find(dataType);
+            if (it != testData.end()) {
+                result = DeviceResult<std::vector<float>>(it->second);
+                IDEV_LOG_D("Returning %zu values for data type %d",
+                           it->second.size(), static_cast<int>(dataType));
             } else {
-                auto it = testData.find(dataType);
-                if (it != testData.end()) {
-                    result.success = true;
-                    result.values = it->second;
-                    IDEV_LOG_D("Returning %zu values for data type %d", 
-                               result.values.size(), static_cast<int>(dataType));
-                } else {
-                    IDEV_LOG_W("No test data configured for type %d", 
-                               static_cast<int>(dataType));
-                }
+                IDEV_LOG_W("No test data configured for type %d",
+                           static_cast<int>(dataType));
             }
-            xSemaphoreGive(mutexInstance);
         }
-        
+        xSemaphoreGive(mutexInstance);
         return result;
     }
-    
+
     SemaphoreHandle_t getMutexInstance() const noexcept override {
         return mutexInstance;
     }
-    
+
     SemaphoreHandle_t getMutexInterface() const noexcept override {
         return mutexInterface;
     }
-    
+
     EventGroupHandle_t getEventGroup() const noexcept override {
         return eventGroup;
     }
-    
-    ErrorCode performAction(int actionId, int actionParam) override {
+
+    DeviceResult<void> performAction(int actionId, int actionParam) override {
         if (!initialized) {
-            return ErrorCode::NOT_INITIALIZED;
+            return DeviceResult<void>(DeviceError::NOT_INITIALIZED);
         }
-        
-        if (xSemaphoreTake(mutexInstance, portMAX_DELAY) == pdTRUE) {
-            performedActions.push_back({actionId, actionParam});
-            IDEV_LOG_I("Performed action %d with param %d", actionId, actionParam);
-            
-            notifyEvent(EventType::STATE_CHANGED, ErrorCode::SUCCESS, actionId);
-            
-            xSemaphoreGive(mutexInstance);
-            return ErrorCode::SUCCESS;
+
+        if (xSemaphoreTake(mutexInstance, portMAX_DELAY) != pdTRUE) {
+            return DeviceResult<void>(DeviceError::MUTEX_ERROR);
         }
-        
-        return ErrorCode::MUTEX_ERROR;
+        performedActions.push_back({actionId, actionParam});
+        xSemaphoreGive(mutexInstance);
+        IDEV_LOG_I("Performed action %d with param %d", actionId, actionParam);
+
+        notifyEvent(EventType::STATE_CHANGED, DeviceError::SUCCESS, actionId);
+        return DeviceResult<void>();
     }
-    
-    ErrorCode registerCallback(EventCallback callback) override {
-        if (xSemaphoreTake(mutexInstance, portMAX_DELAY) == pdTRUE) {
-            callbacks.push_back(callback);
-            xSemaphoreGive(mutexInstance);
-            return ErrorCode::SUCCESS;
+
+    DeviceResult<void> registerCallback(EventCallback callback) override {
+        if (xSemaphoreTake(callbackMutex, portMAX_DELAY) != pdTRUE) {
+            return DeviceResult<void>(DeviceError::MUTEX_ERROR);
         }
-        return ErrorCode::MUTEX_ERROR;
+        callbacks.push_back(callback);
+        xSemaphoreGive(callbackMutex);
+        return DeviceResult<void>();
     }
-    
-    ErrorCode unregisterCallbacks() override {
-        if (xSemaphoreTake(mutexInstance, portMAX_DELAY) == pdTRUE) {
-            callbacks.clear();
-            xSemaphoreGive(mutexInstance);
-            return ErrorCode::SUCCESS;
+
+    DeviceResult<void> unregisterCallbacks() override {
+        if (xSemaphoreTake(callbackMutex, portMAX_DELAY) != pdTRUE) {
+            return DeviceResult<void>(DeviceError::MUTEX_ERROR);
         }
-        return ErrorCode::MUTEX_ERROR;
+        callbacks.clear();
+        xSemaphoreGive(callbackMutex);
+        return DeviceResult<void>();
     }
-    
-    ErrorCode setEventNotification(EventType eventType, bool enable) override {
-        if (static_cast<int>(eventType) >= 5) {
-            return ErrorCode::INVALID_PARAMETER;
+
+    DeviceResult<void> setEventNotification(EventType eventType, bool enable) override {
+        if (static_cast<int>(eventType) < 0 || static_cast<int>(eventType) >= NUM_EVENT_TYPES) {
+            return DeviceResult<void>(DeviceError::INVALID_PARAMETER);
         }
-        
+
         eventsEnabled[static_cast<int>(eventType)] = enable;
-        return ErrorCode::SUCCESS;
+        return DeviceResult<void>();
     }
-    
+
     // Test helper methods
-    
+
     /**
      * @brief Set test data for a specific data type
      */
@@ -293,41 +354,145 @@ public:
             xSemaphoreGive(mutexInstance);
         }
     }
-    
+
+    /**
+     * @brief Play back a table of frames, one frame per completed sample
+     *
+     * processData() publishes frame (sample - 1) % frameCount, wrapping
+     * around at the end of the table.
+     *
+     * @param dataType Data type the frames belong to
+     * @param frames frameCount x channels values (not copied, must outlive the mock)
+     * @param frameCount Number of frames
+     * @param channels Values per frame
+     */
+    void setDataScript(DeviceDataType dataType, const float* frames, size_t frameCount, size_t channels) {
+        if (xSemaphoreTake(mutexInstance, portMAX_DELAY) == pdTRUE) {
+            scripts[dataType] = Script{frames, frames != nullptr ? frameCount : 0, channels};
+            xSemaphoreGive(mutexInstance);
+        }
+    }
+
+    /**
+     * @brief Emit DATA_READY autonomously every @p period ticks (0 stops)
+     *
+     * Each emission counts as a completed sample for setDataScript(), sets
+     * DATA_READY_BIT and notifies DATA_READY with the sample number as
+     * customData, independent of requestData().
+     */
+    void startStream(TickType_t period) {
+        streamPeriod = period;
+        if (worker != nullptr) {
+            xTaskNotifyGive(worker);
+        }
+    }
+
+    void stopStream() {
+        startStream(0);
+    }
+
+    /**
+     * @brief Latency of initialize()
+     */
+    void setInitLatency(const LatencyProfile& profile) {
+        portENTER_CRITICAL(&lock);
+        initLatency = profile;
+        portEXIT_CRITICAL(&lock);
+    }
+
+    /**
+     * @brief Latency between requestData() and DATA_READY (bus time)
+     */
+    void setDataLatency(const LatencyProfile& profile) {
+        portENTER_CRITICAL(&lock);
+        dataLatency = profile;
+        portEXIT_CRITICAL(&lock);
+    }
+
+    /**
+     * @brief Probability that a transaction ends with @p error
+     *
+     * @param error Any DeviceError except SUCCESS
+     * @param permille Probability in 1/1000; rates of all errors add up (capped at 1000)
+     */
+    void setErrorRate(DeviceError error, uint16_t permille) {
+        const int index = static_cast<int>(error);
+        if (error == DeviceError::SUCCESS || index < 0 || index >= NUM_ERRORS) {
+            return;
+        }
+        portENTER_CRITICAL(&lock);
+        errorPermille[index] = permille;
+        portEXIT_CRITICAL(&lock);
+    }
+
+    /**
+     * @brief Seed the latency and error random generator (deterministic runs)
+     */
+    void setSeed(uint32_t seed) {
+        portENTER_CRITICAL(&lock);
+        rngState = seed != 0 ? seed : 1;
+        portEXIT_CRITICAL(&lock);
+    }
+
+    /**
+     * @brief Use one mutex for several mocks to simulate a shared bus
+     * @param mutex Shared mutex (must outlive the mock), nullptr for the own one
+     */
+    void shareInterfaceMutex(SemaphoreHandle_t mutex) {
+        mutexInterface = mutex != nullptr ? mutex : ownInterfaceMutex;
+    }
+
     /**
      * @brief Configure next operation to fail with specific error
      */
-    void injectError(ErrorCode error) {
+    void injectError(DeviceError error) {
         nextError = error;
         shouldFailNext = true;
     }
-    
+
     /**
      * @brief Get list of performed actions for verification
      */
     std::vector<std::pair<int, int>> getPerformedActions() const {
         return performedActions;
     }
-    
+
+    /**
+     * @brief Load counters for benchmarking consumers
+     */
+    Stats getStats() const {
+        portENTER_CRITICAL(&lock);
+        const Stats copy = stats;
+        portEXIT_CRITICAL(&lock);
+        return copy;
+    }
+
     /**
      * @brief Reset mock to initial state
+     *
+     * Latency profiles, error rates, scripts and a shared interface mutex
+     * are kept; the stream is stopped.
      */
     void reset() {
+        stopStream();
         if (xSemaphoreTake(mutexInstance, portMAX_DELAY) == pdTRUE) {
             initialized = false;
-            dataRequested = false;
             dataProcessed = false;
             testData.clear();
             performedActions.clear();
-            nextError = ErrorCode::SUCCESS;
+            nextError = DeviceError::SUCCESS;
             shouldFailNext = false;
-            
+            completedSamples = 0;
+
             xEventGroupClearBits(eventGroup, INIT_COMPLETE_BIT | DATA_READY_BIT | ERROR_BIT);
-            
+
             xSemaphoreGive(mutexInstance);
         }
+        portENTER_CRITICAL(&lock);
+        stats = Stats();
+        portEXIT_CRITICAL(&lock);
     }
-    
+
     /**
      * @brief Get callback count for testing
      */
@@ -336,30 +501,219 @@ public:
     }
 
 private:
+    static constexpr int NUM_EVENT_TYPES = static_cast<int>(EventType::CUSTOM_EVENT) + 1;
+    static constexpr int NUM_ERRORS = static_cast<int>(DeviceError::UNKNOWN_ERROR) + 1;
+
+    struct Script {
+        const float* frames;
+        size_t frameCount;
+        size_t channels;
+    };
+
+    static void workerEntry(void* param) {
+        static_cast<MockDeviceInstance*>(param)->workerLoop();
+        vTaskDelete(nullptr);
+    }
+
+    void workerLoop() {
+        TickType_t period = 0;
+        TickType_t nextSample = 0;
+        for (;;) {
+            TickType_t wait = portMAX_DELAY;
+            if (period != 0) {
+                const int32_t left = static_cast<int32_t>(nextSample - xTaskGetTickCount());
+                wait = left > 0 ? static_cast<TickType_t>(left) : 0;
+            }
+            ulTaskNotifyTake(pdTRUE, wait);
+            if (stopping) {
+                break;
+            }
+
+            if (transactionPending.exchange(false)) {
+                runTransaction(transactionLatencyUs, transactionOutcome);
+            }
+
+            const TickType_t configured = streamPeriod;
+            const TickType_t now = xTaskGetTickCount();
+            if (configured != period) {
+                period = configured;
+                nextSample = now + period;
+            } else if (period != 0 && static_cast<int32_t>(now - nextSample) >= 0) {
+                emitStreamSample();
+                nextSample += period;
+                if (static_cast<int32_t>(now - nextSample) >= 0) {
+                    nextSample = now + period;   // Overrun: skip instead of bursting
+                }
+            }
+        }
+        xSemaphoreGive(workerExited);
+    }
+
+    // Simulated bus transaction: holds the interface mutex for the latency
+    void runTransaction(uint32_t latencyUs, DeviceError outcome) {
+        const int64_t waitStart = esp_timer_get_time();
+        xSemaphoreTake(mutexInterface, portMAX_DELAY);
+        const int64_t busStart = esp_timer_get_time();
+        delayUs(latencyUs);
+        xSemaphoreGive(mutexInterface);
+        const int64_t end = esp_timer_get_time();
+
+        portENTER_CRITICAL(&lock);
+        const uint32_t latency = static_cast<uint32_t>(end - requestStartUs);
+        stats.busWaitUs += static_cast<uint64_t>(busStart - waitStart);
+        stats.totalLatencyUs += latency;
+        if (latency > stats.maxLatencyUs) {
+            stats.maxLatencyUs = latency;
+        }
+        if (outcome == DeviceError::SUCCESS) {
+            stats.completed++;
+        } else if (outcome == DeviceError::TIMEOUT) {
+            stats.lost++;
+        } else {
+            stats.failed++;
+        }
+        inFlight = false;
+        portEXIT_CRITICAL(&lock);
+
+        if (outcome == DeviceError::SUCCESS) {
+            completedSamples++;
+            xEventGroupSetBits(eventGroup, DATA_READY_BIT);
+            notifyEvent(EventType::DATA_READY, DeviceError::SUCCESS);
+        } else if (outcome != DeviceError::TIMEOUT) {
+            lastError = outcome;
+            xEventGroupSetBits(eventGroup, ERROR_BIT);
+            notifyEvent(EventType::ERROR_OCCURRED, outcome);
+        }
+    }
+
+    void emitStreamSample() {
+        const uint32_t sample = ++completedSamples;
+        portENTER_CRITICAL(&lock);
+        stats.streamSamples++;
+        portEXIT_CRITICAL(&lock);
+        xEventGroupSetBits(eventGroup, DATA_READY_BIT);
+        notifyEvent(EventType::DATA_READY, DeviceError::SUCCESS, static_cast<int>(sample));
+    }
+
+    uint32_t drawLatency(const LatencyProfile& profile) {
+        portENTER_CRITICAL(&lock);
+        const uint32_t latency = drawLatencyLocked(profile);
+        portEXIT_CRITICAL(&lock);
+        return latency;
+    }
+
+    uint32_t drawLatencyLocked(const LatencyProfile& profile) {
+        uint32_t latency = profile.baseUs;
+        if (profile.jitterUs > 0) {
+            latency += nextRandom() % (profile.jitterUs + 1);
+        }
+        if (profile.tailPermille > 0 && nextRandom() % 1000 < profile.tailPermille) {
+            latency += profile.tailUs;
+        }
+        return latency;
+    }
+
+    DeviceError drawOutcomeLocked() {
+        uint32_t total = 0;
+        for (int i = 0; i < NUM_ERRORS; i++) {
+            total += errorPermille[i];
+        }
+        if (total == 0) {
+            return DeviceError::SUCCESS;
+        }
+        const uint32_t roll = nextRandom() % 1000;
+        uint32_t threshold = 0;
+        for (int i = 0; i < NUM_ERRORS; i++) {
+            threshold += errorPermille[i];
+            if (roll < threshold) {
+                return static_cast<DeviceError>(i);
+            }
+        }
+        return DeviceError::SUCCESS;
+    }
+
+    // xorshift32
+    uint32_t nextRandom() {
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 17;
+        rngState ^= rngState << 5;
+        return rngState;
+    }
+
+    static void delayUs(uint32_t us) {
+        if (us >= 1000) {
+            vTaskDelay(pdMS_TO_TICKS(us / 1000));
+        }
+        if (us % 1000 != 0) {
+            esp_rom_delay_us(us % 1000);
+        }
+    }
+
     /**
      * @brief Notify all registered callbacks
      */
-    void notifyEvent(EventType type, ErrorCode error, int customData = 0) {
+    void notifyEvent(EventType type, DeviceError error, int customData = 0) {
         if (!eventsEnabled[static_cast<int>(type)]) {
             return;
         }
-        
+
         EventNotification notification = {type, error, customData};
-        
-        // Create task to call callbacks to avoid blocking
-        xTaskCreate([](void* param) {
-            auto* data = static_cast<std::pair<MockDeviceInstance*, EventNotification>*>(param);
-            MockDeviceInstance* self = data->first;
-            EventNotification notif = data->second;
-            
-            for (const auto& callback : self->callbacks) {
-                callback(notif);
-            }
-            
-            delete data;
-            vTaskDelete(nullptr);
-        }, "MockNotify", 2048, new std::pair<MockDeviceInstance*, EventNotification>(this, notification), 1, nullptr);
+
+        // Call outside the lock so callbacks may use the device
+        std::vector<EventCallback> targets;
+        if (xSemaphoreTake(callbackMutex, portMAX_DELAY) == pdTRUE) {
+            targets = callbacks;
+            xSemaphoreGive(callbackMutex);
+        }
+        for (const auto& callback : targets) {
+            callback(notification);
+        }
     }
+
+    // State management
+    std::atomic<bool> initialized;
+    std::atomic<bool> dataProcessed;
+    bool inFlight;
+    std::atomic<bool> stopping;
+    std::atomic<bool> transactionPending;
+    std::atomic<bool> shouldFailNext;
+    std::atomic<TickType_t> streamPeriod;
+    std::atomic<uint32_t> completedSamples;
+
+    // Synchronization primitives
+    SemaphoreHandle_t mutexInstance;
+    SemaphoreHandle_t ownInterfaceMutex;
+    SemaphoreHandle_t mutexInterface;
+    SemaphoreHandle_t callbackMutex;
+    SemaphoreHandle_t workerExited;
+    EventGroupHandle_t eventGroup;
+    mutable portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+    // Test data storage
+    std::map<DeviceDataType, std::vector<float>> testData;
+    std::map<DeviceDataType, Script> scripts;
+
+    // Error injection
+    DeviceError nextError;
+    DeviceError lastError;
+
+    // Callback storage
+    std::vector<EventCallback> callbacks;
+    bool eventsEnabled[NUM_EVENT_TYPES];
+
+    // Action tracking
+    std::vector<std::pair<int, int>> performedActions;
+
+    // Load simulation
+    LatencyProfile initLatency;
+    LatencyProfile dataLatency;
+    uint16_t errorPermille[NUM_ERRORS];
+    uint32_t rngState;
+    uint32_t transactionLatencyUs;
+    DeviceError transactionOutcome;
+    int64_t requestStartUs;
+    Stats stats;
+    TaskHandle_t worker;
 };
 
-#endif // MOCK_DEVICE_INSTANCE_H
\ No newline at end of file
+#endif // MOCK_DEVICE_INSTANCE_H
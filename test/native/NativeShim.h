@@ -0,0 +1,582 @@
+/**
+ * @file NativeShim.h
+ * @brief Host (Linux/macOS) implementation of the FreeRTOS/ESP-IDF subset used by IDeviceInstance
+ *
+ * Header-only, backed by std::thread / std::mutex / std::condition_variable.
+ * Only for host builds (PlatformIO `platform = native`): semantics match
+ * FreeRTOS closely enough for functional tests and relative benchmarks,
+ * not for real-time behaviour.
+ *
+ * Put test/native first on the include path; it provides
+ * freertos/FreeRTOS.h, freertos/semphr.h, freertos/event_groups.h,
+ * freertos/task.h, esp_timer.h, esp_log.h, esp_rom_sys.h, esp_rom_crc.h,
+ * esp_cpu.h and esp_heap_caps.h.
+ *
+ * @version 1.0.0
+ * @date 2026-10-14
+ */
+
+#ifndef IDEV_NATIVE_SHIM_H
+#define IDEV_NATIVE_SHIM_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+
+// ---------------------------------------------------------------------------
+// Basic types and constants (FreeRTOS.h / portmacro.h)
+// ---------------------------------------------------------------------------
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef TickType_t EventBits_t;
+typedef uint8_t StackType_t;
+
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+#define pdTICKS_TO_MS(ticks) ((uint32_t)(((uint64_t)(ticks) * 1000) / configTICK_RATE_HZ))
+#define pdTRUE ((BaseType_t)1)
+#define pdFALSE ((BaseType_t)0)
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define tskNO_AFFINITY ((BaseType_t)0x7FFFFFFF)
+#define portNUM_PROCESSORS 2
+#define configNUMBER_OF_CORES portNUM_PROCESSORS
+#define configASSERT(x) assert(x)
+#define portYIELD_FROM_ISR(...) ((void)0)
+#define taskYIELD() std::this_thread::yield()
+
+#ifndef BIT0
+#define BIT0  0x00000001u
+#define BIT1  0x00000002u
+#define BIT2  0x00000004u
+#define BIT3  0x00000008u
+#define BIT4  0x00000010u
+#define BIT5  0x00000020u
+#define BIT6  0x00000040u
+#define BIT7  0x00000080u
+#define BIT8  0x00000100u
+#define BIT9  0x00000200u
+#define BIT10 0x00000400u
+#define BIT11 0x00000800u
+#define BIT12 0x00001000u
+#define BIT13 0x00002000u
+#define BIT14 0x00004000u
+#define BIT15 0x00008000u
+#define BIT16 0x00010000u
+#define BIT17 0x00020000u
+#define BIT18 0x00040000u
+#define BIT19 0x00080000u
+#define BIT20 0x00100000u
+#define BIT21 0x00200000u
+#define BIT22 0x00400000u
+#define BIT23 0x00800000u
+#endif
+
+// Storage for the ...Static() creators; large enough for the shim objects
+typedef struct { alignas(alignof(std::max_align_t)) uint8_t storage[192]; } StaticSemaphore_t;
+typedef struct { alignas(alignof(std::max_align_t)) uint8_t storage[192]; } StaticEventGroup_t;
+typedef struct { alignas(alignof(std::max_align_t)) uint8_t storage[192]; } StaticTask_t;
+typedef StaticSemaphore_t StaticQueue_t;
+
+namespace idev_native {
+
+inline std::chrono::steady_clock::time_point startTime() {
+    static const auto start = std::chrono::steady_clock::now();
+    return start;
+}
+
+inline TickType_t tickCount() {
+    const auto elapsed = std::chrono::steady_clock::now() - startTime();
+    return static_cast<TickType_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() * configTICK_RATE_HZ / 1000);
+}
+
+inline std::chrono::steady_clock::time_point deadline(TickType_t ticks) {
+    return std::chrono::steady_clock::now() +
+           std::chrono::microseconds(static_cast<uint64_t>(ticks) * 1000000ULL / configTICK_RATE_HZ);
+}
+
+// Small per-thread id (0 = none) used as spinlock owner
+inline uint32_t threadId() {
+    static std::atomic<uint32_t> next{1};
+    thread_local uint32_t id = next.fetch_add(1);
+    return id;
+}
+
+} // namespace idev_native
+
+// ---------------------------------------------------------------------------
+// Critical sections (portMUX_TYPE) - recursive spinlock per mux
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    volatile uint32_t owner;
+    volatile uint32_t count;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0, 0}
+
+inline void vPortEnterCritical(portMUX_TYPE* mux) {
+    const uint32_t self = idev_native::threadId();
+    if (__atomic_load_n(&mux->owner, __ATOMIC_ACQUIRE) == self) {
+        mux->count++;
+        return;
+    }
+    uint32_t expected = 0;
+    while (!__atomic_compare_exchange_n(&mux->owner, &expected, self, true,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        expected = 0;
+        std::this_thread::yield();
+    }
+    mux->count = 1;
+}
+
+inline void vPortExitCritical(portMUX_TYPE* mux) {
+    if (--mux->count == 0) {
+        __atomic_store_n(&mux->owner, 0u, __ATOMIC_RELEASE);
+    }
+}
+
+inline void vPortCPUInitializeMutex(portMUX_TYPE* mux) {
+    mux->owner = 0;
+    mux->count = 0;
+}
+
+#define portENTER_CRITICAL(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux) vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux) vPortExitCritical(mux)
+#define portENTER_CRITICAL_SAFE(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_SAFE(mux) vPortExitCritical(mux)
+
+// ---------------------------------------------------------------------------
+// Semaphores / mutexes (semphr.h)
+// ---------------------------------------------------------------------------
+
+struct IdevNativeSemaphore {
+    enum class Kind { MUTEX, RECURSIVE_MUTEX, BINARY, COUNTING };
+
+    IdevNativeSemaphore(Kind k, UBaseType_t maxCount, UBaseType_t initial, bool isStatic)
+        : kind(k), count(initial), max(maxCount), owner(0), depth(0), staticStorage(isStatic) {}
+
+    bool take(TickType_t ticks) {
+        std::unique_lock<std::mutex> lock(mutex);
+        const uint32_t self = idev_native::threadId();
+        if (kind == Kind::RECURSIVE_MUTEX && owner == self) {
+            depth++;
+            return true;
+        }
+        auto ready = [this] { return count > 0; };
+        if (ticks == portMAX_DELAY) {
+            cv.wait(lock, ready);
+        } else if (!cv.wait_until(lock, idev_native::deadline(ticks), ready)) {
+            return false;
+        }
+        count--;
+        if (kind == Kind::MUTEX || kind == Kind::RECURSIVE_MUTEX) {
+            owner = self;
+            depth = 1;
+        }
+        return true;
+    }
+
+    bool give() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (kind == Kind::MUTEX || kind == Kind::RECURSIVE_MUTEX) {
+            if (owner != idev_native::threadId()) {
+                return false;  // Only the holder may give a mutex
+            }
+            if (--depth > 0) {
+                return true;
+            }
+            owner = 0;
+        } else if (count >= max) {
+            return false;
+        }
+        count++;
+        cv.notify_one();
+        return true;
+    }
+
+    Kind kind;
+    UBaseType_t count;
+    UBaseType_t max;
+    uint32_t owner;
+    uint32_t depth;
+    bool staticStorage;
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+static_assert(sizeof(IdevNativeSemaphore) <= sizeof(StaticSemaphore_t), "StaticSemaphore_t too small");
+
+typedef IdevNativeSemaphore* SemaphoreHandle_t;
+typedef IdevNativeSemaphore* QueueHandle_t;
+
+namespace idev_native {
+
+inline SemaphoreHandle_t makeSemaphore(IdevNativeSemaphore::Kind kind, UBaseType_t max, UBaseType_t initial,
+                                       StaticSemaphore_t* buffer) {
+    if (buffer != nullptr) {
+        return new (buffer->storage) IdevNativeSemaphore(kind, max, initial, true);
+    }
+    return new IdevNativeSemaphore(kind, max, initial, false);
+}
+
+} // namespace idev_native
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return idev_native::makeSemaphore(IdevNativeSemaphore::Kind::MUTEX, 1, 1, nullptr);
+}
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() {
+    return idev_native::makeSemaphore(IdevNativeSemaphore::Kind::RECURSIVE_MUTEX, 1, 1, nullptr);
+}
+inline SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return idev_native::makeSemaphore(IdevNativeSemaphore::Kind::BINARY, 1, 0, nullptr);
+}
+inline SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial) {
+    return idev_native::makeSemaphore(IdevNativeSemaphore::Kind::COUNTING, max, initial, nullptr);
+}
+inline SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* buffer) {
+    return idev_native::makeSemaphore(IdevNativeSemaphore::Kind::MUTEX, 1, 1, buffer);
+}
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutexStatic(StaticSemaphore_t* buffer) {
+    return idev_native::makeSemaphore(IdevNativeSemaphore::Kind::RECURSIVE_MUTEX, 1, 1, buffer);
+}
+inline SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t* buffer) {
+    return idev_native::makeSemaphore(IdevNativeSemaphore::Kind::BINARY, 1, 0, buffer);
+}
+inline SemaphoreHandle_t xSemaphoreCreateCountingStatic(UBaseType_t max, UBaseType_t initial,
+                                                        StaticSemaphore_t* buffer) {
+    return idev_native::makeSemaphore(IdevNativeSemaphore::Kind::COUNTING, max, initial, buffer);
+}
+
+inline void vSemaphoreDelete(SemaphoreHandle_t sem) {
+    if (sem == nullptr) {
+        return;
+    }
+    if (sem->staticStorage) {
+        sem->~IdevNativeSemaphore();
+    } else {
+        delete sem;
+    }
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+    return sem != nullptr && sem->take(ticks) ? pdTRUE : pdFALSE;
+}
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    return sem != nullptr && sem->give() ? pdTRUE : pdFALSE;
+}
+inline BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t ticks) {
+    return xSemaphoreTake(sem, ticks);
+}
+inline BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem) {
+    return xSemaphoreGive(sem);
+}
+inline BaseType_t xSemaphoreTakeFromISR(SemaphoreHandle_t sem, BaseType_t*) {
+    return xSemaphoreTake(sem, 0);
+}
+inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t* woken) {
+    if (woken != nullptr) {
+        *woken = pdFALSE;
+    }
+    return xSemaphoreGive(sem);
+}
+inline UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t sem) {
+    std::lock_guard<std::mutex> lock(sem->mutex);
+    return sem->count;
+}
+
+// ---------------------------------------------------------------------------
+// Event groups (event_groups.h)
+// ---------------------------------------------------------------------------
+
+struct IdevNativeEventGroup {
+    explicit IdevNativeEventGroup(bool isStatic) : bits(0), staticStorage(isStatic) {}
+    EventBits_t bits;
+    bool staticStorage;
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+static_assert(sizeof(IdevNativeEventGroup) <= sizeof(StaticEventGroup_t), "StaticEventGroup_t too small");
+
+typedef IdevNativeEventGroup* EventGroupHandle_t;
+
+inline EventGroupHandle_t xEventGroupCreate() {
+    return new IdevNativeEventGroup(false);
+}
+inline EventGroupHandle_t xEventGroupCreateStatic(StaticEventGroup_t* buffer) {
+    return new (buffer->storage) IdevNativeEventGroup(true);
+}
+inline void vEventGroupDelete(EventGroupHandle_t group) {
+    if (group == nullptr) {
+        return;
+    }
+    if (group->staticStorage) {
+        group->~IdevNativeEventGroup();
+    } else {
+        delete group;
+    }
+}
+
+inline EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits) {
+    std::lock_guard<std::mutex> lock(group->mutex);
+    group->bits |= bits;
+    group->cv.notify_all();
+    return group->bits;
+}
+inline EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits) {
+    std::lock_guard<std::mutex> lock(group->mutex);
+    const EventBits_t before = group->bits;
+    group->bits &= ~bits;
+    return before;
+}
+inline EventBits_t xEventGroupGetBits(EventGroupHandle_t group) {
+    std::lock_guard<std::mutex> lock(group->mutex);
+    return group->bits;
+}
+inline BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t group, EventBits_t bits, BaseType_t* woken) {
+    if (woken != nullptr) {
+        *woken = pdFALSE;
+    }
+    xEventGroupSetBits(group, bits);
+    return pdPASS;
+}
+inline BaseType_t xEventGroupClearBitsFromISR(EventGroupHandle_t group, EventBits_t bits) {
+    xEventGroupClearBits(group, bits);
+    return pdPASS;
+}
+inline EventBits_t xEventGroupGetBitsFromISR(EventGroupHandle_t group) {
+    return xEventGroupGetBits(group);
+}
+
+inline EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit,
+                                       BaseType_t waitForAll, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(group->mutex);
+    auto satisfied = [&] {
+        return waitForAll ? (group->bits & bits) == bits : (group->bits & bits) != 0;
+    };
+    bool ok;
+    if (ticks == portMAX_DELAY) {
+        group->cv.wait(lock, satisfied);
+        ok = true;
+    } else {
+        ok = group->cv.wait_until(lock, idev_native::deadline(ticks), satisfied);
+    }
+    const EventBits_t result = group->bits;
+    if (ok && clearOnExit) {
+        group->bits &= ~bits;
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Tasks and notifications (task.h)
+// ---------------------------------------------------------------------------
+
+typedef void (*TaskFunction_t)(void*);
+
+struct IdevNativeTask {
+    IdevNativeTask(BaseType_t core, bool isStatic) : coreId(core), notifyValue(0), staticStorage(isStatic) {}
+    BaseType_t coreId;
+    uint32_t notifyValue;
+    bool staticStorage;
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+static_assert(sizeof(IdevNativeTask) <= sizeof(StaticTask_t), "StaticTask_t too small");
+
+typedef IdevNativeTask* TaskHandle_t;
+
+namespace idev_native {
+
+// Thrown by vTaskDelete(nullptr) to leave the task function
+struct TaskExit {};
+
+inline TaskHandle_t& currentTask() {
+    thread_local TaskHandle_t task = nullptr;
+    return task;
+}
+
+// The main thread (and any foreign thread) gets a task object on first use
+inline TaskHandle_t ensureCurrentTask() {
+    TaskHandle_t& task = currentTask();
+    if (task == nullptr) {
+        task = new IdevNativeTask(0, false);
+    }
+    return task;
+}
+
+inline TaskHandle_t spawn(TaskFunction_t fn, void* param, BaseType_t coreId, StaticTask_t* buffer) {
+    const BaseType_t core = coreId == tskNO_AFFINITY ? 0 : coreId;
+    TaskHandle_t task = buffer != nullptr ? new (buffer->storage) IdevNativeTask(core, true)
+                                          : new IdevNativeTask(core, false);
+    std::thread([fn, param, task] {
+        currentTask() = task;
+        try {
+            fn(param);
+        } catch (const TaskExit&) {
+        }
+    }).detach();
+    return task;
+}
+
+} // namespace idev_native
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char*, uint32_t, void* param,
+                                          UBaseType_t, TaskHandle_t* created, BaseType_t coreId) {
+    TaskHandle_t task = idev_native::spawn(fn, param, coreId, nullptr);
+    if (created != nullptr) {
+        *created = task;
+    }
+    return pdPASS;
+}
+inline BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack, void* param,
+                              UBaseType_t priority, TaskHandle_t* created) {
+    return xTaskCreatePinnedToCore(fn, name, stack, param, priority, created, tskNO_AFFINITY);
+}
+inline TaskHandle_t xTaskCreateStaticPinnedToCore(TaskFunction_t fn, const char*, uint32_t, void* param,
+                                                  UBaseType_t, StackType_t*, StaticTask_t* buffer,
+                                                  BaseType_t coreId) {
+    return idev_native::spawn(fn, param, coreId, buffer);
+}
+inline TaskHandle_t xTaskCreateStatic(TaskFunction_t fn, const char* name, uint32_t stack, void* param,
+                                      UBaseType_t priority, StackType_t* stackBuffer, StaticTask_t* buffer) {
+    return xTaskCreateStaticPinnedToCore(fn, name, stack, param, priority, stackBuffer, buffer, tskNO_AFFINITY);
+}
+
+/// Only self-deletion (nullptr or own handle) is supported; it ends the thread
+inline void vTaskDelete(TaskHandle_t task) {
+    if (task == nullptr || task == idev_native::currentTask()) {
+        throw idev_native::TaskExit();
+    }
+}
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return idev_native::ensureCurrentTask();
+}
+inline BaseType_t xPortGetCoreID() {
+    return idev_native::ensureCurrentTask()->coreId;
+}
+inline TickType_t xTaskGetTickCount() {
+    return idev_native::tickCount();
+}
+inline TickType_t xTaskGetTickCountFromISR() {
+    return idev_native::tickCount();
+}
+inline void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_until(idev_native::deadline(ticks));
+}
+inline void vTaskDelayUntil(TickType_t* previousWake, TickType_t increment) {
+    const TickType_t target = *previousWake + increment;
+    const TickType_t now = xTaskGetTickCount();
+    if (static_cast<int32_t>(target - now) > 0) {
+        vTaskDelay(target - now);
+    }
+    *previousWake = target;
+}
+inline void vTaskSuspend(TaskHandle_t) {}
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) {
+    return 0;
+}
+
+inline void xTaskNotifyGive(TaskHandle_t task) {
+    std::lock_guard<std::mutex> lock(task->mutex);
+    task->notifyValue++;
+    task->cv.notify_one();
+}
+inline void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken) {
+    if (woken != nullptr) {
+        *woken = pdFALSE;
+    }
+    xTaskNotifyGive(task);
+}
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+    TaskHandle_t task = idev_native::ensureCurrentTask();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    auto pending = [task] { return task->notifyValue > 0; };
+    if (ticks == portMAX_DELAY) {
+        task->cv.wait(lock, pending);
+    } else if (!task->cv.wait_until(lock, idev_native::deadline(ticks), pending)) {
+        return 0;
+    }
+    const uint32_t value = task->notifyValue;
+    task->notifyValue = clearOnExit ? 0 : value - 1;
+    return value;
+}
+
+// ---------------------------------------------------------------------------
+// ESP-IDF helpers (esp_timer.h, esp_cpu.h, esp_rom_sys.h)
+// ---------------------------------------------------------------------------
+
+inline int64_t esp_timer_get_time() {
+    const auto elapsed = std::chrono::steady_clock::now() - idev_native::startTime();
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+// The host "cycle counter" counts nanoseconds
+inline uint32_t esp_cpu_get_cycle_count() {
+    const auto elapsed = std::chrono::steady_clock::now() - idev_native::startTime();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+inline uint32_t esp_rom_get_cpu_ticks_per_us() {
+    return 1000;
+}
+
+inline void esp_rom_delay_us(uint32_t us) {
+    const int64_t end = esp_timer_get_time() + us;
+    while (esp_timer_get_time() < end) {
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Capability-based heap (esp_heap_caps.h) - every capability maps to malloc
+// ---------------------------------------------------------------------------
+
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT  (1 << 12)
+
+inline void* heap_caps_malloc(size_t size, uint32_t) {
+    return std::malloc(size);
+}
+inline void* heap_caps_calloc(size_t count, size_t size, uint32_t) {
+    return std::calloc(count, size);
+}
+inline void heap_caps_free(void* ptr) {
+    std::free(ptr);
+}
+
+// ---------------------------------------------------------------------------
+// ROM CRC (esp_rom_crc.h) - bitwise, same results as the ROM table version
+// ---------------------------------------------------------------------------
+
+// Standard CRC-32 (poly 0xEDB88320); pass 0 to start, the previous result to continue
+inline uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len) {
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+#endif // IDEV_NATIVE_SHIM_H
@@ -0,0 +1,34 @@
+// Host build shim - ESP-IDF style logging to stdout
+#pragma once
+#include "NativeShim.h"
+#include <cstdarg>
+#include <cstdio>
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+inline void esp_log_write(esp_log_level_t, const char*, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+inline uint32_t esp_log_timestamp() {
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+}
+
+#define IDEV_NATIVE_LOG(letter, tag, format, ...) \
+    printf(letter " (%u) %s: " format "\n", static_cast<unsigned>(esp_log_timestamp()), tag, ##__VA_ARGS__)
+
+#define ESP_LOGE(tag, format, ...) IDEV_NATIVE_LOG("E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) IDEV_NATIVE_LOG("W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) IDEV_NATIVE_LOG("I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) IDEV_NATIVE_LOG("D", tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) IDEV_NATIVE_LOG("V", tag, format, ##__VA_ARGS__)
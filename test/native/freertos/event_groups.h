@@ -0,0 +1,3 @@
+// Host build shim - see ../NativeShim.h
+#pragma once
+#include "../NativeShim.h"
@@ -6,10 +6,24 @@
  * implementations using the MockDeviceInstance test double.
  */
 
+// Short timeouts so the abandonment and stuck-writer tests run quickly
+#define IDEV_COALESCER_FLIGHT_TIMEOUT_MS 50
+#define IDEV_SNAPSHOT_MUTEX_TIMEOUT_MS 20
+
 #include <unity.h>
 #include "MockDeviceInstance.h"
+#include "DeviceBusScheduler.h"
+#include "DeviceDeadband.h"
+#include "DeviceEventDispatcher.h"
+#include "DeviceHistory.h"
+#include "DeviceRegistry.h"
+#include "DevicePoller.h"
+#include "DeviceSeqLock.h"
+#include "DeviceStateBlob.h"
+#include "DeviceTelemetryCodec.h"
 #include <vector>
 #include <atomic>
+#include <cstring>
 
 // Test fixtures
 static MockDeviceInstance* device = nullptr;
@@ -53,36 +67,38 @@ void test_initialization_wait_with_timeout() {
     }, "InitTask", 2048, device, 1, nullptr);
     
     // Should timeout before initialization
-    IDeviceInstance::ErrorCode result = device->waitForInitialization(pdMS_TO_TICKS(30));
-    TEST_ASSERT_EQUAL(IDeviceInstance::ErrorCode::TIMEOUT, result);
+    IDeviceInstance::DeviceError result = device->waitForInitialization(pdMS_TO_TICKS(30));
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::TIMEOUT, result);
     
     // Should succeed with longer timeout
     result = device->waitForInitialization(pdMS_TO_TICKS(100));
-    TEST_ASSERT_EQUAL(IDeviceInstance::ErrorCode::SUCCESS, result);
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, result);
     TEST_ASSERT_TRUE(device->isInitialized());
 }
 
 void test_data_acquisition_flow() {
     // Must initialize first
-    TEST_ASSERT_FALSE(device->requestData());
+    auto request = device->requestData();
+    TEST_ASSERT_FALSE(request.isOk());
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::NOT_INITIALIZED, request.error());
     
     device->initialize();
     TEST_ASSERT_TRUE(device->isInitialized());
     
     // Request data
-    TEST_ASSERT_TRUE(device->requestData());
+    TEST_ASSERT_TRUE(device->requestData().isOk());
     
     // Wait for data
-    IDeviceInstance::ErrorCode result = device->waitForData(pdMS_TO_TICKS(50));
-    TEST_ASSERT_EQUAL(IDeviceInstance::ErrorCode::SUCCESS, result);
+    IDeviceInstance::DeviceError result = device->waitForData(pdMS_TO_TICKS(50));
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, result);
     
     // Process data
     device->processData();
     
     // Verify no data without configuration
-    IDeviceInstance::DataResult dataResult = device->getData(IDeviceInstance::DeviceDataType::TEMPERATURE);
-    TEST_ASSERT_FALSE(dataResult.success);
-    TEST_ASSERT_TRUE(dataResult.values.empty());
+    auto dataResult = device->getData(IDeviceInstance::DeviceDataType::TEMPERATURE);
+    TEST_ASSERT_FALSE(dataResult.isOk());
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::DATA_NOT_READY, dataResult.error());
 }
 
 void test_data_retrieval_with_values() {
@@ -98,12 +114,12 @@ void test_data_retrieval_with_values() {
     device->processData();
     
     // Retrieve data
-    IDeviceInstance::DataResult result = device->getData(IDeviceInstance::DeviceDataType::TEMPERATURE);
-    TEST_ASSERT_TRUE(result.success);
-    TEST_ASSERT_EQUAL(testValues.size(), result.values.size());
+    auto result = device->getData(IDeviceInstance::DeviceDataType::TEMPERATURE);
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_EQUAL(testValues.size(), result.value().size());
     
     for (size_t i = 0; i < testValues.size(); i++) {
-        TEST_ASSERT_FLOAT_WITHIN(0.01f, testValues[i], result.values[i]);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, testValues[i], result.value()[i]);
     }
 }
 
@@ -121,41 +137,44 @@ void test_multiple_data_types() {
     
     // Test each type
     auto tempResult = device->getData(IDeviceInstance::DeviceDataType::TEMPERATURE);
-    TEST_ASSERT_TRUE(tempResult.success);
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 22.5f, tempResult.values[0]);
+    TEST_ASSERT_TRUE(tempResult.isOk());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 22.5f, tempResult.value()[0]);
     
     auto humResult = device->getData(IDeviceInstance::DeviceDataType::HUMIDITY);
-    TEST_ASSERT_TRUE(humResult.success);
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 65.0f, humResult.values[0]);
+    TEST_ASSERT_TRUE(humResult.isOk());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 65.0f, humResult.value()[0]);
     
     auto pressResult = device->getData(IDeviceInstance::DeviceDataType::PRESSURE);
-    TEST_ASSERT_TRUE(pressResult.success);
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 1013.25f, pressResult.values[0]);
+    TEST_ASSERT_TRUE(pressResult.isOk());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 1013.25f, pressResult.value()[0]);
 }
 
 void test_error_injection() {
     device->initialize();
     
     // Inject error for next operation
-    device->injectError(IDeviceInstance::ErrorCode::COMMUNICATION_ERROR);
+    device->injectError(IDeviceInstance::DeviceError::COMMUNICATION_ERROR);
     
     // Request should fail
-    TEST_ASSERT_FALSE(device->requestData());
+    auto result = device->requestData();
+    TEST_ASSERT_FALSE(result.isOk());
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::COMMUNICATION_ERROR, result.error());
+    
+    // Only the next request fails
+    TEST_ASSERT_TRUE(device->requestData().isOk());
 }
 
 void test_perform_action() {
     // Should fail when not initialized
-    IDeviceInstance::ErrorCode result = device->performAction(1, 100);
-    TEST_ASSERT_EQUAL(IDeviceInstance::ErrorCode::NOT_INITIALIZED, result);
+    auto result = device->performAction(1, 100);
+    TEST_ASSERT_FALSE(result.isOk());
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::NOT_INITIALIZED, result.error());
     
     device->initialize();
     
     // Should succeed when initialized
-    result = device->performAction(1, 100);
-    TEST_ASSERT_EQUAL(IDeviceInstance::ErrorCode::SUCCESS, result);
-    
-    result = device->performAction(2, 200);
-    TEST_ASSERT_EQUAL(IDeviceInstance::ErrorCode::SUCCESS, result);
+    TEST_ASSERT_TRUE(device->performAction(1, 100).isOk());
+    TEST_ASSERT_TRUE(device->performAction(2, 200).isOk());
     
     // Verify actions were recorded
     auto actions = device->getPerformedActions();
@@ -168,8 +187,7 @@ void test_perform_action() {
 
 void test_callbacks_basic() {
     // Register callback
-    IDeviceInstance::ErrorCode result = device->registerCallback(testCallback);
-    TEST_ASSERT_EQUAL(IDeviceInstance::ErrorCode::SUCCESS, result);
+    TEST_ASSERT_TRUE(device->registerCallback(testCallback).isOk());
     TEST_ASSERT_EQUAL(1, device->getCallbackCount());
     
     // Initialize should trigger callback
@@ -179,7 +197,7 @@ void test_callbacks_basic() {
     TEST_ASSERT_EQUAL(1, callbackCounter.load());
     TEST_ASSERT_EQUAL(1, receivedNotifications.size());
     TEST_ASSERT_EQUAL(IDeviceInstance::EventType::INITIALIZED, receivedNotifications[0].type);
-    TEST_ASSERT_EQUAL(IDeviceInstance::ErrorCode::SUCCESS, receivedNotifications[0].error);
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, receivedNotifications[0].error);
 }
 
 void test_callbacks_multiple_events() {
@@ -209,10 +227,10 @@ void test_event_notification_control() {
     device->registerCallback(testCallback);
     
     // Disable initialization events
-    IDeviceInstance::ErrorCode result = device->setEventNotification(
+    auto result = device->setEventNotification(
         IDeviceInstance::EventType::INITIALIZED, false
     );
-    TEST_ASSERT_EQUAL(IDeviceInstance::ErrorCode::SUCCESS, result);
+    TEST_ASSERT_TRUE(result.isOk());
     
     device->initialize();
     vTaskDelay(pdMS_TO_TICKS(50));
@@ -237,8 +255,7 @@ void test_unregister_callbacks() {
     TEST_ASSERT_EQUAL(2, device->getCallbackCount());
     
     // Unregister all
-    IDeviceInstance::ErrorCode result = device->unregisterCallbacks();
-    TEST_ASSERT_EQUAL(IDeviceInstance::ErrorCode::SUCCESS, result);
+    TEST_ASSERT_TRUE(device->unregisterCallbacks().isOk());
     TEST_ASSERT_EQUAL(0, device->getCallbackCount());
     
     // Events should not trigger callbacks
@@ -273,11 +290,11 @@ void test_concurrent_access() {
             
             // Perform concurrent operations
             for (int j = 0; j < 10; j++) {
-                if (dev->requestData()) {
-                    if (dev->waitForData(pdMS_TO_TICKS(100)) == IDeviceInstance::ErrorCode::SUCCESS) {
+                if (dev->requestData().isOk()) {
+                    if (dev->waitForData(pdMS_TO_TICKS(100)) == IDeviceInstance::DeviceError::SUCCESS) {
                         dev->processData();
                         auto result = dev->getData(IDeviceInstance::DeviceDataType::TEMPERATURE);
-                        if (result.success) {
+                        if (result.isOk()) {
                             (*counter)++;
                         }
                     }
@@ -299,31 +316,31 @@ void test_concurrent_access() {
 void test_error_to_string() {
     // Test all error codes
     TEST_ASSERT_EQUAL_STRING("Success", 
-        IDeviceInstance::errorToString(IDeviceInstance::ErrorCode::SUCCESS));
+        IDeviceInstance::errorToString(IDeviceInstance::DeviceError::SUCCESS));
     TEST_ASSERT_EQUAL_STRING("Not initialized", 
-        IDeviceInstance::errorToString(IDeviceInstance::ErrorCode::NOT_INITIALIZED));
+        IDeviceInstance::errorToString(IDeviceInstance::DeviceError::NOT_INITIALIZED));
     TEST_ASSERT_EQUAL_STRING("Timeout", 
-        IDeviceInstance::errorToString(IDeviceInstance::ErrorCode::TIMEOUT));
+        IDeviceInstance::errorToString(IDeviceInstance::DeviceError::TIMEOUT));
     TEST_ASSERT_EQUAL_STRING("Invalid parameter", 
-        IDeviceInstance::errorToString(IDeviceInstance::ErrorCode::INVALID_PARAMETER));
+        IDeviceInstance::errorToString(IDeviceInstance::DeviceError::INVALID_PARAMETER));
     TEST_ASSERT_EQUAL_STRING("Communication error", 
-        IDeviceInstance::errorToString(IDeviceInstance::ErrorCode::COMMUNICATION_ERROR));
+        IDeviceInstance::errorToString(IDeviceInstance::DeviceError::COMMUNICATION_ERROR));
     TEST_ASSERT_EQUAL_STRING("Data not ready", 
-        IDeviceInstance::errorToString(IDeviceInstance::ErrorCode::DATA_NOT_READY));
+        IDeviceInstance::errorToString(IDeviceInstance::DeviceError::DATA_NOT_READY));
     TEST_ASSERT_EQUAL_STRING("Mutex error", 
-        IDeviceInstance::errorToString(IDeviceInstance::ErrorCode::MUTEX_ERROR));
+        IDeviceInstance::errorToString(IDeviceInstance::DeviceError::MUTEX_ERROR));
     TEST_ASSERT_EQUAL_STRING("Memory error", 
-        IDeviceInstance::errorToString(IDeviceInstance::ErrorCode::MEMORY_ERROR));
+        IDeviceInstance::errorToString(IDeviceInstance::DeviceError::MEMORY_ERROR));
     TEST_ASSERT_EQUAL_STRING("Device busy", 
-        IDeviceInstance::errorToString(IDeviceInstance::ErrorCode::DEVICE_BUSY));
+        IDeviceInstance::errorToString(IDeviceInstance::DeviceError::DEVICE_BUSY));
     TEST_ASSERT_EQUAL_STRING("Not supported", 
-        IDeviceInstance::errorToString(IDeviceInstance::ErrorCode::NOT_SUPPORTED));
+        IDeviceInstance::errorToString(IDeviceInstance::DeviceError::NOT_SUPPORTED));
     TEST_ASSERT_EQUAL_STRING("Unknown error", 
-        IDeviceInstance::errorToString(IDeviceInstance::ErrorCode::UNKNOWN_ERROR));
+        IDeviceInstance::errorToString(IDeviceInstance::DeviceError::UNKNOWN_ERROR));
     
     // Test invalid error code
     TEST_ASSERT_EQUAL_STRING("Invalid error code", 
-        IDeviceInstance::errorToString(static_cast<IDeviceInstance::ErrorCode>(999)));
+        IDeviceInstance::errorToString(static_cast<IDeviceInstance::DeviceError>(999)));
 }
 
 void test_is_valid_data_type() {
@@ -349,13 +366,1368 @@ void test_to_underlying_type() {
     auto tempValue = IDeviceInstance::toUnderlyingType(IDeviceInstance::DeviceDataType::TEMPERATURE);
     TEST_ASSERT_EQUAL(0, tempValue);
     
-    auto errorValue = IDeviceInstance::toUnderlyingType(IDeviceInstance::ErrorCode::TIMEOUT);
+    auto errorValue = IDeviceInstance::toUnderlyingType(IDeviceInstance::DeviceError::TIMEOUT);
     TEST_ASSERT_EQUAL(2, errorValue);
     
     auto eventValue = IDeviceInstance::toUnderlyingType(IDeviceInstance::EventType::DATA_READY);
     TEST_ASSERT_EQUAL(1, eventValue);
 }
 
+void test_static_vector_inline_storage() {
+    IDeviceInstance::ChannelValues values;
+    TEST_ASSERT_TRUE(values.empty());
+    TEST_ASSERT_EQUAL(IDeviceInstance::MAX_CHANNELS, values.capacity());
+    
+    // Fill to capacity, one more must be rejected
+    for (size_t i = 0; i < values.capacity(); i++) {
+        TEST_ASSERT_TRUE(values.push_back(static_cast<float>(i)));
+    }
+    TEST_ASSERT_TRUE(values.full());
+    TEST_ASSERT_FALSE(values.push_back(99.0f));
+    
+    // Copies are independent
+    IDeviceInstance::ChannelValues copy = values;
+    copy[0] = 42.0f;
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, values[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 42.0f, copy[0]);
+    TEST_ASSERT_EQUAL(values.size(), copy.size());
+    
+    TEST_ASSERT_FALSE(values.resize(values.capacity() + 1));
+    values.clear();
+    TEST_ASSERT_EQUAL(0, values.size());
+}
+
+void test_concurrent_requests_join() {
+    device->initialize();
+    
+    // Second request while the first is in flight joins it
+    TEST_ASSERT_TRUE(device->requestData().isOk());
+    TEST_ASSERT_TRUE(device->requestData().isOk());
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, device->waitForData(pdMS_TO_TICKS(100)));
+    
+    MockDeviceInstance::Stats stats = device->getStats();
+    TEST_ASSERT_EQUAL(1, stats.requests);
+    TEST_ASSERT_EQUAL(1, stats.joined);
+    TEST_ASSERT_EQUAL(1, stats.completed);
+}
+
+void test_latency_jitter_bounds() {
+    device->initialize();
+    device->setSeed(1);
+    device->setDataLatency(MockDeviceInstance::LatencyProfile(2000, 3000));
+    
+    const int requests = 20;
+    for (int i = 0; i < requests; i++) {
+        TEST_ASSERT_TRUE(device->requestData().isOk());
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, device->waitForData(pdMS_TO_TICKS(100)));
+    }
+    
+    MockDeviceInstance::Stats stats = device->getStats();
+    TEST_ASSERT_EQUAL(requests, stats.completed);
+    TEST_ASSERT_TRUE(stats.totalLatencyUs >= 2000ULL * requests);
+    TEST_ASSERT_TRUE(stats.maxLatencyUs >= 2000);
+    TEST_ASSERT_TRUE(stats.maxLatencyUs < 50000);
+}
+
+void test_error_rate_distribution() {
+    device->initialize();
+    device->setSeed(42);
+    device->setDataLatency(MockDeviceInstance::LatencyProfile());   // Complete inline
+    device->setErrorRate(IDeviceInstance::DeviceError::COMMUNICATION_ERROR, 200);
+    device->setErrorRate(IDeviceInstance::DeviceError::TIMEOUT, 100);
+    
+    const int requests = 1000;
+    int failed = 0;
+    int lost = 0;
+    for (int i = 0; i < requests; i++) {
+        TEST_ASSERT_TRUE(device->requestData().isOk());
+        IDeviceInstance::DeviceError result = device->waitForData(0);
+        if (result == IDeviceInstance::DeviceError::COMMUNICATION_ERROR) {
+            failed++;
+        } else if (result == IDeviceInstance::DeviceError::TIMEOUT) {
+            lost++;
+        } else {
+            TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, result);
+        }
+    }
+    
+    // 20 % and 10 % within a generous tolerance
+    TEST_ASSERT_INT_WITHIN(60, 200, failed);
+    TEST_ASSERT_INT_WITHIN(40, 100, lost);
+    
+    MockDeviceInstance::Stats stats = device->getStats();
+    TEST_ASSERT_EQUAL(failed, stats.failed);
+    TEST_ASSERT_EQUAL(lost, stats.lost);
+    TEST_ASSERT_EQUAL(requests, stats.completed + stats.failed + stats.lost);
+}
+
+void test_shared_bus_contention() {
+    SemaphoreHandle_t bus = xSemaphoreCreateMutex();
+    MockDeviceInstance* other = new MockDeviceInstance();
+    device->shareInterfaceMutex(bus);
+    other->shareInterfaceMutex(bus);
+    TEST_ASSERT_EQUAL_PTR(device->getMutexInterface(), other->getMutexInterface());
+    
+    device->setDataLatency(MockDeviceInstance::LatencyProfile::fixedMs(10));
+    other->setDataLatency(MockDeviceInstance::LatencyProfile::fixedMs(10));
+    device->initialize();
+    other->initialize();
+    
+    TEST_ASSERT_TRUE(device->requestData().isOk());
+    TEST_ASSERT_TRUE(other->requestData().isOk());
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, device->waitForData(pdMS_TO_TICKS(100)));
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, other->waitForData(pdMS_TO_TICKS(100)));
+    
+    // One of the two transactions had to wait for the other
+    uint64_t waited = device->getStats().busWaitUs + other->getStats().busWaitUs;
+    TEST_ASSERT_TRUE(waited >= 5000);
+    
+    delete other;
+    device->shareInterfaceMutex(nullptr);
+    vSemaphoreDelete(bus);
+}
+
+void test_scripted_stream() {
+    static const float frames[] = {1.0f, 10.0f, 2.0f, 20.0f, 3.0f, 30.0f};
+    device->initialize();
+    device->setDataScript(IDeviceInstance::DeviceDataType::TEMPERATURE, frames, 3, 2);
+    
+    device->startStream(pdMS_TO_TICKS(5));
+    for (int i = 0; i < 100 && device->getStats().streamSamples < 4; i++) {
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+    device->stopStream();
+    
+    uint32_t samples = device->getStats().streamSamples;
+    TEST_ASSERT_TRUE(samples >= 4);
+    TEST_ASSERT_TRUE(device->processData().isOk());
+    
+    // Sample n publishes frame (n - 1) % 3
+    auto result = device->getData(IDeviceInstance::DeviceDataType::TEMPERATURE);
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_EQUAL(2, result.value().size());
+    const float* expected = frames + ((samples - 1) % 3) * 2;
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, expected[0], result.value()[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, expected[1], result.value()[1]);
+}
+
+// Deadband tests
+
+// Runs TEMPERATURE readings (tenths) through a DeviceDeadband like processData() would
+class DeadbandMock : public MockDeviceInstance {
+public:
+    DeviceResult<void> setDeadband(DeviceDataType dataType, ScaledValue threshold,
+                                   uint32_t maxSilenceMs = 0) override {
+        return deadband_.configure(dataType, threshold, maxSilenceMs);
+    }
+
+    DeviceResult<void> clearDeadband(DeviceDataType dataType) override {
+        return deadband_.clear(dataType);
+    }
+
+    // Returns the ChannelMask a DATA_READY would carry, 0 if it is suppressed
+    ChannelMask deliver(std::initializer_list<int16_t> tenths, int64_t nowUs) {
+        int16_t raw[MAX_CHANNELS];
+        size_t count = 0;
+        for (int16_t value : tenths) {
+            raw[count++] = value;
+        }
+        const ChannelMask changed = deadband_.update(DeviceDataType::TEMPERATURE, raw, count, 10, nowUs);
+        published += changed != 0 ? 1 : 0;
+        return changed;
+    }
+
+    int published = 0;
+
+private:
+    DeviceDeadband deadband_;
+};
+
+void test_deadband_suppresses_small_changes() {
+    using DataType = IDeviceInstance::DeviceDataType;
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::NOT_SUPPORTED,
+                      device->setDeadband(DataType::TEMPERATURE, ScaledValue(5, 10)).error());
+
+    DeadbandMock sensor;
+    IDeviceInstance& driver = sensor;
+    TEST_ASSERT_EQUAL(0x3u, sensor.deliver({215, 300}, 0));    // Unfiltered: every reading
+    TEST_ASSERT_EQUAL(0x3u, sensor.deliver({215, 300}, 1000));
+
+    // 0.5 degree band, given in hundredths to check the divider is honoured
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::INVALID_PARAMETER,
+                      driver.setDeadband(DataType::TEMPERATURE, ScaledValue(-1, 10)).error());
+    TEST_ASSERT_TRUE(driver.setDeadband(DataType::TEMPERATURE, ScaledValue(50, 100)).isOk());
+    TEST_ASSERT_EQUAL(0x3u, sensor.deliver({215, 300}, 2000));   // Primes the reference
+    TEST_ASSERT_EQUAL(0u, sensor.deliver({220, 296}, 3000));     // Inside the band
+    TEST_ASSERT_EQUAL(0u, sensor.deliver({210, 304}, 4000));     // Exactly 0.5 is not beyond it
+    TEST_ASSERT_EQUAL(0x1u, sensor.deliver({221, 304}, 5000));   // Channel 0 moved 0.6
+    TEST_ASSERT_EQUAL(0u, sensor.deliver({225, 299}, 6000));     // Measured from the last report
+    TEST_ASSERT_EQUAL(0x2u, sensor.deliver({225, 294}, 7000));
+    TEST_ASSERT_EQUAL(5, sensor.published);
+
+    // Clearing resumes publishing every reading
+    TEST_ASSERT_TRUE(driver.clearDeadband(DataType::TEMPERATURE).isOk());
+    TEST_ASSERT_EQUAL(0x3u, sensor.deliver({225, 294}, 8000));
+    TEST_ASSERT_EQUAL(0x3u, sensor.deliver({225, 294}, 9000));
+    TEST_ASSERT_EQUAL(7, sensor.published);
+}
+
+void test_deadband_max_silence() {
+    using DataType = IDeviceInstance::DeviceDataType;
+    DeadbandMock sensor;
+    TEST_ASSERT_TRUE(sensor.setDeadband(DataType::TEMPERATURE, ScaledValue(10, 10), 100).isOk());
+    TEST_ASSERT_EQUAL(0x1u, sensor.deliver({200}, 0));
+    TEST_ASSERT_EQUAL(0u, sensor.deliver({201}, 50000));
+    TEST_ASSERT_EQUAL(0x1u, sensor.deliver({201}, 100000));       // Heartbeat after 100 ms
+    TEST_ASSERT_EQUAL(0u, sensor.deliver({205}, 150000));
+    TEST_ASSERT_EQUAL(0x3u, sensor.deliver({205, 100}, 160000));  // Channel count changed
+}
+
+// Snapshot tests
+
+// Publishes TEMPERATURE and HUMIDITY through PublishedSlots; no slot for other types
+class PublishingMock : public MockDeviceInstance {
+public:
+    void publish(DeviceDataType dataType, std::initializer_list<float> values) {
+        PublishedData data;
+        for (float value : values) {
+            data.values.push_back(value);
+        }
+        publishData(slots_[slotIndex(dataType)], data);
+    }
+
+    const PublishedSlot* getPublishedSlot(DeviceDataType dataType) const noexcept override {
+        const int index = slotIndex(dataType);
+        return index >= 0 ? &slots_[index] : nullptr;
+    }
+
+private:
+    static int slotIndex(DeviceDataType dataType) noexcept {
+        return dataType == DeviceDataType::TEMPERATURE ? 0 : dataType == DeviceDataType::HUMIDITY ? 1 : -1;
+    }
+
+    PublishedSlot slots_[2];
+};
+
+void test_snapshot_default_copies_published_slots() {
+    using DataType = IDeviceInstance::DeviceDataType;
+    const auto temperature = IDeviceInstance::dataTypeBit(DataType::TEMPERATURE);
+    const auto humidity = IDeviceInstance::dataTypeBit(DataType::HUMIDITY);
+    PublishingMock sensor;
+    IDeviceInstance::DeviceSnapshot snapshot;
+
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::INVALID_PARAMETER, sensor.getSnapshot(0, snapshot).error());
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::INVALID_PARAMETER,
+                      sensor.getSnapshot(IDeviceInstance::DataTypeMask(1) << IDeviceInstance::NUM_DATA_TYPES,
+                                         snapshot).error());
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::DATA_NOT_READY,
+                      sensor.getSnapshot(temperature | humidity, snapshot).error());
+
+    // Only published types are captured, each with its own stamp
+    sensor.publish(DataType::TEMPERATURE, {21.5f, 22.0f});
+    sensor.publish(DataType::TEMPERATURE, {21.6f, 22.1f});
+    TEST_ASSERT_TRUE(sensor.getSnapshot(temperature | humidity, snapshot).isOk());
+    TEST_ASSERT_EQUAL(temperature, snapshot.validMask);
+    const auto& values = snapshot.values[static_cast<size_t>(DataType::TEMPERATURE)];
+    TEST_ASSERT_EQUAL(2, values.size());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 22.1f, values[1]);
+    TEST_ASSERT_EQUAL(2, snapshot.stamps[static_cast<size_t>(DataType::TEMPERATURE)].generation);
+    TEST_ASSERT_EQUAL(0, snapshot.stamps[static_cast<size_t>(DataType::HUMIDITY)].generation);
+
+    sensor.publish(DataType::HUMIDITY, {55.0f});
+    TEST_ASSERT_TRUE(sensor.getSnapshot(temperature | humidity, snapshot).isOk());
+    TEST_ASSERT_EQUAL(temperature | humidity, snapshot.validMask);
+    TEST_ASSERT_EQUAL(1, snapshot.stamps[static_cast<size_t>(DataType::HUMIDITY)].generation);
+
+    // A requested type without a slot fails the whole snapshot
+    const auto pressure = IDeviceInstance::dataTypeBit(DataType::PRESSURE);
+    auto result = sensor.getSnapshot(temperature | pressure, snapshot);
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::NOT_SUPPORTED, result.error());
+    TEST_ASSERT_EQUAL(0, snapshot.validMask);
+}
+
+void test_snapshot_bounded_mutex_wait() {
+    struct Holder {
+        SemaphoreHandle_t mutex;
+        SemaphoreHandle_t taken;
+        SemaphoreHandle_t release;
+        SemaphoreHandle_t done;
+    };
+    PublishingMock sensor;
+    sensor.publish(IDeviceInstance::DeviceDataType::TEMPERATURE, {20.0f});
+    Holder holder = {sensor.getMutexInstance(), xSemaphoreCreateBinary(), xSemaphoreCreateBinary(),
+                     xSemaphoreCreateBinary()};
+
+    // A writer stuck inside processData() holds the instance mutex
+    xTaskCreate([](void* param) {
+        auto* h = static_cast<Holder*>(param);
+        xSemaphoreTake(h->mutex, portMAX_DELAY);
+        xSemaphoreGive(h->taken);
+        xSemaphoreTake(h->release, portMAX_DELAY);
+        xSemaphoreGive(h->mutex);
+        xSemaphoreGive(h->done);
+        vTaskDelete(nullptr);
+    }, "StuckWriter", 2048, &holder, 1, nullptr);
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(holder.taken, pdMS_TO_TICKS(1000)));
+
+    IDeviceInstance::DeviceSnapshot snapshot;
+    const int64_t start = esp_timer_get_time();
+    const auto temperature = IDeviceInstance::dataTypeBit(IDeviceInstance::DeviceDataType::TEMPERATURE);
+    auto result = sensor.getSnapshot(temperature, snapshot);
+    const int64_t waitedMs = (esp_timer_get_time() - start) / 1000;
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::MUTEX_ERROR, result.error());
+    TEST_ASSERT_TRUE(waitedMs >= IDEV_SNAPSHOT_MUTEX_TIMEOUT_MS - 1);
+    TEST_ASSERT_TRUE(waitedMs < 500);
+
+    xSemaphoreGive(holder.release);
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(holder.done, pdMS_TO_TICKS(1000)));
+    TEST_ASSERT_TRUE(sensor.getSnapshot(temperature, snapshot).isOk());
+    vSemaphoreDelete(holder.taken);
+    vSemaphoreDelete(holder.release);
+    vSemaphoreDelete(holder.done);
+}
+
+// getDataFresh() tests
+
+// Asynchronous driver sharing one flight between concurrent requesters;
+// the test plays the bus response handler through respond()
+class CoalescingMock : public PublishingMock {
+public:
+    using PublishingMock::waitForData;
+
+    CoalescingMock() : group_(xEventGroupCreate()), flight_(group_, BIT5), pendingId_(0), transactions(0) {
+        initialize();
+    }
+
+    ~CoalescingMock() override {
+        vEventGroupDelete(group_);
+    }
+
+    DeviceResult<void> requestData() override {
+        const auto flight = flight_.begin();
+        if (flight.join == DeviceRequestCoalescer::Join::STARTED) {
+            pendingId_ = flight.id;
+            transactions++;
+        }
+        return DeviceResult<void>();
+    }
+
+    DeviceError waitForData(TickType_t xTicksToWait) override {
+        return flight_.wait(xTicksToWait);
+    }
+
+    DeviceRequestCoalescer* getRequestCoalescer() noexcept override {
+        return &flight_;
+    }
+
+    void respond(float value) {
+        publish(DeviceDataType::TEMPERATURE, {value});
+        flight_.complete(pendingId_);
+    }
+
+    EventGroupHandle_t group_;
+    DeviceRequestCoalescer flight_;
+    std::atomic<uint32_t> pendingId_;
+    std::atomic<int> transactions;
+};
+
+struct FreshReader {
+    IDeviceInstance* device;
+    SemaphoreHandle_t done;
+    IDeviceInstance::DeviceError result;
+    float value;
+    uint32_t generation;
+};
+
+static void readFresh(void* param) {
+    auto* reader = static_cast<FreshReader*>(param);
+    IDeviceInstance::DataStamp stamp;
+    auto values = reader->device->getDataFresh(IDeviceInstance::DeviceDataType::TEMPERATURE, 0,
+                                               pdMS_TO_TICKS(1000), &stamp);
+    reader->result = values.isOk() ? IDeviceInstance::DeviceError::SUCCESS : values.error();
+    reader->value = values.isOk() && values.value().size() > 0 ? values.value()[0] : 0.0f;
+    reader->generation = stamp.generation;
+    xSemaphoreGive(reader->done);
+    vTaskDelete(nullptr);
+}
+
+void test_get_data_fresh_joins_flight_in_progress() {
+    CoalescingMock sensor;
+    FreshReader readers[2];
+    for (auto& reader : readers) {
+        reader = {&sensor, xSemaphoreCreateBinary(), IDeviceInstance::DeviceError::UNKNOWN_ERROR, 0.0f, 0};
+        xTaskCreate(&readFresh, "FreshReader", 2048, &reader, 1, nullptr);
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+
+    // Both readers wait on the same flight; one bus transaction serves them
+    TEST_ASSERT_TRUE(sensor.flight_.inFlight());
+    TEST_ASSERT_EQUAL(1, sensor.transactions.load());
+    sensor.respond(23.5f);
+    for (auto& reader : readers) {
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(reader.done, pdMS_TO_TICKS(1000)));
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, reader.result);
+        TEST_ASSERT_FLOAT_WITHIN(0.001f, 23.5f, reader.value);
+        TEST_ASSERT_EQUAL(1, reader.generation);
+        vSemaphoreDelete(reader.done);
+    }
+    TEST_ASSERT_EQUAL(1, sensor.transactions.load());
+    TEST_ASSERT_EQUAL(1, sensor.flight_.startedCount());
+
+    // Young enough data is served from the cache without a transaction
+    IDeviceInstance::DataStamp stamp;
+    auto cached = sensor.getDataFresh(IDeviceInstance::DeviceDataType::TEMPERATURE, 1000, 0, &stamp);
+    TEST_ASSERT_TRUE(cached.isOk());
+    TEST_ASSERT_EQUAL(1, stamp.generation);
+    TEST_ASSERT_EQUAL(1, sensor.transactions.load());
+
+    // Without a response the refresh times out
+    auto late = sensor.getDataFresh(IDeviceInstance::DeviceDataType::TEMPERATURE, 0, pdMS_TO_TICKS(5));
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::TIMEOUT, late.error());
+    TEST_ASSERT_EQUAL(2, sensor.transactions.load());
+}
+
+void test_get_data_fresh_without_coalescer() {
+    // Plain driver: requestData(), waitForData() and processData() in the caller
+    device->initialize();
+    device->setDataLatency(MockDeviceInstance::LatencyProfile::fixedMs(5));
+    device->setTestData(IDeviceInstance::DeviceDataType::TEMPERATURE, {19.5f, 20.5f});
+    TEST_ASSERT_NULL(device->getRequestCoalescer());
+
+    auto values = device->getDataFresh(IDeviceInstance::DeviceDataType::TEMPERATURE, 0, pdMS_TO_TICKS(500));
+    TEST_ASSERT_TRUE(values.isOk());
+    TEST_ASSERT_EQUAL(2, values.value().size());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 20.5f, values.value()[1]);
+    TEST_ASSERT_EQUAL(1, device->getStats().requests);
+    TEST_ASSERT_EQUAL(1, device->getStats().completed);
+
+    // The remaining timeout is passed on to waitForData()
+    device->setDataLatency(MockDeviceInstance::LatencyProfile::fixedMs(100));
+    auto late = device->getDataFresh(IDeviceInstance::DeviceDataType::TEMPERATURE, 0, pdMS_TO_TICKS(10));
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::TIMEOUT, late.error());
+
+    // Request errors are returned as they are
+    vTaskDelay(pdMS_TO_TICKS(150));
+    device->injectError(IDeviceInstance::DeviceError::COMMUNICATION_ERROR);
+    auto failed = device->getDataFresh(IDeviceInstance::DeviceDataType::TEMPERATURE, 0, pdMS_TO_TICKS(10));
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::COMMUNICATION_ERROR, failed.error());
+}
+
+// Capability descriptor tests
+
+class DeclaredMock : public MockDeviceInstance {
+public:
+    static constexpr DeviceCapabilities CAPABILITIES = DeviceCapabilities()
+        .withType(DeviceDataType::TEMPERATURE, 8, 10)
+        .withType(DeviceDataType::PRESSURE, 2)
+        .withChannelDivider(DeviceDataType::TEMPERATURE, 3, 100)
+        .withMinInterval(100);
+
+    const DeviceCapabilities& getCapabilities() const noexcept override {
+        return CAPABILITIES;
+    }
+};
+
+void test_capabilities_descriptor() {
+    using DataType = IDeviceInstance::DeviceDataType;
+    static_assert(DeclaredMock::CAPABILITIES.isDeclared(), "descriptor is constexpr");
+    static_assert(DeclaredMock::CAPABILITIES.channels(DataType::TEMPERATURE) == 8, "channels are constexpr");
+
+    // Undeclared: unknown, nothing is excluded
+    TEST_ASSERT_FALSE(device->hasCapabilities());
+    TEST_ASSERT_TRUE(device->supportsDataType(DataType::HUMIDITY));
+
+    DeclaredMock declared;
+    const IDeviceInstance& view = declared;
+    const auto& caps = view.getCapabilities();
+    TEST_ASSERT_EQUAL_PTR(&DeclaredMock::CAPABILITIES, &caps);
+    TEST_ASSERT_TRUE(view.hasCapabilities());
+    TEST_ASSERT_TRUE(view.supportsDataType(DataType::TEMPERATURE));
+    TEST_ASSERT_FALSE(view.supportsDataType(DataType::HUMIDITY));
+    TEST_ASSERT_FALSE(caps.mayProvide(DataType::HUMIDITY));
+    TEST_ASSERT_EQUAL(8, caps.maxChannels());
+    TEST_ASSERT_EQUAL(2, caps.channels(DataType::PRESSURE));
+    TEST_ASSERT_EQUAL(10, caps.divider(DataType::TEMPERATURE, 0));
+    TEST_ASSERT_EQUAL(100, caps.divider(DataType::TEMPERATURE, 3));
+    TEST_ASSERT_EQUAL(1, caps.divider(DataType::TEMPERATURE, 8));     // Beyond the declared channels
+    TEST_ASSERT_EQUAL(100, caps.minIntervalMs);
+}
+
+// Registry tests
+
+static void setInitMs(MockDeviceInstance& mock, uint32_t ms) {
+    mock.setInitLatency(MockDeviceInstance::LatencyProfile::fixedMs(ms));
+}
+
+void test_registry_parallel_bus_init() {
+    SemaphoreHandle_t bus = xSemaphoreCreateMutex();
+    MockDeviceInstance first;
+    MockDeviceInstance second;
+    MockDeviceInstance other;
+    DeclaredMock declared;
+    first.shareInterfaceMutex(bus);
+    second.shareInterfaceMutex(bus);
+    setInitMs(first, 30);
+    setInitMs(second, 30);
+    setInitMs(other, 30);
+
+    {
+        DeviceRegistry registry;
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, registry.add(&first, 0x01));
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, registry.add(&second, 0x02));
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, registry.add(&other, 0x10));
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, registry.add(&declared, 0x20));
+        TEST_ASSERT_EQUAL(3, registry.busGroupCount());
+
+        const int64_t start = esp_timer_get_time();
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, registry.initializeAll(pdMS_TO_TICKS(1000)));
+        const int64_t elapsedUs = esp_timer_get_time() - start;
+        TEST_ASSERT_FALSE(registry.isInitializing());
+        TEST_ASSERT_EQUAL(0, registry.failedCount());
+        TEST_ASSERT_TRUE(first.isInitialized() && second.isInitialized() && other.isInitialized());
+
+        // The shared bus takes turns, the other buses overlap with it
+        const auto a = registry.getInitReport(0);
+        const auto b = registry.getInitReport(1);
+        const auto c = registry.getInitReport(2);
+        TEST_ASSERT_EQUAL(a.busGroup, b.busGroup);
+        TEST_ASSERT_NOT_EQUAL(a.busGroup, c.busGroup);
+        TEST_ASSERT_TRUE(a.durationUs >= 30000 && b.durationUs >= 30000 && c.durationUs >= 30000);
+        TEST_ASSERT_TRUE(b.startOffsetUs >= a.startOffsetUs + a.durationUs);
+        TEST_ASSERT_TRUE(c.startOffsetUs < b.startOffsetUs);
+        TEST_ASSERT_TRUE(elapsedUs < 90000);    // Less than the 3 x 30 ms of a serial boot
+
+        // Lookup by ID and by data type
+        TEST_ASSERT_EQUAL_PTR(&second, registry.find(0x02));
+        TEST_ASSERT_NULL(registry.find(0x03));
+        TEST_ASSERT_EQUAL(0x20, registry.idAt(3));
+        TEST_ASSERT_EQUAL(0x7u, registry.unknownCapabilities());
+        TEST_ASSERT_EQUAL(0x8u, registry.devicesWith(IDeviceInstance::DeviceDataType::TEMPERATURE));
+        TEST_ASSERT_EQUAL(0xFu, registry.candidatesFor(IDeviceInstance::DeviceDataType::TEMPERATURE));
+        TEST_ASSERT_EQUAL_PTR(&declared, registry.firstWith(IDeviceInstance::DeviceDataType::TEMPERATURE));
+        TEST_ASSERT_EQUAL_PTR(&first, registry.firstWith(IDeviceInstance::DeviceDataType::HUMIDITY));
+    }
+    first.shareInterfaceMutex(nullptr);
+    second.shareInterfaceMutex(nullptr);
+    vSemaphoreDelete(bus);
+}
+
+void test_registry_deadline_and_rejection() {
+    DeviceRegistry full;
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::INVALID_PARAMETER, full.add(nullptr, 1));
+    for (size_t i = 0; i < DeviceRegistry::MAX_DEVICES; i++) {
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, full.add(device, static_cast<uint8_t>(i)));
+    }
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::INVALID_PARAMETER, full.add(device, 0));   // Duplicate ID
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::MEMORY_ERROR, full.add(device, 200));
+    TEST_ASSERT_EQUAL(DeviceRegistry::MAX_DEVICES, full.size());
+
+    SemaphoreHandle_t bus = xSemaphoreCreateMutex();
+    MockDeviceInstance slow;
+    MockDeviceInstance queued;
+    MockDeviceInstance fast;
+    slow.shareInterfaceMutex(bus);
+    queued.shareInterfaceMutex(bus);
+    setInitMs(slow, 150);
+    {
+        DeviceRegistry registry;
+        registry.add(&slow, 1);
+        registry.add(&queued, 2);
+        registry.add(&fast, 3);
+
+        const int64_t start = esp_timer_get_time();
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::TIMEOUT, registry.initializeAll(pdMS_TO_TICKS(40)));
+        TEST_ASSERT_TRUE(esp_timer_get_time() - start < 120000);
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::TIMEOUT, registry.getInitReport(0).result);
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::TIMEOUT, registry.getInitReport(1).result);
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, registry.getInitReport(2).result);
+
+        // Still running after the deadline: the registry is locked
+        TEST_ASSERT_TRUE(registry.isInitializing());
+        MockDeviceInstance late;
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::DEVICE_BUSY, registry.add(&late, 4));
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::DEVICE_BUSY, registry.initializeAll(pdMS_TO_TICKS(40)));
+
+        while (registry.isInitializing()) {
+            vTaskDelay(pdMS_TO_TICKS(5));
+        }
+        // The slow device finished late; the one queued behind it was never started
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, registry.getInitReport(0).result);
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::TIMEOUT, registry.getInitReport(1).result);
+        TEST_ASSERT_FALSE(queued.isInitialized());
+        TEST_ASSERT_EQUAL(1, registry.failedCount());
+    }
+    slow.shareInterfaceMutex(nullptr);
+    queued.shareInterfaceMutex(nullptr);
+    vSemaphoreDelete(bus);
+}
+
+void test_registry_destroyed_while_initializing() {
+    MockDeviceInstance slow;
+    MockDeviceInstance other;
+    setInitMs(slow, 100);
+    setInitMs(other, 60);
+    auto* registry = new DeviceRegistry();
+    registry->add(&slow, 1);
+    registry->add(&other, 2);
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::TIMEOUT, registry->initializeAll(pdMS_TO_TICKS(10)));
+    TEST_ASSERT_TRUE(registry->isInitializing());
+
+    // The destructor waits for the init tasks that still reference the registry
+    const int64_t start = esp_timer_get_time();
+    delete registry;
+    TEST_ASSERT_TRUE(esp_timer_get_time() - start >= 50000);
+    TEST_ASSERT_TRUE(slow.isInitialized());
+    TEST_ASSERT_TRUE(other.isInitialized());
+}
+
+// Telemetry codec tests
+
+// Publishes fixed raw TEMPERATURE readings for the telemetry codec
+class RawTestDevice : public MockDeviceInstance {
+public:
+    using MockDeviceInstance::getDataScaleDivider;
+
+    void setRaw(const int16_t* raw, const int16_t* dividers, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            raw_[i] = raw[i];
+            dividers_[i] = dividers[i];
+        }
+        count_ = count;
+    }
+
+    DeviceResult<size_t> getDataRawInto(DeviceDataType dataType, int16_t* out, size_t capacity) override {
+        if (dataType != DeviceDataType::TEMPERATURE) {
+            return DeviceResult<size_t>(DeviceError::NOT_SUPPORTED);
+        }
+        const size_t n = count_ < capacity ? count_ : capacity;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = raw_[i];
+        }
+        return DeviceResult<size_t>(n);
+    }
+
+    int16_t getDataScaleDivider(DeviceDataType dataType, uint8_t channel) const override {
+        (void)dataType;
+        return channel < count_ ? dividers_[channel] : 1;
+    }
+
+private:
+    int16_t raw_[IDeviceInstance::MAX_CHANNELS] = {};
+    int16_t dividers_[IDeviceInstance::MAX_CHANNELS] = {};
+    size_t count_ = 0;
+};
+
+struct DecodedTelemetry {
+    uint8_t deviceId = 0;
+    size_t count = 0;
+    ScaledValue values[IDeviceInstance::MAX_CHANNELS];
+};
+
+static void captureTelemetry(void* context, uint8_t deviceId, IDeviceInstance::DeviceDataType dataType,
+                             const ScaledValue* values, size_t count) {
+    auto* decoded = static_cast<DecodedTelemetry*>(context);
+    TEST_ASSERT_EQUAL(static_cast<int>(IDeviceInstance::DeviceDataType::TEMPERATURE), static_cast<int>(dataType));
+    decoded->deviceId = deviceId;
+    decoded->count = count;
+    for (size_t i = 0; i < count; i++) {
+        decoded->values[i] = values[i];
+    }
+}
+
+void test_telemetry_codec_round_trip() {
+    RawTestDevice sensor;
+    DeviceTelemetryEncoder encoder(4);
+    DeviceTelemetryDecoder decoder;
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS,
+                      encoder.add(&sensor, 0x21, IDeviceInstance::dataTypeBit(IDeviceInstance::DeviceDataType::TEMPERATURE)));
+
+    const int16_t dividers[] = {10, 10, 10};
+    uint8_t frame[64];
+    size_t keySize = 0;
+    for (int i = 0; i < 8; i++) {
+        const int16_t raw[] = {static_cast<int16_t>(215 + i), -40, static_cast<int16_t>(30000 - i * 1000)};
+        sensor.setRaw(raw, dividers, 3);
+        auto encoded = encoder.encode(frame, sizeof(frame));
+        TEST_ASSERT_TRUE(encoded.isOk());
+        if (i == 0) {
+            keySize = encoded.value();
+        } else if (i % 4 != 0) {
+            TEST_ASSERT_TRUE(encoded.value() < keySize);    // Delta frame
+        }
+
+        DecodedTelemetry decoded;
+        auto result = decoder.decode(frame, encoded.value(), &captureTelemetry, &decoded);
+        TEST_ASSERT_TRUE(result.isOk());
+        TEST_ASSERT_EQUAL(1, result.value());
+        TEST_ASSERT_EQUAL(0x21, decoded.deviceId);
+        TEST_ASSERT_EQUAL(3, decoded.count);
+        for (size_t ch = 0; ch < 3; ch++) {
+            TEST_ASSERT_EQUAL(raw[ch], decoded.values[ch].raw());
+            TEST_ASSERT_EQUAL(10, decoded.values[ch].divider());
+        }
+    }
+    TEST_ASSERT_EQUAL(8, encoder.sequence());
+
+    // A truncated frame is rejected and drops synchronization
+    auto encoded = encoder.encode(frame, sizeof(frame));
+    TEST_ASSERT_TRUE(encoded.isOk());
+    auto truncated = decoder.decode(frame, encoded.value() - 1);
+    TEST_ASSERT_FALSE(truncated.isOk());
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::INVALID_PARAMETER, truncated.error());
+    TEST_ASSERT_FALSE(decoder.isSynced());
+}
+
+void test_telemetry_codec_sequence_gap() {
+    RawTestDevice sensor;
+    DeviceTelemetryEncoder encoder(100);
+    DeviceTelemetryDecoder decoder;
+    encoder.add(&sensor, 1);
+
+    const int16_t dividers[] = {100};
+    uint8_t frame[32];
+    int16_t raw[] = {1000};
+    sensor.setRaw(raw, dividers, 1);
+    auto key = encoder.encode(frame, sizeof(frame));
+    TEST_ASSERT_TRUE(decoder.decode(frame, key.value()).isOk());
+
+    // Lose one delta frame: the next one must not be applied
+    raw[0] = 1100;
+    sensor.setRaw(raw, dividers, 1);
+    TEST_ASSERT_TRUE(encoder.encode(frame, sizeof(frame)).isOk());
+    raw[0] = 1200;
+    sensor.setRaw(raw, dividers, 1);
+    auto delta = encoder.encode(frame, sizeof(frame));
+    DecodedTelemetry decoded;
+    auto gap = decoder.decode(frame, delta.value(), &captureTelemetry, &decoded);
+    TEST_ASSERT_FALSE(gap.isOk());
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::DATA_NOT_READY, gap.error());
+    TEST_ASSERT_EQUAL(0, decoded.count);
+    TEST_ASSERT_FALSE(decoder.isSynced());
+
+    // Later delta frames stay rejected until the next key frame
+    raw[0] = 1300;
+    sensor.setRaw(raw, dividers, 1);
+    delta = encoder.encode(frame, sizeof(frame));
+    TEST_ASSERT_FALSE(decoder.decode(frame, delta.value()).isOk());
+
+    encoder.forceKeyFrame();
+    raw[0] = 1400;
+    sensor.setRaw(raw, dividers, 1);
+    key = encoder.encode(frame, sizeof(frame));
+    TEST_ASSERT_TRUE(decoder.decode(frame, key.value(), &captureTelemetry, &decoded).isOk());
+    TEST_ASSERT_TRUE(decoder.isSynced());
+    TEST_ASSERT_EQUAL(1400, decoded.values[0].raw());
+}
+
+void test_telemetry_codec_divider_change() {
+    RawTestDevice sensor;
+    DeviceTelemetryEncoder encoder(100);
+    DeviceTelemetryDecoder decoder;
+    encoder.add(&sensor, 7);
+
+    uint8_t frame[48];
+    DecodedTelemetry decoded;
+    const int16_t raw[] = {2205, 2210};
+    const int16_t coarse[] = {10, 10};
+    const int16_t mixed[] = {100, 10};   // e.g. PT1000 high-res next to PT100
+
+    sensor.setRaw(raw, coarse, 2);
+    auto encoded = encoder.encode(frame, sizeof(frame));
+    TEST_ASSERT_TRUE(decoder.decode(frame, encoded.value(), &captureTelemetry, &decoded).isOk());
+
+    // Divider change inside a delta frame
+    sensor.setRaw(raw, mixed, 2);
+    encoded = encoder.encode(frame, sizeof(frame));
+    TEST_ASSERT_TRUE(decoder.decode(frame, encoded.value(), &captureTelemetry, &decoded).isOk());
+    TEST_ASSERT_EQUAL(100, decoded.values[0].divider());
+    TEST_ASSERT_EQUAL(10, decoded.values[1].divider());
+    TEST_ASSERT_EQUAL(2205, decoded.values[0].raw());
+
+    // Unchanged dividers are carried over by the decoder
+    encoded = encoder.encode(frame, sizeof(frame));
+    TEST_ASSERT_TRUE(decoder.decode(frame, encoded.value(), &captureTelemetry, &decoded).isOk());
+    TEST_ASSERT_EQUAL(100, decoded.values[0].divider());
+    TEST_ASSERT_EQUAL(10, decoded.values[1].divider());
+
+    // Channel count change falls back to absolute values
+    sensor.setRaw(raw, coarse, 1);
+    encoded = encoder.encode(frame, sizeof(frame));
+    TEST_ASSERT_TRUE(decoder.decode(frame, encoded.value(), &captureTelemetry, &decoded).isOk());
+    TEST_ASSERT_EQUAL(1, decoded.count);
+    TEST_ASSERT_EQUAL(2205, decoded.values[0].raw());
+    TEST_ASSERT_EQUAL(10, decoded.values[0].divider());
+}
+
+// State blob tests
+
+void test_state_blob_rejects_corruption() {
+    struct State {
+        uint32_t calibration;
+        int16_t offsets[4];
+    };
+    const uint32_t tag = DeviceStateBlob::makeTag('T', 'E', 'S', 'T');
+    const State saved = {0xC0FFEE, {1, -2, 3, -4}};
+
+    DeviceStateBlob empty;
+    TEST_ASSERT_FALSE(empty.isValid());
+
+    DeviceStateBlob blob;
+    TEST_ASSERT_TRUE(blob.store(tag, 2, saved));
+    State loaded = {};
+    TEST_ASSERT_TRUE(blob.load(tag, 2, loaded));
+    TEST_ASSERT_EQUAL(saved.calibration, loaded.calibration);
+    TEST_ASSERT_EQUAL(saved.offsets[3], loaded.offsets[3]);
+
+    // Wrong driver or payload layout
+    TEST_ASSERT_FALSE(blob.load(DeviceStateBlob::makeTag('T', 'E', 'S', 'U'), 2, loaded));
+    TEST_ASSERT_FALSE(blob.load(tag, 3, loaded));
+    TEST_ASSERT_TRUE(blob.isValid());
+
+    // One flipped payload bit fails the CRC
+    DeviceStateBlob corrupted = blob;
+    uint8_t bytes[sizeof(DeviceStateBlob)];
+    std::memcpy(bytes, &corrupted, sizeof(bytes));
+    bytes[sizeof(bytes) - DeviceStateBlob::CAPACITY + 1] ^= 0x04;
+    std::memcpy(&corrupted, bytes, sizeof(bytes));
+    TEST_ASSERT_FALSE(corrupted.isValid());
+    loaded = {};
+    TEST_ASSERT_FALSE(corrupted.load(tag, 2, loaded));
+    TEST_ASSERT_EQUAL(0, loaded.calibration);
+
+    uint8_t buffer[DeviceStateBlob::CAPACITY];
+    TEST_ASSERT_EQUAL(0, corrupted.load(tag, 2, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL(sizeof(State), blob.load(tag, 2, buffer, sizeof(buffer)));
+
+    blob.invalidate();
+    TEST_ASSERT_FALSE(blob.load(tag, 2, loaded));
+}
+
+// History tests
+
+void test_history_summarize_edges() {
+    DeviceHistory history;
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::NOT_INITIALIZED, history.summarize(0, 0, 10).error());
+
+    DeviceHistoryConfig config;
+    config.rawSamples = 16;
+    config.secondBuckets = 60;
+    config.minuteBuckets = 15;
+    config.quarterBuckets = 4;
+    config.preferPsram = false;
+    TEST_ASSERT_TRUE(history.begin(config).isOk());
+
+    // One sample per second for two minutes, value = second
+    for (int16_t sec = 0; sec < 120; sec++) {
+        TEST_ASSERT_TRUE(history.add(&sec, 1, static_cast<int64_t>(sec) * 1000000).isOk());
+    }
+
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::INVALID_PARAMETER, history.summarize(0, 20, 10).error());
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::INVALID_PARAMETER, history.summarize(1, 0, 10).error());
+    TEST_ASSERT_EQUAL(0, history.summarize(0, 10, 10).value().count);     // Empty range
+    TEST_ASSERT_EQUAL(0, history.summarize(0, 500, 600).value().count);   // No data in range
+
+    auto all = history.summarize(0, 0, 120).value();
+    TEST_ASSERT_EQUAL(120, all.count);
+    TEST_ASSERT_EQUAL(0, all.min);
+    TEST_ASSERT_EQUAL(119, all.max);
+    TEST_ASSERT_INT_WITHIN(1, 60, all.avg);
+    TEST_ASSERT_FALSE(all.approximate);
+
+    // Seconds 0..58 have expired: the leading edge widens to its minute bucket
+    auto widened = history.summarize(0, 30, 90).value();
+    TEST_ASSERT_TRUE(widened.approximate);
+    TEST_ASSERT_EQUAL(90, widened.count);
+    TEST_ASSERT_EQUAL(0, widened.min);
+    TEST_ASSERT_EQUAL(89, widened.max);
+
+    auto exact = history.summarize(0, 70, 80).value();
+    TEST_ASSERT_FALSE(exact.approximate);
+    TEST_ASSERT_EQUAL(10, exact.count);
+    TEST_ASSERT_EQUAL(70, exact.min);
+    TEST_ASSERT_EQUAL(79, exact.max);
+
+    // A timestamp before the previous sample is rejected
+    int16_t late = 1;
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::INVALID_PARAMETER, history.add(&late, 1, 0).error());
+}
+
+void test_history_summarize_large_sums() {
+    DeviceHistory history;
+    DeviceHistoryConfig config;
+    config.rawSamples = 0;
+    config.secondBuckets = 60;
+    config.minuteBuckets = 15;
+    config.quarterBuckets = 4;
+    config.preferPsram = false;
+    TEST_ASSERT_TRUE(history.begin(config).isOk());
+
+    // 80000 samples of 30000 in one 15 min bucket overflow a 32-bit sum
+    const int16_t value = 30000;
+    for (int i = 0; i < 80000; i++) {
+        history.add(&value, 1, static_cast<int64_t>(i) * 10000);
+    }
+    auto summary = history.summarize(0, 0, 900).value();
+    TEST_ASSERT_EQUAL(80000, summary.count);
+    TEST_ASSERT_EQUAL(30000, summary.avg);
+    TEST_ASSERT_EQUAL(30000, summary.max);
+}
+
+// Coalescer tests
+
+void test_coalescer_join_and_late_completion() {
+    EventGroupHandle_t group = xEventGroupCreate();
+    DeviceRequestCoalescer flight(group, BIT5);
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::DATA_NOT_READY, flight.wait(0));
+
+    const auto first = flight.begin();
+    TEST_ASSERT_TRUE(first.join == DeviceRequestCoalescer::Join::STARTED);
+    const auto second = flight.begin();
+    TEST_ASSERT_TRUE(second.join == DeviceRequestCoalescer::Join::JOINED);
+    TEST_ASSERT_EQUAL(first.id, second.id);
+    TEST_ASSERT_TRUE(flight.inFlight());
+
+    // A waiter in another task is released by the same completion
+    struct Waiter {
+        DeviceRequestCoalescer* flight;
+        SemaphoreHandle_t done;
+        IDeviceInstance::DeviceError result;
+    } waiter = {&flight, xSemaphoreCreateBinary(), IDeviceInstance::DeviceError::UNKNOWN_ERROR};
+    xTaskCreate([](void* param) {
+        auto* w = static_cast<Waiter*>(param);
+        w->result = w->flight->wait(pdMS_TO_TICKS(1000));
+        xSemaphoreGive(w->done);
+        vTaskDelete(nullptr);
+    }, "CoalescerWaiter", 2048, &waiter, 1, nullptr);
+    vTaskDelay(pdMS_TO_TICKS(10));
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::TIMEOUT, flight.wait(pdMS_TO_TICKS(5)));
+
+    TEST_ASSERT_FALSE(flight.complete(first.id + 1));
+    TEST_ASSERT_TRUE(flight.complete(first.id));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(waiter.done, pdMS_TO_TICKS(1000)));
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, waiter.result);
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, flight.wait(0));
+
+    // A duplicate response changes nothing; fresh data needs no flight
+    TEST_ASSERT_FALSE(flight.complete(first.id, IDeviceInstance::DeviceError::COMMUNICATION_ERROR));
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, flight.wait(0));
+    const auto fresh = flight.begin(1000);
+    TEST_ASSERT_TRUE(fresh.join == DeviceRequestCoalescer::Join::FRESH);
+    TEST_ASSERT_EQUAL(first.id, fresh.id);
+    TEST_ASSERT_EQUAL(1, flight.startedCount());
+    TEST_ASSERT_EQUAL(1, flight.joinedCount());
+    TEST_ASSERT_EQUAL(1, flight.freshCount());
+
+    vSemaphoreDelete(waiter.done);
+    vEventGroupDelete(group);
+}
+
+void test_coalescer_abandoned_flight() {
+    EventGroupHandle_t group = xEventGroupCreate();
+    DeviceRequestCoalescer flight(group, BIT5);
+
+    const auto lost = flight.begin();
+    vTaskDelay(pdMS_TO_TICKS(IDEV_COALESCER_FLIGHT_TIMEOUT_MS + 10));
+    const auto retry = flight.begin();
+    TEST_ASSERT_TRUE(retry.join == DeviceRequestCoalescer::Join::STARTED);
+    TEST_ASSERT_NOT_EQUAL(lost.id, retry.id);
+
+    // The late response to the abandoned flight must not complete the retry
+    TEST_ASSERT_FALSE(flight.complete(lost.id));
+    TEST_ASSERT_TRUE(flight.inFlight());
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::TIMEOUT, flight.wait(pdMS_TO_TICKS(5)));
+
+    TEST_ASSERT_TRUE(flight.complete(retry.id, IDeviceInstance::DeviceError::COMMUNICATION_ERROR));
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::COMMUNICATION_ERROR, flight.wait(0));
+    TEST_ASSERT_TRUE(flight.begin(1000).join == DeviceRequestCoalescer::Join::STARTED);  // Failed data is never fresh
+    TEST_ASSERT_EQUAL(3, flight.startedCount());
+
+    vEventGroupDelete(group);
+}
+
+// Bus scheduler tests
+
+struct SchedulerLog {
+    int timeouts = 0;
+    int successes = 0;
+};
+
+static void recordJob(void* context, IDeviceInstance* device, IDeviceInstance::DeviceError result) {
+    (void)device;
+    auto* log = static_cast<SchedulerLog*>(context);
+    if (result == IDeviceInstance::DeviceError::TIMEOUT) {
+        log->timeouts++;
+    } else if (result == IDeviceInstance::DeviceError::SUCCESS) {
+        log->successes++;
+    }
+}
+
+void test_scheduler_order_and_deadlines() {
+    device->initialize();
+    DeviceBusScheduler scheduler(nullptr, 0);
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, scheduler.attach(device));
+    TEST_ASSERT_EQUAL_PTR(device->getMutexInterface(), scheduler.getBusMutex());
+    vTaskDelay(pdMS_TO_TICKS(5));
+
+    SchedulerLog log;
+    const TickType_t now = xTaskGetTickCount();
+    auto action = [&](int id, uint8_t priority, TickType_t deadline, TickType_t expected) {
+        DeviceBusScheduler::Job job;
+        job.device = device;
+        job.type = DeviceBusScheduler::JobType::PERFORM_ACTION;
+        job.actionId = id;
+        job.priority = priority;
+        job.deadline = deadline;
+        job.expectedDuration = expected;
+        job.onComplete = &recordJob;
+        job.context = &log;
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, scheduler.submit(job));
+    };
+    action(1, 0, 0, 0);
+    action(2, 2, 0, 0);
+    action(3, 1, now + pdMS_TO_TICKS(1000), 0);
+    action(4, 1, now + pdMS_TO_TICKS(500), 0);
+    action(5, 0, 0, 0);
+    action(6, 3, now - 1, 0);                                   // Already expired
+    action(7, 3, now + pdMS_TO_TICKS(20), pdMS_TO_TICKS(100));  // Cannot finish in time
+    TEST_ASSERT_EQUAL(7, scheduler.pendingCount());
+
+    TEST_ASSERT_EQUAL(7, scheduler.runPending());
+    TEST_ASSERT_EQUAL(0, scheduler.pendingCount());
+    TEST_ASSERT_EQUAL(5, scheduler.completedCount());
+    TEST_ASSERT_EQUAL(2, scheduler.expiredCount());
+    TEST_ASSERT_EQUAL(2, log.timeouts);
+    TEST_ASSERT_EQUAL(5, log.successes);
+
+    // Priority, then earliest deadline, then submission order; expired jobs never touch the device
+    const int expected[] = {2, 4, 3, 1, 5};
+    auto actions = device->getPerformedActions();
+    TEST_ASSERT_EQUAL(5, actions.size());
+    for (size_t i = 0; i < actions.size(); i++) {
+        TEST_ASSERT_EQUAL(expected[i], actions[i].first);
+    }
+
+    MockDeviceInstance stranger;
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::INVALID_PARAMETER, scheduler.attach(&stranger));
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::INVALID_PARAMETER, scheduler.submitAction(&stranger, 1, 0));
+}
+
+void test_scheduler_leaves_interface_mutex_to_drivers() {
+    // The mock completes inline and takes getMutexInterface() in the calling task
+    device->initialize();
+    DeviceBusScheduler scheduler;
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, scheduler.attach(device));
+
+    SchedulerLog log;
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS,
+                      scheduler.submitRequest(device, 0, 0, &recordJob, &log));
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS,
+                      scheduler.submitAction(device, 7, 0, 0, &recordJob, &log));
+    TEST_ASSERT_EQUAL(2, scheduler.runPending());
+    TEST_ASSERT_EQUAL(2, log.successes);
+    TEST_ASSERT_EQUAL(1, device->getStats().completed);
+
+    // Nothing is left holding the bus between jobs
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(scheduler.getBusMutex(), 0));
+    xSemaphoreGive(scheduler.getBusMutex());
+}
+
+// Records the options the bus scheduler passes with each request
+class OptionsRecordingDevice : public MockDeviceInstance {
+public:
+    using MockDeviceInstance::requestData;
+
+    DeviceResult<void> requestData(const RequestOptions& options) override {
+        seen.push_back(options);
+        return MockDeviceInstance::requestData(options);
+    }
+
+    std::vector<RequestOptions> seen;
+};
+
+void test_scheduler_passes_request_options() {
+    OptionsRecordingDevice sensor;
+    sensor.initialize();
+    DeviceBusScheduler scheduler;
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, scheduler.attach(&sensor));
+
+    using RP = IDeviceInstance::RequestPriority;
+    const TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(500);
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS,
+                      scheduler.submitRequest(&sensor, IDeviceInstance::RequestOptions(RP::TELEMETRY)));
+    TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS,
+                      scheduler.submitRequest(&sensor, IDeviceInstance::RequestOptions(RP::CONTROL, deadline, 2)));
+    TEST_ASSERT_EQUAL(2, scheduler.runPending());
+
+    TEST_ASSERT_EQUAL(2, sensor.seen.size());
+    TEST_ASSERT_TRUE(sensor.seen[0].priority == RP::CONTROL);
+    TEST_ASSERT_EQUAL(deadline, sensor.seen[0].deadline);
+    TEST_ASSERT_EQUAL(2, sensor.seen[0].expectedDuration);
+    TEST_ASSERT_TRUE(sensor.seen[1].priority == RP::TELEMETRY);
+    TEST_ASSERT_EQUAL(0, sensor.seen[1].deadline);
+}
+
+// Seqlock tests
+
+void test_seqlock_concurrent_writer() {
+    struct Reading {
+        uint32_t sequence;
+        uint32_t payload[14];
+        uint32_t check;     // ~sequence
+    };
+    struct Shared {
+        DeviceSeqLock<Reading> lock;
+        std::atomic<bool> done{false};
+    } shared;
+
+    Reading initial = {};
+    TEST_ASSERT_FALSE(shared.lock.read(initial));
+    TEST_ASSERT_EQUAL(0, initial.sequence);
+
+    const uint32_t publishes = 20000;
+    xTaskCreate([](void* param) {
+        auto* s = static_cast<Shared*>(param);
+        Reading reading;
+        for (uint32_t i = 1; i <= publishes; i++) {
+            reading.sequence = i;
+            for (auto& word : reading.payload) {
+                word = i;
+            }
+            reading.check = ~i;
+            s->lock.publish(reading);
+        }
+        s->done = true;
+        vTaskDelete(nullptr);
+    }, "SeqLockWriter", 2048, &shared, 1, nullptr);
+
+    uint32_t lastSequence = 0;
+    uint32_t lastVersion = 0;
+    uint32_t torn = 0;
+    bool finished = false;
+    for (int i = 0; !finished && i < 10000000; i++) {
+        finished = shared.done;     // Read once more after the writer finished
+        Reading reading;
+        uint32_t version = 0;
+        if (!shared.lock.read(reading, &version)) {
+            continue;
+        }
+        bool consistent = reading.check == ~reading.sequence;
+        for (uint32_t word : reading.payload) {
+            consistent = consistent && word == reading.sequence;
+        }
+        torn += consistent ? 0 : 1;
+        TEST_ASSERT_TRUE(reading.sequence >= lastSequence);
+        TEST_ASSERT_TRUE(version >= lastVersion);
+        TEST_ASSERT_EQUAL(reading.sequence, version);
+        lastSequence = reading.sequence;
+        lastVersion = version;
+    }
+    TEST_ASSERT_TRUE(finished);
+    TEST_ASSERT_EQUAL(0, torn);
+    TEST_ASSERT_EQUAL(publishes, lastSequence);
+    TEST_ASSERT_EQUAL(publishes, shared.lock.version());
+}
+
+// Load runs: consumers driven by MockDeviceInstance profiles
+
+void test_poller_load_with_mock_profiles() {
+    // Two mocks share one bus; every mock event is routed through the dispatcher
+    SemaphoreHandle_t bus = xSemaphoreCreateMutex();
+    DeviceEventDispatcher dispatcher;
+    IDeviceInstance::EventCallbackTable table;
+    std::atomic<uint32_t> notified(0);
+    std::atomic<uint32_t> delivered(0);
+    std::atomic<uint32_t>* deliveredCount = &delivered;
+    table.add([deliveredCount](const IDeviceInstance::EventNotification& notification) {
+        (void)notification;
+        (*deliveredCount)++;
+    });
+
+    const size_t numMocks = 4;
+    MockDeviceInstance mocks[numMocks];
+    DevicePoller poller;
+    for (size_t i = 0; i < numMocks; i++) {
+        MockDeviceInstance& mock = mocks[i];
+        mock.setSeed(static_cast<uint32_t>(i + 1));
+        mock.setDataLatency(MockDeviceInstance::LatencyProfile(1000, 2000, 20, 10000));
+        mock.setErrorRate(IDeviceInstance::DeviceError::COMMUNICATION_ERROR, 50);
+        mock.setErrorRate(IDeviceInstance::DeviceError::TIMEOUT, 20);
+        if (i < 2) {
+            mock.shareInterfaceMutex(bus);
+        }
+        mock.registerCallback([&dispatcher, &table, &notified](const IDeviceInstance::EventNotification& n) {
+            notified++;
+            dispatcher.post(table, n);
+        });
+        mock.initialize();
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS,
+                          poller.add(&mock, 2, pdMS_TO_TICKS(30), MockDeviceInstance::DATA_READY_BIT,
+                                     MockDeviceInstance::ERROR_BIT));
+    }
+
+    const TickType_t end = xTaskGetTickCount() + pdMS_TO_TICKS(500);
+    while (static_cast<int32_t>(xTaskGetTickCount() - end) < 0) {
+        poller.waitForWork(poller.poll());
+        dispatcher.drain();
+    }
+    vTaskDelay(pdMS_TO_TICKS(20));      // Let the last transactions finish
+    dispatcher.drain();
+
+    uint64_t sharedBusWaitUs = 0;
+    for (size_t i = 0; i < numMocks; i++) {
+        const DevicePoller::DeviceCounters counters = poller.getCounters(i);
+        const MockDeviceInstance::Stats stats = mocks[i].getStats();
+        TEST_ASSERT_TRUE(counters.samples > 10);
+        TEST_ASSERT_EQUAL(0, stats.joined);
+        // At most the last request is still unaccounted for by the poller
+        TEST_ASSERT_INT_WITHIN(1, stats.completed, counters.samples);
+        TEST_ASSERT_INT_WITHIN(1, stats.failed, counters.errors);
+        TEST_ASSERT_INT_WITHIN(1, stats.lost, counters.timeouts);
+        TEST_ASSERT_TRUE(stats.requests >= counters.samples + counters.errors + counters.timeouts);
+        if (i < 2) {
+            sharedBusWaitUs += stats.busWaitUs;
+        }
+    }
+    TEST_ASSERT_TRUE(sharedBusWaitUs > 0);
+
+    // Devices on the shared bus take turns
+    const uint32_t first = poller.getCounters(0).samples;
+    const uint32_t second = poller.getCounters(1).samples;
+    TEST_ASSERT_TRUE(4 * first >= 3 * second && 4 * second >= 3 * first);
+
+    // Every notification was delivered once or counted as dropped
+    TEST_ASSERT_TRUE(delivered.load() > 0);
+    TEST_ASSERT_EQUAL(notified.load(), delivered.load() + dispatcher.droppedCount());
+    TEST_ASSERT_EQUAL(delivered.load(), dispatcher.deliveredCount());
+
+    for (auto& mock : mocks) {
+        mock.shareInterfaceMutex(nullptr);
+    }
+    vSemaphoreDelete(bus);
+}
+
+struct SchedulerLoad {
+    DeviceBusScheduler* scheduler;
+    MockDeviceInstance* mocks;
+    size_t numMocks;
+    int jobsPerTask;
+    std::atomic<int> submitted{0};
+    std::atomic<int> expectedExpired{0};
+    std::atomic<int> successes{0};
+    std::atomic<int> timeouts{0};
+    std::atomic<int> failures{0};
+    std::atomic<int> running{0};
+};
+
+static void countLoadJob(void* context, IDeviceInstance* device, IDeviceInstance::DeviceError result) {
+    (void)device;
+    auto* load = static_cast<SchedulerLoad*>(context);
+    if (result == IDeviceInstance::DeviceError::SUCCESS) {
+        load->successes++;
+    } else if (result == IDeviceInstance::DeviceError::TIMEOUT) {
+        load->timeouts++;
+    } else {
+        load->failures++;
+    }
+}
+
+static void submitLoadJobs(void* param) {
+    auto* load = static_cast<SchedulerLoad*>(param);
+    for (int j = 0; j < load->jobsPerTask; j++) {
+        DeviceBusScheduler::Job job;
+        job.device = &load->mocks[j % load->numMocks];
+        job.priority = static_cast<uint8_t>(j % 3);
+        job.responseTimeout = pdMS_TO_TICKS(50);
+        job.onComplete = &countLoadJob;
+        job.context = load;
+        const bool late = j % 8 == 7;
+        if (late) {
+            // Cannot finish before its deadline: must expire without touching the bus
+            job.deadline = xTaskGetTickCount() + 2;
+            job.expectedDuration = pdMS_TO_TICKS(100);
+        }
+        while (load->scheduler->submit(job) == IDeviceInstance::DeviceError::DEVICE_BUSY) {
+            vTaskDelay(1);
+        }
+        load->submitted++;
+        if (late) {
+            load->expectedExpired++;
+        }
+    }
+    load->running--;
+    vTaskDelete(nullptr);
+}
+
+void test_scheduler_load_shared_bus() {
+    SemaphoreHandle_t bus = xSemaphoreCreateMutex();
+    const size_t numMocks = 3;
+    MockDeviceInstance mocks[numMocks];
+    DeviceBusScheduler scheduler(bus, 200);
+    for (size_t i = 0; i < numMocks; i++) {
+        mocks[i].setSeed(static_cast<uint32_t>(10 + i));
+        mocks[i].setDataLatency(MockDeviceInstance::LatencyProfile(500, 1500, 10, 5000));
+        mocks[i].setErrorRate(IDeviceInstance::DeviceError::COMMUNICATION_ERROR, 30);
+        mocks[i].shareInterfaceMutex(bus);
+        mocks[i].initialize();
+        TEST_ASSERT_EQUAL(IDeviceInstance::DeviceError::SUCCESS, scheduler.attach(&mocks[i]));
+    }
+
+    SchedulerLoad load;
+    load.scheduler = &scheduler;
+    load.mocks = mocks;
+    load.numMocks = numMocks;
+    load.jobsPerTask = 40;
+    const int numTasks = 2;
+    load.running = numTasks + 1;
+    for (int i = 0; i < numTasks; i++) {
+        xTaskCreate(&submitLoadJobs, "LoadSubmit", 2048, &load, 1, nullptr);
+    }
+    // Code outside the scheduler takes the bus between driver transactions
+    xTaskCreate([](void* param) {
+        auto* l = static_cast<SchedulerLoad*>(param);
+        for (int i = 0; i < 20; i++) {
+            xSemaphoreTake(l->scheduler->getBusMutex(), portMAX_DELAY);
+            esp_rom_delay_us(200);
+            xSemaphoreGive(l->scheduler->getBusMutex());
+            vTaskDelay(pdMS_TO_TICKS(2));
+        }
+        l->running--;
+        vTaskDelete(nullptr);
+    }, "LoadOutside", 2048, &load, 1, nullptr);
+
+    const int total = numTasks * load.jobsPerTask;
+    const TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(5000);
+    while ((load.running.load() > 0 || load.successes + load.timeouts + load.failures < total) &&
+           static_cast<int32_t>(xTaskGetTickCount() - deadline) < 0) {
+        if (scheduler.runPending() == 0) {
+            vTaskDelay(1);
+        }
+    }
+    TEST_ASSERT_EQUAL(0, load.running.load());
+    TEST_ASSERT_EQUAL(total, load.submitted.load());
+    TEST_ASSERT_EQUAL(total, load.successes + load.timeouts + load.failures);
+    TEST_ASSERT_EQUAL(load.expectedExpired.load(), load.timeouts.load());
+    TEST_ASSERT_EQUAL(load.expectedExpired.load(), scheduler.expiredCount());
+    TEST_ASSERT_EQUAL(total - load.expectedExpired.load(), scheduler.completedCount());
+
+    uint32_t completed = 0;
+    uint32_t failed = 0;
+    for (auto& mock : mocks) {
+        const MockDeviceInstance::Stats stats = mock.getStats();
+        completed += stats.completed;
+        failed += stats.failed;
+        TEST_ASSERT_EQUAL(0, stats.joined);
+        TEST_ASSERT_TRUE(scheduler.estimatedDurationUs(&mock) >= 500);
+    }
+    TEST_ASSERT_EQUAL(load.successes.load(), completed);
+    TEST_ASSERT_EQUAL(load.failures.load(), failed);
+
+    for (auto& mock : mocks) {
+        mock.shareInterfaceMutex(nullptr);
+    }
+    vSemaphoreDelete(bus);
+}
+
 // Test runner
 void runIDeviceInstanceTests() {
     UNITY_BEGIN();
@@ -386,10 +1758,64 @@ void runIDeviceInstanceTests() {
     
     // Concurrency tests
     RUN_TEST(test_concurrent_access);
+    RUN_TEST(test_concurrent_requests_join);
+    
+    // Load profile tests
+    RUN_TEST(test_latency_jitter_bounds);
+    RUN_TEST(test_error_rate_distribution);
+    RUN_TEST(test_shared_bus_contention);
+    RUN_TEST(test_scripted_stream);
+    RUN_TEST(test_poller_load_with_mock_profiles);
+    RUN_TEST(test_scheduler_load_shared_bus);
     
     // Utility tests
     RUN_TEST(test_is_valid_data_type);
     RUN_TEST(test_to_underlying_type);
+    RUN_TEST(test_static_vector_inline_storage);
+    
+    // Deadband tests
+    RUN_TEST(test_deadband_suppresses_small_changes);
+    RUN_TEST(test_deadband_max_silence);
+    
+    // Snapshot tests
+    RUN_TEST(test_snapshot_default_copies_published_slots);
+    RUN_TEST(test_snapshot_bounded_mutex_wait);
+    
+    // getDataFresh() tests
+    RUN_TEST(test_get_data_fresh_joins_flight_in_progress);
+    RUN_TEST(test_get_data_fresh_without_coalescer);
+    
+    // Capability descriptor tests
+    RUN_TEST(test_capabilities_descriptor);
+    
+    // Registry tests
+    RUN_TEST(test_registry_parallel_bus_init);
+    RUN_TEST(test_registry_deadline_and_rejection);
+    RUN_TEST(test_registry_destroyed_while_initializing);
+    
+    // Telemetry codec tests
+    RUN_TEST(test_telemetry_codec_round_trip);
+    RUN_TEST(test_telemetry_codec_sequence_gap);
+    RUN_TEST(test_telemetry_codec_divider_change);
+    
+    // State blob tests
+    RUN_TEST(test_state_blob_rejects_corruption);
+    
+    // History tests
+    RUN_TEST(test_history_summarize_edges);
+    RUN_TEST(test_history_summarize_large_sums);
+    
+    // Coalescer tests
+    RUN_TEST(test_coalescer_join_and_late_completion);
+    RUN_TEST(test_coalescer_abandoned_flight);
+    
+    // Bus scheduler tests
+    RUN_TEST(test_scheduler_order_and_deadlines);
+    RUN_TEST(test_scheduler_leaves_interface_mutex_to_drivers);
+    RUN_TEST(test_scheduler_passes_request_options);
+    
+    // Seqlock tests
+    RUN_TEST(test_seqlock_concurrent_writer);
     
     UNITY_END();
 }